@@ -104,7 +104,7 @@ RCLConsensus::Adaptor::share(RCLCxPeerPos const& peerPos)
     prop.set_nodepubkey(pk.data(), pk.size());
     auto const sig = peerPos.signature();
     prop.set_signature(sig.data(), sig.size());
-    app_.overlay().relay(prop, peerPos.suppressionID());
+    app_.overlay().relay(prop, peerPos.suppressionID(), peerPos.publicKey());
 }
 void
 RCLConsensus::Adaptor::share(RCLCxTx const& tx)
@@ -358,8 +358,7 @@ Ledger::read (Keylet const& k) const
     if (! item)
         return nullptr;
     auto sle = std::make_shared<SLE>(
-        SerialIter{item->data(),
-            item->size()}, item->key());
+        SerialIter{item->slice(), item}, item->key());
     if (! k.check(*sle))
         return nullptr;
     return std::move(sle);
@@ -525,7 +524,7 @@ Ledger::peek (Keylet const& k) const
     if (! value)
         return nullptr;
     auto sle = std::make_shared<SLE>(
-        SerialIter{value->data(), value->size()}, value->key());
+        SerialIter{value->slice(), value}, value->key());
     if (! k.check(*sle))
         return nullptr;
     return sle;
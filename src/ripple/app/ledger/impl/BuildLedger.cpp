@@ -6,7 +6,10 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/TaskPool.h>
 #include <ripple/protocol/Feature.h>
+#include <set>
+#include <vector>
 namespace ripple {
 
 template <class ApplyTxs>
@@ -44,25 +47,301 @@ buildLedgerImpl(
     return built;
 }
 
-std::size_t
-applyTransactions(
+namespace detail {
+class ReadSetView
+    : public ReadView
+{
+    ReadView const& base_;
+    mutable std::vector<uint256> keys_;
+    mutable std::vector<std::pair<uint256,
+        boost::optional<uint256>>> ranges_;
+    mutable bool iterated_ = false;
+public:
+    explicit
+    ReadSetView (ReadView const& base)
+        : base_ (base)
+    {
+    }
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+    bool
+    exists (Keylet const& k) const override
+    {
+        keys_.push_back(k.key);
+        return base_.exists(k);
+    }
+    boost::optional<key_type>
+    succ (key_type const& key, boost::optional<
+        key_type> const& last = boost::none) const override
+    {
+        auto const result = base_.succ(key, last);
+        ranges_.emplace_back(key, result ? result : last);
+        return result;
+    }
+    std::shared_ptr<SLE const>
+    read (Keylet const& k) const override
+    {
+        keys_.push_back(k.key);
+        return base_.read(k);
+    }
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        iterated_ = true;
+        return base_.slesBegin();
+    }
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        iterated_ = true;
+        return base_.slesEnd();
+    }
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override
+    {
+        iterated_ = true;
+        return base_.slesUpperBound(key);
+    }
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        iterated_ = true;
+        return base_.txsBegin();
+    }
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        iterated_ = true;
+        return base_.txsEnd();
+    }
+    bool
+    txExists (key_type const& key) const override
+    {
+        keys_.push_back(key);
+        return base_.txExists(key);
+    }
+    tx_type
+    txRead (key_type const& key) const override
+    {
+        keys_.push_back(key);
+        return base_.txRead(key);
+    }
+    bool
+    conflicts (std::set<uint256> const& written) const
+    {
+        if (iterated_)
+            return true;
+        for (auto const& key : keys_)
+        {
+            if (written.count(key))
+                return true;
+        }
+        for (auto const& range : ranges_)
+        {
+            auto const iter = written.upper_bound(range.first);
+            if (iter != written.end() &&
+                    (! range.second || *iter <= *range.second))
+                return true;
+        }
+        return false;
+    }
+};
+class WriteSet
+    : public TxsRawView
+{
+    std::vector<uint256>& keys_;
+public:
+    explicit
+    WriteSet (std::vector<uint256>& keys)
+        : keys_ (keys)
+    {
+    }
+    void
+    rawErase (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back(sle->key());
+    }
+    void
+    rawInsert (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back(sle->key());
+    }
+    void
+    rawReplace (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back(sle->key());
+    }
+    void
+    rawDestroyXRP (XRPAmount const&) override
+    {
+    }
+    void
+    rawTxInsert (ReadView::key_type const& key,
+        std::shared_ptr<Serializer const> const&,
+            std::shared_ptr<Serializer const> const&) override
+    {
+        keys_.push_back(key);
+    }
+};
+class CommitView
+    : public TxsRawView
+{
+    OpenView& to_;
+public:
+    explicit
+    CommitView (OpenView& to)
+        : to_ (to)
+    {
+    }
+    void
+    rawErase (std::shared_ptr<SLE> const& sle) override
+    {
+        to_.rawErase(sle);
+    }
+    void
+    rawInsert (std::shared_ptr<SLE> const& sle) override
+    {
+        to_.rawInsert(sle);
+    }
+    void
+    rawReplace (std::shared_ptr<SLE> const& sle) override
+    {
+        to_.rawReplace(sle);
+    }
+    void
+    rawDestroyXRP (XRPAmount const& fee) override
+    {
+        to_.rawDestroyXRP(fee);
+    }
+    void
+    rawTxInsert (ReadView::key_type const& key,
+        std::shared_ptr<Serializer const> const& txn,
+            std::shared_ptr<Serializer const> const& metaData) override
+    {
+        if (! metaData)
+            return to_.rawTxInsert(key, txn, metaData);
+        SerialIter sit (metaData->slice());
+        STObject meta (sit, sfTransactionMetaData);
+        auto const index = static_cast<std::uint32_t>(to_.txCount());
+        if (meta.getFieldU32(sfTransactionIndex) == index)
+            return to_.rawTxInsert(key, txn, metaData);
+        meta.setFieldU32(sfTransactionIndex, index);
+        auto s = std::make_shared<Serializer>();
+        meta.add(*s);
+        to_.rawTxInsert(key, txn, s);
+    }
+};
+}
+static
+int
+applySerial(
     Application& app,
     std::shared_ptr<Ledger const> const& built,
     CanonicalTXSet& txns,
     std::set<TxID>& failed,
     OpenView& view,
+    int pass,
+    bool certainRetry,
     beast::Journal j)
 {
-    bool certainRetry = true;
-    std::size_t count = 0;
-    for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
+    int changes = 0;
+    auto it = txns.begin();
+    while (it != txns.end())
     {
-        JLOG(j.debug())
-            << (certainRetry ? "Pass: " : "Final pass: ") << pass
-            << " begins (" << txns.size() << " transactions)";
-        int changes = 0;
-        auto it = txns.begin();
-        while (it != txns.end())
+        auto const txid = it->first.getTXID();
+        try
+        {
+            if (pass == 0 && built->txExists(txid))
+            {
+                it = txns.erase(it);
+                continue;
+            }
+            switch (applyTransaction(
+                app, view, *it->second, certainRetry, tapNONE, j))
+            {
+                case ApplyResult::Success:
+                    it = txns.erase(it);
+                    ++changes;
+                    break;
+                case ApplyResult::Fail:
+                    failed.insert(txid);
+                    it = txns.erase(it);
+                    break;
+                case ApplyResult::Retry:
+                    ++it;
+            }
+        }
+        catch (std::exception const&)
+        {
+            JLOG(j.warn()) << "Transaction " << txid << " throws";
+            failed.insert(txid);
+            it = txns.erase(it);
+        }
+    }
+    return changes;
+}
+static
+int
+applySpeculative(
+    Application& app,
+    std::shared_ptr<Ledger const> const& built,
+    CanonicalTXSet& txns,
+    std::set<TxID>& failed,
+    OpenView& view,
+    int pass,
+    bool certainRetry,
+    std::size_t threads,
+    beast::Journal j)
+{
+    struct Speculation
+    {
+        CanonicalTXSet::const_iterator it;
+        std::unique_ptr<detail::ReadSetView> reads;
+        std::unique_ptr<OpenView> view;
+        std::vector<uint256> writes;
+        ApplyResult result = ApplyResult::Retry;
+        bool valid = false;
+    };
+    auto execute = [&](Speculation& s, ReadView const* base)
+    {
+        s.writes.clear();
+        s.view = std::make_unique<OpenView>(base);
+        s.result = applyTransaction(
+            app, *s.view, *s.it->second, certainRetry, tapNONE, j);
+        detail::WriteSet writes (s.writes);
+        s.view->apply(writes);
+    };
+    auto& pool = app.getApplyPool();
+    std::size_t const window = threads * 32;
+    std::vector<Speculation> batch;
+    batch.reserve(window);
+    std::set<uint256> written;
+    int changes = 0;
+    std::size_t speculated = 0;
+    std::size_t reexecuted = 0;
+    auto it = txns.begin();
+    while (it != txns.end())
+    {
+        batch.clear();
+        while (it != txns.end() && batch.size() < window)
         {
             auto const txid = it->first.getTXID();
             try
@@ -72,28 +351,106 @@ applyTransactions(
                     it = txns.erase(it);
                     continue;
                 }
-                switch (applyTransaction(
-                    app, view, *it->second, certainRetry, tapNONE, j))
+            }
+            catch (std::exception const&)
+            {
+                JLOG(j.warn()) << "Transaction " << txid << " throws";
+                failed.insert(txid);
+                it = txns.erase(it);
+                continue;
+            }
+            batch.emplace_back();
+            batch.back().it = it++;
+        }
+        pool.forEach(batch.size(), [&](std::size_t i)
+        {
+            auto& s = batch[i];
+            try
+            {
+                s.reads = std::make_unique<detail::ReadSetView>(view);
+                execute(s, s.reads.get());
+                s.valid = true;
+            }
+            catch (std::exception const&)
+            {
+                s.valid = false;
+            }
+        }, threads);
+        written.clear();
+        for (auto& s : batch)
+        {
+            auto const txid = s.it->first.getTXID();
+            try
+            {
+                auto conflict = ! s.valid || s.reads->conflicts(written);
+                for (auto iter = s.writes.begin();
+                    ! conflict && iter != s.writes.end(); ++iter)
+                {
+                    conflict = written.count(*iter) != 0;
+                }
+                if (conflict)
+                {
+                    ++reexecuted;
+                    execute(s, &view);
+                }
+                else
+                {
+                    ++speculated;
+                }
+                detail::CommitView commit (view);
+                s.view->apply(commit);
+                written.insert(s.writes.begin(), s.writes.end());
+                switch (s.result)
                 {
                     case ApplyResult::Success:
-                        it = txns.erase(it);
+                        txns.erase(s.it);
                         ++changes;
                         break;
                     case ApplyResult::Fail:
                         failed.insert(txid);
-                        it = txns.erase(it);
+                        txns.erase(s.it);
                         break;
                     case ApplyResult::Retry:
-                        ++it;
+                        break;
                 }
             }
             catch (std::exception const&)
             {
                 JLOG(j.warn()) << "Transaction " << txid << " throws";
                 failed.insert(txid);
-                it = txns.erase(it);
+                txns.erase(s.it);
             }
+            s.view.reset();
+            s.reads.reset();
         }
+    }
+    JLOG(j.debug())
+        << "Speculation: " << speculated << " committed, "
+        << reexecuted << " re-executed";
+    return changes;
+}
+std::size_t
+applyTransactions(
+    Application& app,
+    std::shared_ptr<Ledger const> const& built,
+    CanonicalTXSet& txns,
+    std::set<TxID>& failed,
+    OpenView& view,
+    beast::Journal j)
+{
+    auto const threads = app.config().LEDGER_APPLY_THREADS;
+    bool certainRetry = true;
+    std::size_t count = 0;
+    for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
+    {
+        JLOG(j.debug())
+            << (certainRetry ? "Pass: " : "Final pass: ") << pass
+            << " begins (" << txns.size() << " transactions)";
+        int const changes = (threads > 1) ?
+            applySpeculative(app, built, txns, failed, view, pass,
+                certainRetry, threads, j) :
+            applySerial(app, built, txns, failed, view, pass,
+                certainRetry, j);
         JLOG(j.debug())
             << (certainRetry ? "Pass: " : "Final pass: ") << pass
             << " completed (" << changes << " changes)";
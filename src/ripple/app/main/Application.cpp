@@ -21,6 +21,7 @@
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/SHAMapStore.h>
+#include <ripple/app/misc/SigVerifier.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/misc/ValidatorSite.h>
 #include <ripple/app/misc/ValidatorKeys.h>
@@ -62,6 +63,7 @@ private:
     NodeStore::Database& db_;
     bool const shardBacked_;
     beast::Journal j_;
+    TaskPool flushPool_;
     LedgerIndex maxSeq = 0;
     std::mutex maxSeqLock;
     void acquire (
@@ -86,7 +88,8 @@ public:
             CollectorManager& collectorManager)
         : app_ (app)
         , treecache_ ("TreeNodeCache", 65536, std::chrono::minutes {1},
-            stopwatch(), app.journal("TaggedCache"))
+            stopwatch(), app.journal("TaggedCache"),
+                beast::insight::NullCollector::New (), treeNodeCachePartitions)
         , fullbelow_ ("full_below", stopwatch(),
             collectorManager.collector(),
                 fullBelowTargetSize, fullBelowExpiration)
@@ -94,6 +97,7 @@ public:
         , shardBacked_ (
             dynamic_cast<NodeStore::DatabaseShard*>(&db) != nullptr)
         , j_ (app.journal("SHAMap"))
+        , flushPool_ (app.config().LEDGER_FLUSH_THREADS - 1, "SHAMapFlush")
     {
     }
     beast::Journal const&
@@ -136,6 +140,16 @@ public:
     {
         return shardBacked_;
     }
+    TaskPool&
+    flushPool() override
+    {
+        return flushPool_;
+    }
+    std::size_t
+    prefetchWindow() const override
+    {
+        return app_.config().LEDGER_PREFETCH_WINDOW;
+    }
     void
     missing_node (std::uint32_t seq) override
     {
@@ -278,6 +292,8 @@ public:
     std::unique_ptr <AmendmentTable> m_amendmentTable;
     std::unique_ptr <LoadFeeTrack> mFeeTrack;
     std::unique_ptr <HashRouter> mHashRouter;
+    std::unique_ptr <SigVerifier> sigVerifier_;
+    std::unique_ptr <TaskPool> applyPool_;
     RCLValidations mValidations;
     std::unique_ptr <LoadManager> m_loadManager;
     std::unique_ptr <TxQ> txQ_;
@@ -383,6 +399,11 @@ public:
         , mHashRouter (std::make_unique<HashRouter>(
             stopwatch(), HashRouter::getDefaultHoldTime (),
             HashRouter::getDefaultRecoverLimit ()))
+        , sigVerifier_ (std::make_unique<SigVerifier>(*m_jobQueue,
+            *mHashRouter, *config_, config_->SIG_VERIFY_THREADS,
+            logs_->journal("SigVerifier")))
+        , applyPool_ (std::make_unique<TaskPool>(
+            config_->LEDGER_APPLY_THREADS - 1, "LedgerApply"))
         , mValidations (ValidationParms(),stopwatch(), *this, logs_->journal("Validations"))
         , m_loadManager (make_LoadManager (*this, *this, logs_->journal("LoadManager")))
         , txQ_(make_TxQ(setup_TxQ(*config_), logs_->journal("TxQ")))
@@ -541,6 +562,14 @@ public:
     {
         return *mHashRouter;
     }
+    SigVerifier& getSigVerifier () override
+    {
+        return *sigVerifier_;
+    }
+    TaskPool& getApplyPool () override
+    {
+        return *applyPool_;
+    }
     RCLValidations& getValidations () override
     {
         return mValidations;
@@ -46,6 +46,8 @@ class ValidatorSite;
 class Cluster;
 class DatabaseCon;
 class SHAMapStore;
+class SigVerifier;
+class TaskPool;
 using NodeCache     = TaggedCache <SHAMapHash, Blob>;
 template <class Adaptor>
 class Validations;
@@ -80,6 +82,8 @@ public:
     virtual CachedSLEs&                 cachedSLEs() = 0;
     virtual AmendmentTable&             getAmendmentTable() = 0;
     virtual HashRouter&                 getHashRouter () = 0;
+    virtual SigVerifier&                getSigVerifier () = 0;
+    virtual TaskPool&                   getApplyPool () = 0;
     virtual LoadFeeTrack&               getFeeTrack () = 0;
     virtual LoadManager&                getLoadManager () = 0;
     virtual Overlay&                    overlay () = 0;
@@ -3,5 +3,6 @@
 namespace ripple {
 constexpr std::size_t fullBelowTargetSize = 524288;
 constexpr std::chrono::seconds fullBelowExpiration = std::chrono::minutes{10};
+constexpr std::size_t treeNodeCachePartitions = 16;
 }
 #endif
@@ -15,12 +15,15 @@
 #include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
+#include <ripple/app/misc/SHAMapStore.h>
+#include <ripple/app/misc/SigVerifier.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/misc/ValidatorKeys.h>
 #include <ripple/app/misc/ValidatorList.h>
 #include <ripple/app/misc/impl/AccountTxPaging.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/Arena.h>
 #include <ripple/basics/base64.h>
 #include <ripple/basics/mulDiv.h>
 #include <ripple/basics/PerfLog.h>
@@ -603,34 +606,43 @@ void NetworkOPsImp::submitTransaction (std::shared_ptr<STTx const> const& iTrans
         JLOG(m_journal.warn()) << "Submitted transaction cached bad";
         return;
     }
-    try
+    auto submit = [this, trans, txid] ()
     {
-        auto const validity = checkValidity(
-            app_.getHashRouter(), *trans,
-                m_ledgerMaster.getValidatedRules(),
-                    app_.config());
-        if (validity.first != Validity::Valid)
+        try
         {
-            JLOG(m_journal.warn()) <<
-                "Submitted transaction invalid: " <<
-                validity.second;
+            auto const validity = checkValidity(
+                app_.getHashRouter(), *trans,
+                    m_ledgerMaster.getValidatedRules(),
+                        app_.config());
+            if (validity.first != Validity::Valid)
+            {
+                JLOG(m_journal.warn()) <<
+                    "Submitted transaction invalid: " <<
+                    validity.second;
+                return;
+            }
+        }
+        catch (std::exception const&)
+        {
+            JLOG(m_journal.warn()) << "Exception checking transaction" << txid;
             return;
         }
-    }
-    catch (std::exception const&)
+        std::string reason;
+        auto tx = std::make_shared<Transaction> (
+            trans, reason, app_);
+        m_job_queue.addJob (
+            jtTRANSACTION, "submitTxn",
+            [this, tx] (Job&) {
+                auto t = tx;
+                processTransaction(t, false, false, FailHard::no);
+            });
+    };
+    if (! app_.getSigVerifier().verify(trans,
+        m_ledgerMaster.getValidatedRules(),
+            [submit] (Validity) { submit(); }))
     {
-        JLOG(m_journal.warn()) << "Exception checking transaction" << txid;
-        return;
+        submit();
     }
-    std::string reason;
-    auto tx = std::make_shared<Transaction> (
-        trans, reason, app_);
-    m_job_queue.addJob (
-        jtTRANSACTION, "submitTxn",
-        [this, tx] (Job&) {
-            auto t = tx;
-            processTransaction(t, false, false, FailHard::no);
-        });
 }
 void NetworkOPsImp::processTransaction (std::shared_ptr<Transaction>& transaction,
         bool bUnlimited, bool bLocal, FailHard failType)
@@ -1079,7 +1091,8 @@ void NetworkOPsImp::processTrustedProposal (
     if (mConsensus.peerProposal(
             app_.timeKeeper().closeTime(), peerPos))
     {
-        app_.overlay().relay(*set, peerPos.suppressionID());
+        app_.overlay().relay(*set, peerPos.suppressionID(),
+            peerPos.publicKey());
     }
     else
         JLOG(m_journal.info()) << "Not relaying trusted proposal";
@@ -1633,6 +1646,9 @@ Json::Value NetworkOPsImp::getServerInfo (bool human, bool admin, bool counters)
         {
             info[jss::pubkey_validator] = "none";
         }
+        auto rotation = app_.getSHAMapStore().getRotationJson();
+        if (! rotation.isNull())
+            info[jss::online_delete] = std::move(rotation);
     }
     if (counters)
     {
@@ -1800,6 +1816,7 @@ Json::Value NetworkOPsImp::getServerInfo (bool human, bool admin, bool counters)
         app_.overlay().getPeerDisconnect());
     info[jss::peer_disconnects_resources] = std::to_string(
         app_.overlay().getPeerDisconnectCharges());
+    info[jss::ledger_server] = app_.overlay().getLedgerServerJson();
     return info;
 }
 void NetworkOPsImp::clearLedgerFetch ()
@@ -1942,10 +1959,18 @@ Json::Value NetworkOPsImp::transJson(
     }
     return jvObj;
 }
+static
+Arena&
+publishArena ()
+{
+    thread_local Arena arena;
+    return arena;
+}
 void NetworkOPsImp::pubValidatedTransaction (
     std::shared_ptr<ReadView const> const& alAccepted,
     const AcceptedLedgerTx& alTx)
 {
+    Json::Value::Scope scope (publishArena ());
     std::shared_ptr<STTx const> stTxn = alTx.getTxn();
     Json::Value jvObj = transJson (
         *stTxn, alTx.getResult (), true, alAccepted);
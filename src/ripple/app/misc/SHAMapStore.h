@@ -1,6 +1,7 @@
 #ifndef RIPPLE_APP_MISC_SHAMAPSTORE_H_INCLUDED
 #define RIPPLE_APP_MISC_SHAMAPSTORE_H_INCLUDED
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/json/json_value.h>
 #include <ripple/nodestore/Manager.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/core/Stoppable.h>
@@ -22,6 +23,8 @@ public:
         std::uint32_t deleteBatch = 100;
         std::uint32_t backOff = 100;
         std::int32_t ageThreshold = 60;
+        std::uint32_t copyThreads = 4;
+        std::uint32_t copyRate = 0;
         Section shardDatabase;
     };
     SHAMapStore (Stoppable& parent) : Stoppable ("SHAMapStore", parent) {}
@@ -39,6 +42,7 @@ public:
     virtual LedgerIndex getLastRotated() = 0;
     virtual LedgerIndex getCanDelete() = 0;
     virtual int fdlimit() const = 0;
+    virtual Json::Value getRotationJson() = 0;
 };
 SHAMapStore::Setup
 setup_SHAMapStore(Config const& c);
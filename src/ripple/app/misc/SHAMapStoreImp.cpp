@@ -6,6 +6,8 @@
 #include <ripple/core/ConfigSections.h>
 #include <ripple/nodestore/impl/DatabaseRotatingImp.h>
 #include <ripple/nodestore/impl/DatabaseShardImp.h>
+#include <ripple/protocol/jss.h>
+#include <exception>
 namespace ripple {
 void SHAMapStoreImp::SavedStateDB::init (BasicConfig const& config,
                                          std::string const& dbName)
@@ -269,19 +271,137 @@ SHAMapStoreImp::fdlimit () const
 {
     return fdlimit_;
 }
+Json::Value
+SHAMapStoreImp::getRotationJson()
+{
+    if (! setup_.deleteInterval)
+        return Json::nullValue;
+    static char const* const phases[] =
+    {
+        "idle",
+        "clearing",
+        "copying",
+        "freshening",
+        "rotating"
+    };
+    Progress progress;
+    {
+        std::lock_guard<std::mutex> lock (progressMutex_);
+        progress = progress_;
+    }
+    auto const copied = copiedNodes_.load();
+    Json::Value ret (Json::objectValue);
+    ret[jss::state] = phases[progress.phase];
+    ret[jss::last_rotated] = getLastRotated();
+    ret[jss::nodes_copied] = static_cast<Json::UInt> (copied);
+    if (progress.phase != idle)
+        ret[jss::ledger_index] = progress.ledgerSeq;
+    if (progress.phase == copying && copied &&
+        progress.expectedNodes > copied)
+    {
+        using namespace std::chrono;
+        auto const elapsed = duration_cast<milliseconds> (
+            steady_clock::now() - progress.copyStart).count();
+        ret[jss::eta_seconds] = static_cast<Json::UInt> (
+            elapsed * (progress.expectedNodes - copied) / copied / 1000);
+    }
+    return ret;
+}
 bool
-SHAMapStoreImp::copyNode (std::uint64_t& nodeCount,
-        SHAMapAbstractNode const& node)
+SHAMapStoreImp::copyNode (SHAMapAbstractNode const& node)
 {
     dbRotating_->fetch(node.getNodeHash().as_uint256(), node.getSeq());
-    if (! (++nodeCount % checkHealthInterval_))
+    auto const nodeCount = ++copiedNodes_;
+    if (! (nodeCount % checkHealthInterval_))
     {
+        if (setup_.copyRate)
+        {
+            std::chrono::steady_clock::time_point start;
+            {
+                std::lock_guard<std::mutex> lock (progressMutex_);
+                start = progress_.copyStart;
+            }
+            std::this_thread::sleep_until (start + std::chrono::microseconds (
+                nodeCount * 1000000 / setup_.copyRate));
+        }
         if (health())
             return false;
     }
     return true;
 }
 void
+SHAMapStoreImp::copyState (SHAMap const& map, LedgerIndex ledgerSeq)
+{
+    {
+        std::lock_guard<std::mutex> lock (progressMutex_);
+        progress_.phase = copying;
+        progress_.ledgerSeq = ledgerSeq;
+        progress_.expectedNodes = copiedNodes_.exchange (0);
+        progress_.copyStart = std::chrono::steady_clock::now();
+    }
+    auto const threads = std::min<std::uint32_t> (
+        std::max<std::uint32_t> (setup_.copyThreads, 1), 16);
+    if (threads == 1)
+    {
+        map.visitNodes (std::bind (&SHAMapStoreImp::copyNode, this,
+            std::placeholders::_1));
+        return;
+    }
+    dbRotating_->fetch (map.getHash().as_uint256(), ledgerSeq);
+    ++copiedNodes_;
+    std::atomic<int> next {0};
+    std::atomic<bool> stopped {false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto copyBranches = [&]
+    {
+        try
+        {
+            for (int branch = next++; branch < 16 && ! stopped;
+                branch = next++)
+            {
+                if (! map.visitBranch (branch,
+                    [&](SHAMapAbstractNode& node)
+                    {
+                        return ! stopped && copyNode (node);
+                    }))
+                {
+                    stopped = true;
+                }
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock (errorMutex);
+            if (! error)
+                error = std::current_exception();
+            stopped = true;
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve (threads - 1);
+    for (std::uint32_t i = 1; i < threads; ++i)
+    {
+        workers.emplace_back ([&copyBranches]
+        {
+            beast::setCurrentThreadName ("SHAMapStore copy");
+            copyBranches();
+        });
+    }
+    copyBranches();
+    for (auto& worker : workers)
+        worker.join();
+    if (error)
+        std::rethrow_exception (error);
+}
+void
+SHAMapStoreImp::setPhase (Phase phase, LedgerIndex ledgerSeq)
+{
+    std::lock_guard<std::mutex> lock (progressMutex_);
+    progress_.phase = phase;
+    progress_.ledgerSeq = ledgerSeq;
+}
+void
 SHAMapStoreImp::run()
 {
     beast::setCurrentThreadName ("SHAMapStore");
@@ -297,6 +417,7 @@ SHAMapStoreImp::run()
     while (1)
     {
         healthy_ = true;
+        setPhase (idle);
         std::shared_ptr<Ledger const> validatedLedger;
         {
             std::unique_lock <std::mutex> lock (mutex_);
@@ -338,6 +459,7 @@ SHAMapStoreImp::run()
                 default:
                     ;
             }
+            setPhase (clearing, validatedSeq);
             clearPrior (lastRotated);
             switch (health())
             {
@@ -350,13 +472,10 @@ SHAMapStoreImp::run()
                 default:
                     ;
             }
-            std::uint64_t nodeCount = 0;
-            validatedLedger->stateMap().snapShot (
-                    false)->visitNodes (
-                    std::bind (&SHAMapStoreImp::copyNode, this,
-                    std::ref(nodeCount), std::placeholders::_1));
+            copyState (*validatedLedger->stateMap().snapShot (false),
+                validatedSeq);
             JLOG(journal_.debug()) << "copied ledger " << validatedSeq
-                    << " nodecount " << nodeCount;
+                    << " nodecount " << copiedNodes_;
             switch (health())
             {
                 case Health::stopping:
@@ -368,6 +487,7 @@ SHAMapStoreImp::run()
                 default:
                     ;
             }
+            setPhase (freshening, validatedSeq);
             freshenCaches();
             JLOG(journal_.debug()) << validatedSeq << " freshened caches";
             switch (health())
@@ -381,6 +501,7 @@ SHAMapStoreImp::run()
                 default:
                     ;
             }
+            setPhase (rotating, validatedSeq);
             auto newBackend = makeBackendRotating();
             JLOG(journal_.debug()) << validatedSeq << " new backend "
                     << newBackend->getName();
@@ -512,11 +633,12 @@ SHAMapStoreImp::clearSql (DatabaseCon& database,
         "start: " << deleteQuery << " from " << min << " to " << lastRotated;
     while (min < lastRotated)
     {
-        min = std::min(lastRotated, min + setup_.deleteBatch);
+        auto const next = std::min(lastRotated, min + setup_.deleteBatch);
         {
             auto db =  database.checkoutDb ();
-            *db << boost::str (formattedDeleteQuery % min);
+            *db << boost::str (formattedDeleteQuery % min % next);
         }
+        min = next;
         if (health())
             return true;
         if (min < lastRotated)
@@ -552,7 +674,8 @@ SHAMapStoreImp::clearPrior (LedgerIndex lastRotated)
         return;
     clearSql (*ledgerDb_, lastRotated,
         "SELECT MIN(LedgerSeq) FROM Ledgers;",
-        "DELETE FROM Ledgers WHERE LedgerSeq < %u;");
+        "DELETE FROM Ledgers"
+        " WHERE LedgerSeq >= %u AND LedgerSeq < %u;");
     if (health())
         return;
     {
@@ -560,7 +683,8 @@ SHAMapStoreImp::clearPrior (LedgerIndex lastRotated)
         static auto anyValDeleted = false;
         auto const valDeleted = clearSql(*ledgerDb_, lastRotated,
             "SELECT MIN(LedgerSeq) FROM Validations;",
-            "DELETE FROM Validations WHERE LedgerSeq < %u;");
+            "DELETE FROM Validations"
+            " WHERE LedgerSeq >= %u AND LedgerSeq < %u;");
         anyValDeleted |= valDeleted;
         if (health())
             return;
@@ -621,12 +745,14 @@ SHAMapStoreImp::clearPrior (LedgerIndex lastRotated)
         return;
     clearSql (*transactionDb_, lastRotated,
         "SELECT MIN(LedgerSeq) FROM Transactions;",
-        "DELETE FROM Transactions WHERE LedgerSeq < %u;");
+        "DELETE FROM Transactions"
+        " WHERE LedgerSeq >= %u AND LedgerSeq < %u;");
     if (health())
         return;
     clearSql (*transactionDb_, lastRotated,
         "SELECT MIN(LedgerSeq) FROM AccountTransactions;",
-        "DELETE FROM AccountTransactions WHERE LedgerSeq < %u;");
+        "DELETE FROM AccountTransactions"
+        " WHERE LedgerSeq >= %u AND LedgerSeq < %u;");
     if (health())
         return;
 }
@@ -704,6 +830,8 @@ setup_SHAMapStore (Config const& c)
     get_if_exists (setup.nodeDatabase, "delete_batch", setup.deleteBatch);
     get_if_exists (setup.nodeDatabase, "backOff", setup.backOff);
     get_if_exists (setup.nodeDatabase, "age_threshold", setup.ageThreshold);
+    get_if_exists (setup.nodeDatabase, "copy_threads", setup.copyThreads);
+    get_if_exists (setup.nodeDatabase, "copy_rate", setup.copyRate);
     setup.shardDatabase = c.section(ConfigSection::shardDatabase());
     return setup;
 }
@@ -4,6 +4,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/nodestore/DatabaseRotating.h>
+#include <chrono>
 #include <condition_variable>
 #include <thread>
 namespace ripple {
@@ -23,6 +24,21 @@ private:
         stopping,
         unhealthy
     };
+    enum Phase : std::uint8_t
+    {
+        idle = 0,
+        clearing,
+        copying,
+        freshening,
+        rotating
+    };
+    struct Progress
+    {
+        Phase phase = idle;
+        LedgerIndex ledgerSeq = 0;
+        std::uint64_t expectedNodes = 0;
+        std::chrono::steady_clock::time_point copyStart;
+    };
     class SavedStateDB
     {
     public:
@@ -53,7 +69,7 @@ private:
     SavedStateDB state_db_;
     std::thread thread_;
     bool stop_ = false;
-    bool healthy_ = true;
+    std::atomic<bool> healthy_ {true};
     mutable std::condition_variable cond_;
     mutable std::condition_variable rendezvous_;
     mutable std::mutex mutex_;
@@ -68,6 +84,9 @@ private:
     DatabaseCon* transactionDb_ = nullptr;
     DatabaseCon* ledgerDb_ = nullptr;
     int fdlimit_ = 0;
+    mutable std::mutex progressMutex_;
+    Progress progress_;
+    std::atomic<std::uint64_t> copiedNodes_ {0};
 public:
     SHAMapStoreImp (Application& app,
             Setup const& setup,
@@ -119,8 +138,11 @@ public:
     void onLedgerClosed (std::shared_ptr<Ledger const> const& ledger) override;
     void rendezvous() const override;
     int fdlimit() const override;
+    Json::Value getRotationJson() override;
 private:
-    bool copyNode (std::uint64_t& nodeCount, SHAMapAbstractNode const &node);
+    bool copyNode (SHAMapAbstractNode const &node);
+    void copyState (SHAMap const& map, LedgerIndex ledgerSeq);
+    void setPhase (Phase phase, LedgerIndex ledgerSeq = 0);
     void run();
     void dbPaths();
     std::unique_ptr<NodeStore::Backend>
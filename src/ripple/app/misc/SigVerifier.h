@@ -0,0 +1,91 @@
+#ifndef RIPPLE_APP_MISC_SIGVERIFIER_H_INCLUDED
+#define RIPPLE_APP_MISC_SIGVERIFIER_H_INCLUDED
+#include <ripple/app/misc/HashRouter.h>
+#include <ripple/app/tx/apply.h>
+#include <ripple/core/Config.h>
+#include <ripple/core/Stoppable.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/STValidation.h>
+#include <ripple/beast/utility/Journal.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace ripple {
+class SigVerifier
+    : public Stoppable
+{
+public:
+    static std::size_t constexpr batchSize = 64;
+    using Handler = std::function<void(Validity)>;
+    using ValidationHandler = std::function<void(bool)>;
+private:
+    struct Item
+    {
+        std::shared_ptr<STTx const> stx;
+        Rules rules;
+        Handler handler;
+    };
+    struct ValidationItem
+    {
+        std::shared_ptr<STValidation> val;
+        ValidationHandler handler;
+    };
+    HashRouter& router_;
+    Config const& config_;
+    beast::Journal j_;
+    std::size_t const threadCount_;
+    std::mutex mutable mutex_;
+    std::condition_variable cond_;
+    std::deque<Item> queue_;
+    std::deque<ValidationItem> validations_;
+    bool stop_ = false;
+    std::atomic<std::uint64_t> verified_ {0};
+    std::atomic<std::uint64_t> batches_ {0};
+    std::vector<std::thread> threads_;
+public:
+    SigVerifier (Stoppable& parent, HashRouter& router,
+        Config const& config, std::size_t threads, beast::Journal j);
+    ~SigVerifier () override;
+    bool
+    verify (std::shared_ptr<STTx const> const& stx,
+        Rules const& rules, Handler handler);
+    bool
+    verify (std::shared_ptr<STValidation> const& val,
+        ValidationHandler handler);
+    std::size_t
+    size () const;
+    std::size_t
+    getThreadCount () const
+    {
+        return threadCount_;
+    }
+    std::uint64_t
+    getVerifiedCount () const
+    {
+        return verified_;
+    }
+    std::uint64_t
+    getBatchCount () const
+    {
+        return batches_;
+    }
+private:
+    void
+    run ();
+    void
+    verifyBatch (std::vector<Item>& batch);
+    void
+    verifyBatch (std::vector<ValidationItem>& batch);
+    void
+    join ();
+    void
+    onStop () override;
+};
+}
+#endif
@@ -0,0 +1,216 @@
+#include <ripple/app/misc/SigVerifier.h>
+#include <ripple/basics/Log.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <algorithm>
+#include <iterator>
+namespace ripple {
+template <class T>
+static
+void
+take (std::deque<T>& queue, std::vector<T>& batch,
+    std::size_t threads, std::size_t limit)
+{
+    auto const share = (queue.size () + threads - 1) / threads;
+    auto const n = std::min (share, limit);
+    std::move (queue.begin (), queue.begin () + n,
+        std::back_inserter (batch));
+    queue.erase (queue.begin (), queue.begin () + n);
+}
+SigVerifier::SigVerifier (Stoppable& parent, HashRouter& router,
+    Config const& config, std::size_t threads, beast::Journal j)
+    : Stoppable ("SigVerifier", parent)
+    , router_ (router)
+    , config_ (config)
+    , j_ (j)
+    , threadCount_ (threads ? threads :
+        std::max (std::thread::hardware_concurrency (), 1u))
+{
+    threads_.reserve (threadCount_);
+    for (std::size_t i = 0; i < threadCount_; ++i)
+        threads_.emplace_back (&SigVerifier::run, this);
+}
+SigVerifier::~SigVerifier ()
+{
+    join ();
+}
+bool
+SigVerifier::verify (std::shared_ptr<STTx const> const& stx,
+    Rules const& rules, Handler handler)
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (stop_)
+            return false;
+        queue_.push_back (Item {stx, rules, std::move (handler)});
+    }
+    cond_.notify_one ();
+    return true;
+}
+bool
+SigVerifier::verify (std::shared_ptr<STValidation> const& val,
+    ValidationHandler handler)
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (stop_)
+            return false;
+        validations_.push_back (ValidationItem {val, std::move (handler)});
+    }
+    cond_.notify_one ();
+    return true;
+}
+std::size_t
+SigVerifier::size () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return queue_.size ();
+}
+void
+SigVerifier::run ()
+{
+    beast::setCurrentThreadName ("SigVerifier");
+    std::vector<Item> batch;
+    std::vector<ValidationItem> validations;
+    batch.reserve (batchSize);
+    validations.reserve (batchSize);
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (true)
+    {
+        cond_.wait (lock, [this]
+        {
+            return stop_ || ! queue_.empty () || ! validations_.empty ();
+        });
+        if (stop_)
+            return;
+        if (! validations_.empty ())
+            take (validations_, validations, threadCount_, batchSize);
+        else
+            take (queue_, batch, threadCount_, batchSize);
+        if (! queue_.empty () || ! validations_.empty ())
+            cond_.notify_one ();
+        lock.unlock ();
+        if (! validations.empty ())
+            verifyBatch (validations);
+        else
+            verifyBatch (batch);
+        validations.clear ();
+        batch.clear ();
+        lock.lock ();
+    }
+}
+void
+SigVerifier::verifyBatch (std::vector<Item>& batch)
+{
+    std::vector<Validity> results;
+    results.reserve (batch.size ());
+    for (auto const& item : batch)
+    {
+        try
+        {
+            results.push_back (checkValidity (
+                router_, *item.stx, item.rules, config_).first);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.debug()) << "Exception verifying transaction " <<
+                item.stx->getTransactionID () << ": " << e.what ();
+            results.push_back (Validity::SigBad);
+        }
+    }
+    verified_ += batch.size ();
+    ++batches_;
+    for (std::size_t i = 0; i < batch.size (); ++i)
+    {
+        try
+        {
+            batch[i].handler (results[i]);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.warn()) << "Exception handling verified transaction " <<
+                batch[i].stx->getTransactionID () << ": " << e.what ();
+        }
+    }
+}
+void
+SigVerifier::verifyBatch (std::vector<ValidationItem>& batch)
+{
+    auto const n = batch.size ();
+    std::vector<std::size_t> index;
+    std::vector<PublicKey> keys;
+    std::vector<Blob> data;
+    std::vector<Blob> sigs;
+    index.reserve (n);
+    keys.reserve (n);
+    data.reserve (n);
+    sigs.reserve (n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto const& val = *batch[i].val;
+        try
+        {
+            auto pk = val.getSignerPublic ();
+            if (publicKeyType (pk) != KeyType::secp256k1)
+                continue;
+            keys.push_back (std::move (pk));
+            data.push_back (val.getSigningData ());
+            sigs.push_back (val.getSignature ());
+            index.push_back (i);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.debug()) << "Exception verifying validation " <<
+                val.getLedgerHash () << ": " << e.what ();
+        }
+    }
+    std::vector<SignedMessage> items;
+    items.reserve (index.size ());
+    for (std::size_t j = 0; j < index.size (); ++j)
+    {
+        items.push_back (SignedMessage {&keys[j], makeSlice (data[j]),
+            makeSlice (sigs[j]),
+                (batch[index[j]].val->getFlags () & vfFullyCanonicalSig) != 0});
+    }
+    std::unique_ptr<bool[]> ok (new bool[items.size ()]);
+    ripple::verifyBatch (items.data (), ok.get (), items.size ());
+    std::vector<bool> valid (n, false);
+    for (std::size_t j = 0; j < index.size (); ++j)
+        valid[index[j]] = ok[j];
+    verified_ += n;
+    ++batches_;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        try
+        {
+            batch[i].handler (valid[i]);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.warn()) << "Exception handling verified validation: " <<
+                e.what ();
+        }
+    }
+}
+void
+SigVerifier::join ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        stop_ = true;
+        queue_.clear ();
+        validations_.clear ();
+    }
+    cond_.notify_all ();
+    for (auto& thread : threads_)
+    {
+        if (thread.joinable ())
+            thread.join ();
+    }
+}
+void
+SigVerifier::onStop ()
+{
+    join ();
+    stopped ();
+}
+}
@@ -17,6 +17,8 @@
 #include <ripple/app/tx/impl/SetSignerList.h>
 #include <ripple/app/tx/impl/SetTrust.h>
 #include <ripple/app/tx/impl/PayChan.h>
+#include <ripple/basics/Arena.h>
+#include <boost/optional.hpp>
 namespace ripple {
 static
 NotTEC
@@ -280,6 +282,13 @@ calculateConsequences(PreflightResult const& preflightResult)
                 beast::zero };
     return invoke_calculateConsequences(preflightResult.tx);
 }
+static
+Arena&
+applyArena()
+{
+    thread_local Arena arena;
+    return arena;
+}
 std::pair<TER, bool>
 doApply(PreclaimResult const& preclaimResult,
     Application& app, OpenView& view)
@@ -292,6 +301,9 @@ doApply(PreclaimResult const& preclaimResult,
     {
         if (!preclaimResult.likelyToClaimFee)
             return{ preclaimResult.ter, false };
+        boost::optional<Arena::Scope> arena;
+        if (app.config().APPLY_ARENA)
+            arena.emplace(applyArena());
         ApplyContext ctx(app, view,
             preclaimResult.tx, preclaimResult.ter,
                 calculateBaseFee(view, preclaimResult.tx),
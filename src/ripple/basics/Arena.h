@@ -0,0 +1,291 @@
+#ifndef RIPPLE_BASICS_ARENA_H_INCLUDED
+#define RIPPLE_BASICS_ARENA_H_INCLUDED
+#include <ripple/basics/ByteUtilities.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+namespace ripple {
+class Arena
+{
+public:
+    struct Totals
+    {
+        std::atomic<std::uint64_t> allocations {0};
+        std::atomic<std::uint64_t> bytes {0};
+        std::atomic<std::uint64_t> fallbacks {0};
+        std::atomic<std::uint64_t> resets {0};
+    };
+private:
+    struct alignas(std::max_align_t) Block
+    {
+        Block* next;
+        std::size_t size;
+        std::size_t used;
+        std::uint8_t*
+        data()
+        {
+            return reinterpret_cast<std::uint8_t*>(this + 1);
+        }
+    };
+    static_assert(sizeof(Block) % alignof(std::max_align_t) == 0, "");
+    std::size_t const blockSize_;
+    std::size_t const limit_;
+    Block* blocks_ = nullptr;
+    std::size_t reserved_ = 0;
+    std::size_t live_ = 0;
+    std::uint64_t allocations_ = 0;
+    std::uint64_t bytes_ = 0;
+    std::uint64_t fallbacks_ = 0;
+    std::uint64_t resets_ = 0;
+    std::size_t highWater_ = 0;
+    std::uint64_t publishedAllocations_ = 0;
+    std::uint64_t publishedBytes_ = 0;
+    std::uint64_t publishedFallbacks_ = 0;
+    static
+    Arena*&
+    currentRef()
+    {
+        thread_local Arena* current = nullptr;
+        return current;
+    }
+    Block*
+    addBlock(std::size_t bytes)
+    {
+        auto const size = std::max(blockSize_, bytes);
+        if (reserved_ + size > limit_)
+            return nullptr;
+        auto const p = std::malloc(sizeof(Block) + size);
+        if (! p)
+            return nullptr;
+        auto const b = new(p) Block{blocks_, size, 0};
+        blocks_ = b;
+        reserved_ += size;
+        return b;
+    }
+    void
+    release(Block* b)
+    {
+        while (b)
+        {
+            auto const next = b->next;
+            reserved_ -= b->size;
+            b->~Block();
+            std::free(b);
+            b = next;
+        }
+    }
+public:
+    class Scope
+    {
+        Arena& arena_;
+        Arena* const prev_;
+    public:
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+        explicit
+        Scope(Arena& arena)
+            : arena_(arena)
+            , prev_(currentRef())
+        {
+            currentRef() = &arena_;
+        }
+        ~Scope()
+        {
+            currentRef() = prev_;
+            if (prev_ != &arena_)
+                arena_.reset();
+        }
+    };
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+    explicit
+    Arena(std::size_t blockSize = kilobytes(64),
+            std::size_t limit = megabytes(64))
+        : blockSize_(blockSize)
+        , limit_(limit)
+    {
+    }
+    ~Arena()
+    {
+        assert(live_ == 0);
+        if (live_ == 0)
+            release(blocks_);
+    }
+    static
+    Arena*
+    current()
+    {
+        return currentRef();
+    }
+    static
+    Totals&
+    totals()
+    {
+        static Totals t;
+        return t;
+    }
+    void*
+    allocate(std::size_t bytes, std::size_t align)
+    {
+        assert(align <= alignof(std::max_align_t));
+        bytes = (bytes + alignof(std::max_align_t) - 1) &
+            ~(alignof(std::max_align_t) - 1);
+        auto b = blocks_;
+        if (! b || b->size - b->used < bytes)
+            b = addBlock(bytes);
+        if (! b)
+        {
+            ++fallbacks_;
+            return nullptr;
+        }
+        auto const p = b->data() + b->used;
+        b->used += bytes;
+        ++live_;
+        ++allocations_;
+        bytes_ += bytes;
+        return p;
+    }
+    bool
+    deallocate(void* p)
+    {
+        auto const u = static_cast<std::uint8_t*>(p);
+        for (auto b = blocks_; b; b = b->next)
+        {
+            if (u >= b->data() && u < b->data() + b->size)
+            {
+                assert(live_ != 0);
+                --live_;
+                return true;
+            }
+        }
+        return false;
+    }
+    void
+    reset()
+    {
+        auto& t = totals();
+        t.allocations += allocations_ - publishedAllocations_;
+        t.bytes += bytes_ - publishedBytes_;
+        t.fallbacks += fallbacks_ - publishedFallbacks_;
+        publishedAllocations_ = allocations_;
+        publishedBytes_ = bytes_;
+        publishedFallbacks_ = fallbacks_;
+        assert(live_ == 0);
+        if (live_ != 0)
+        {
+            for (auto b = blocks_; b; b = b->next)
+                b->used = b->size;
+            return;
+        }
+        std::size_t used = 0;
+        for (auto b = blocks_; b; b = b->next)
+            used += b->used;
+        highWater_ = std::max(highWater_, used);
+        if (blocks_)
+        {
+            release(blocks_->next);
+            blocks_->next = nullptr;
+            blocks_->used = 0;
+        }
+        ++resets_;
+        ++t.resets;
+    }
+    std::size_t
+    reserved() const
+    {
+        return reserved_;
+    }
+    std::size_t
+    live() const
+    {
+        return live_;
+    }
+    std::uint64_t
+    allocations() const
+    {
+        return allocations_;
+    }
+    std::uint64_t
+    bytes() const
+    {
+        return bytes_;
+    }
+    std::uint64_t
+    fallbacks() const
+    {
+        return fallbacks_;
+    }
+    std::uint64_t
+    resets() const
+    {
+        return resets_;
+    }
+    std::size_t
+    highWater() const
+    {
+        return highWater_;
+    }
+};
+template <class T>
+class ArenaAllocator
+{
+    template <class>
+    friend class ArenaAllocator;
+    Arena* arena_;
+public:
+    using value_type = T;
+    template <class U>
+    struct rebind
+    {
+        using other = ArenaAllocator<U>;
+    };
+    ArenaAllocator()
+        : arena_(Arena::current())
+    {
+    }
+    template <class U>
+    ArenaAllocator(ArenaAllocator<U> const& u)
+        : arena_(u.arena_)
+    {
+    }
+    T*
+    allocate(std::size_t n)
+    {
+        if (arena_)
+        {
+            if (auto const p = arena_->allocate(n * sizeof(T), alignof(T)))
+                return static_cast<T*>(p);
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void
+    deallocate(T* p, std::size_t)
+    {
+        if (arena_ && arena_->deallocate(p))
+            return;
+        ::operator delete(p);
+    }
+    ArenaAllocator
+    select_on_container_copy_construction() const
+    {
+        return ArenaAllocator();
+    }
+    template <class U>
+    bool
+    operator==(ArenaAllocator<U> const& u) const
+    {
+        return arena_ == u.arena_;
+    }
+    template <class U>
+    bool
+    operator!=(ArenaAllocator<U> const& u) const
+    {
+        return arena_ != u.arena_;
+    }
+};
+}
+#endif
@@ -0,0 +1,231 @@
+#ifndef RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
+#define RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
+#include <ripple/basics/contract.h>
+#include <ripple/basics/spinlock.h>
+#include <boost/align/aligned_alloc.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+namespace ripple {
+class SlabAllocator
+{
+    struct FreeItem
+    {
+        FreeItem* next;
+    };
+    struct Shard;
+    struct Slab
+    {
+        Shard* owner;
+        FreeItem* free = nullptr;
+        std::size_t used = 0;
+        Slab* prev = nullptr;
+        Slab* next = nullptr;
+        bool listed = false;
+    };
+    struct Shard
+    {
+        mutable std::atomic<std::uint8_t> lock {0};
+        Slab* available = nullptr;
+        std::size_t slabs = 0;
+        std::size_t empty = 0;
+        std::size_t used = 0;
+        char pad[64];
+    };
+    static constexpr std::size_t header_ = ((sizeof(Slab) + 15) / 16) * 16;
+    std::size_t const itemSize_;
+    std::size_t const slabBytes_;
+    std::size_t const itemsPerSlab_;
+    std::size_t const shardCount_;
+    std::unique_ptr<Shard[]> shards_;
+    static
+    std::size_t
+    slabBytes (std::size_t itemSize, std::size_t itemsPerSlab)
+    {
+        std::size_t bytes = 4096;
+        while (bytes < header_ + itemSize * itemsPerSlab)
+            bytes *= 2;
+        return bytes;
+    }
+    static
+    std::size_t
+    shardCount ()
+    {
+        std::size_t const cores = std::thread::hardware_concurrency ();
+        return std::min<std::size_t> (std::max<std::size_t> (cores, 1), 32);
+    }
+    Shard&
+    shard ()
+    {
+        static std::atomic<std::size_t> threads {0};
+        thread_local std::size_t const index = threads++;
+        return shards_[index % shardCount_];
+    }
+    Slab*
+    slabOf (void* p) const
+    {
+        return reinterpret_cast<Slab*>(
+            reinterpret_cast<std::uintptr_t>(p) & ~(slabBytes_ - 1));
+    }
+    static
+    void
+    link (Shard& s, Slab* slab)
+    {
+        slab->prev = nullptr;
+        slab->next = s.available;
+        if (s.available != nullptr)
+            s.available->prev = slab;
+        s.available = slab;
+        slab->listed = true;
+    }
+    static
+    void
+    unlink (Shard& s, Slab* slab)
+    {
+        if (slab->prev != nullptr)
+            slab->prev->next = slab->next;
+        else
+            s.available = slab->next;
+        if (slab->next != nullptr)
+            slab->next->prev = slab->prev;
+        slab->prev = slab->next = nullptr;
+        slab->listed = false;
+    }
+    Slab*
+    create (Shard& s)
+    {
+        auto const raw = boost::alignment::aligned_alloc (
+            slabBytes_, slabBytes_);
+        if (raw == nullptr)
+            Throw<std::bad_alloc> ();
+        auto const slab = new (raw) Slab;
+        slab->owner = &s;
+        auto const items = static_cast<std::uint8_t*>(raw) + header_;
+        for (std::size_t i = itemsPerSlab_; i-- != 0;)
+        {
+            auto const item = reinterpret_cast<FreeItem*>(
+                items + i * itemSize_);
+            item->next = slab->free;
+            slab->free = item;
+        }
+        ++s.slabs;
+        ++s.empty;
+        link (s, slab);
+        return slab;
+    }
+    static
+    void
+    destroy (Slab* slab)
+    {
+        slab->~Slab ();
+        boost::alignment::aligned_free (slab);
+    }
+public:
+    SlabAllocator(SlabAllocator const&) = delete;
+    SlabAllocator& operator=(SlabAllocator const&) = delete;
+    SlabAllocator(std::size_t itemSize, std::size_t itemsPerSlab)
+        : itemSize_(((std::max(itemSize, sizeof(FreeItem)) + 15) / 16) * 16)
+        , slabBytes_(slabBytes(itemSize_, itemsPerSlab))
+        , itemsPerSlab_((slabBytes_ - header_) / itemSize_)
+        , shardCount_(shardCount())
+        , shards_(new Shard[shardCount_])
+    {
+        assert(itemsPerSlab != 0);
+    }
+    ~SlabAllocator()
+    {
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            auto& s = shards_[i];
+            assert(s.used == 0);
+            while (s.available != nullptr)
+            {
+                auto const slab = s.available;
+                unlink(s, slab);
+                destroy(slab);
+            }
+        }
+    }
+    std::size_t
+    size() const
+    {
+        return itemSize_;
+    }
+    void*
+    allocate()
+    {
+        auto& s = shard();
+        spinlock<std::uint8_t> sl(s.lock);
+        std::lock_guard<spinlock<std::uint8_t>> lock(sl);
+        auto slab = s.available;
+        if (slab == nullptr)
+            slab = create(s);
+        if (slab->used++ == 0)
+            --s.empty;
+        ++s.used;
+        auto const item = slab->free;
+        slab->free = item->next;
+        if (slab->free == nullptr)
+            unlink(s, slab);
+        return item;
+    }
+    void
+    deallocate(void* p)
+    {
+        assert(p != nullptr);
+        auto const slab = slabOf(p);
+        auto& s = *slab->owner;
+        spinlock<std::uint8_t> sl(s.lock);
+        std::lock_guard<spinlock<std::uint8_t>> lock(sl);
+        auto const item = static_cast<FreeItem*>(p);
+        item->next = slab->free;
+        slab->free = item;
+        --s.used;
+        if (! slab->listed)
+            link(s, slab);
+        if (--slab->used != 0)
+            return;
+        if (s.empty != 0)
+        {
+            unlink(s, slab);
+            --s.slabs;
+            destroy(slab);
+            return;
+        }
+        ++s.empty;
+    }
+    std::size_t
+    allocated() const
+    {
+        std::size_t used = 0;
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            auto const& s = shards_[i];
+            spinlock<std::uint8_t> sl(s.lock);
+            std::lock_guard<spinlock<std::uint8_t>> lock(sl);
+            used += s.used;
+        }
+        return used;
+    }
+    std::size_t
+    reserved() const
+    {
+        std::size_t slabs = 0;
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            auto const& s = shards_[i];
+            spinlock<std::uint8_t> sl(s.lock);
+            std::lock_guard<spinlock<std::uint8_t>> lock(sl);
+            slabs += s.slabs;
+        }
+        return slabs * itemsPerSlab_;
+    }
+};
+}
+#endif
@@ -5,7 +5,11 @@
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/insight/Insight.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 namespace ripple {
@@ -31,7 +35,8 @@ public:
 public:
     TaggedCache (std::string const& name, int size,
         clock_type::duration expiration, clock_type& clock, beast::Journal journal,
-            beast::insight::Collector::ptr const& collector = beast::insight::NullCollector::New ())
+            beast::insight::Collector::ptr const& collector = beast::insight::NullCollector::New (),
+                std::size_t partitions = 1)
         : m_journal (journal)
         , m_clock (clock)
         , m_stats (name,
@@ -40,108 +45,146 @@ public:
         , m_name (name)
         , m_target_size (size)
         , m_target_age (expiration)
-        , m_cache_count (0)
-        , m_hits (0)
-        , m_misses (0)
+        , m_partitions (std::max<std::size_t> (partitions, 1))
     {
+        for (auto& p : m_partitions)
+            p = std::make_unique<Partition> ();
     }
 public:
     clock_type& clock ()
     {
         return m_clock;
     }
+    std::size_t partitions () const
+    {
+        return m_partitions.size ();
+    }
     int getTargetSize () const
     {
-        lock_guard lock (m_mutex);
         return m_target_size;
     }
     void setTargetSize (int s)
     {
-        lock_guard lock (m_mutex);
         m_target_size = s;
         if (s > 0)
-            m_cache.rehash (static_cast<std::size_t> ((s + (s >> 2)) / m_cache.max_load_factor () + 1));
+        {
+            auto const n = static_cast<int> (m_partitions.size ());
+            auto const per = (s + n - 1) / n;
+            for (auto& p : m_partitions)
+            {
+                lock_guard lock (p->mutex);
+                p->cache.rehash (static_cast<std::size_t> ((per + (per >> 2)) / p->cache.max_load_factor () + 1));
+            }
+        }
         JLOG(m_journal.debug()) <<
             m_name << " target size set to " << s;
     }
     clock_type::duration getTargetAge () const
     {
-        lock_guard lock (m_mutex);
         return m_target_age;
     }
     void setTargetAge (clock_type::duration s)
     {
-        lock_guard lock (m_mutex);
         m_target_age = s;
         JLOG(m_journal.debug()) <<
-            m_name << " target age set to " << m_target_age.count();
+            m_name << " target age set to " << s.count();
     }
     int getCacheSize () const
     {
-        lock_guard lock (m_mutex);
-        return m_cache_count;
+        int count = 0;
+        for (auto const& p : m_partitions)
+        {
+            lock_guard lock (p->mutex);
+            count += p->cache_count;
+        }
+        return count;
     }
     int getTrackSize () const
     {
-        lock_guard lock (m_mutex);
-        return m_cache.size ();
+        std::size_t size = 0;
+        for (auto const& p : m_partitions)
+        {
+            lock_guard lock (p->mutex);
+            size += p->cache.size ();
+        }
+        return size;
     }
     float getHitRate ()
     {
-        lock_guard lock (m_mutex);
-        auto const total = static_cast<float> (m_hits + m_misses);
-        return m_hits * (100.0f / std::max (1.0f, total));
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        for (auto const& p : m_partitions)
+        {
+            lock_guard lock (p->mutex);
+            hits += p->hits;
+            misses += p->misses;
+        }
+        auto const total = static_cast<float> (hits + misses);
+        return hits * (100.0f / std::max (1.0f, total));
     }
     void clear ()
     {
-        lock_guard lock (m_mutex);
-        m_cache.clear ();
-        m_cache_count = 0;
+        for (auto& p : m_partitions)
+        {
+            lock_guard lock (p->mutex);
+            p->cache.clear ();
+            p->cache_count = 0;
+        }
     }
     void reset ()
     {
-        lock_guard lock (m_mutex);
-        m_cache.clear();
-        m_cache_count = 0;
-        m_hits = 0;
-        m_misses = 0;
+        for (auto& p : m_partitions)
+        {
+            lock_guard lock (p->mutex);
+            p->cache.clear();
+            p->cache_count = 0;
+            p->hits = 0;
+            p->misses = 0;
+        }
     }
     void sweep ()
     {
         int cacheRemovals = 0;
         int mapRemovals = 0;
         int cc = 0;
-        std::vector <mapped_ptr> stuffToSweep;
+        std::size_t remaining = 0;
+        auto const n = static_cast<int> (m_partitions.size ());
+        int const targetSize = m_target_size;
+        clock_type::duration const targetAge = m_target_age;
+        int const partitionSize = (targetSize + n - 1) / n;
+        for (auto& p : m_partitions)
         {
+            std::vector <mapped_ptr> stuffToSweep;
             clock_type::time_point const now (m_clock.now());
             clock_type::time_point when_expire;
-            lock_guard lock (m_mutex);
-            if (m_target_size == 0 ||
-                (static_cast<int> (m_cache.size ()) <= m_target_size))
+            lock_guard lock (p->mutex);
+            cache_type& cache = p->cache;
+            if (partitionSize == 0 ||
+                (static_cast<int> (cache.size ()) <= partitionSize))
             {
-                when_expire = now - m_target_age;
+                when_expire = now - targetAge;
             }
             else
             {
-                when_expire = now - m_target_age*m_target_size/m_cache.size();
+                when_expire = now - targetAge*partitionSize/cache.size();
                 clock_type::duration const minimumAge (
                     std::chrono::seconds (1));
                 if (when_expire > (now - minimumAge))
                     when_expire = now - minimumAge;
                 JLOG(m_journal.trace()) <<
-                    m_name << " is growing fast " << m_cache.size () << " of " << m_target_size <<
-                        " aging at " << (now - when_expire).count() << " of " << m_target_age.count();
+                    m_name << " is growing fast " << cache.size () << " of " << partitionSize <<
+                        " aging at " << (now - when_expire).count() << " of " << targetAge.count();
             }
-            stuffToSweep.reserve (m_cache.size ());
-            cache_iterator cit = m_cache.begin ();
-            while (cit != m_cache.end ())
+            stuffToSweep.reserve (cache.size ());
+            cache_iterator cit = cache.begin ();
+            while (cit != cache.end ())
             {
                 if (cit->second.isWeak ())
                 {
                     if (cit->second.isExpired ())
                     {
                         ++mapRemovals;
-                        cit = m_cache.erase (cit);
+                        cit = cache.erase (cit);
                     }
                     else
                     {
@@ -150,13 +193,13 @@ public:
                 }
                 else if (cit->second.last_access <= when_expire)
                 {
-                    --m_cache_count;
+                    --p->cache_count;
                     ++cacheRemovals;
                     if (cit->second.ptr.unique ())
                     {
                         stuffToSweep.push_back (cit->second.ptr);
                         ++mapRemovals;
-                        cit = m_cache.erase (cit);
+                        cit = cache.erase (cit);
                     }
                     else
                     {
@@ -170,42 +213,45 @@ public:
                     ++cit;
                 }
             }
+            remaining += cache.size ();
         }
         if (mapRemovals || cacheRemovals)
         {
             JLOG(m_journal.trace()) <<
-                m_name << ": cache = " << m_cache.size () <<
+                m_name << ": cache = " << remaining <<
                 "-" << cacheRemovals << ", map-=" << mapRemovals;
         }
     }
     bool del (const key_type& key, bool valid)
     {
-        lock_guard lock (m_mutex);
-        cache_iterator cit = m_cache.find (key);
-        if (cit == m_cache.end ())
+        Partition& p = partition (key);
+        lock_guard lock (p.mutex);
+        cache_iterator cit = p.cache.find (key);
+        if (cit == p.cache.end ())
             return false;
         Entry& entry = cit->second;
         bool ret = false;
         if (entry.isCached ())
         {
-            --m_cache_count;
+            --p.cache_count;
             entry.ptr.reset ();
             ret = true;
         }
         if (!valid || entry.isExpired ())
-            m_cache.erase (cit);
+            p.cache.erase (cit);
         return ret;
     }
     bool canonicalize (const key_type& key, std::shared_ptr<T>& data, bool replace = false)
     {
-        lock_guard lock (m_mutex);
-        cache_iterator cit = m_cache.find (key);
-        if (cit == m_cache.end ())
+        Partition& p = partition (key);
+        lock_guard lock (p.mutex);
+        cache_iterator cit = p.cache.find (key);
+        if (cit == p.cache.end ())
         {
-            m_cache.emplace (std::piecewise_construct,
+            p.cache.emplace (std::piecewise_construct,
                 std::forward_as_tuple(key),
                 std::forward_as_tuple(m_clock.now(), data));
-            ++m_cache_count;
+            ++p.cache_count;
             return false;
         }
         Entry& entry = cit->second;
@@ -236,38 +282,39 @@ public:
                 entry.ptr = cachedData;
                 data = cachedData;
             }
-            ++m_cache_count;
+            ++p.cache_count;
             return true;
         }
         entry.ptr = data;
         entry.weak_ptr = data;
-        ++m_cache_count;
+        ++p.cache_count;
         return false;
     }
     std::shared_ptr<T> fetch (const key_type& key)
     {
-        lock_guard lock (m_mutex);
-        cache_iterator cit = m_cache.find (key);
-        if (cit == m_cache.end ())
+        Partition& p = partition (key);
+        lock_guard lock (p.mutex);
+        cache_iterator cit = p.cache.find (key);
+        if (cit == p.cache.end ())
         {
-            ++m_misses;
+            ++p.misses;
             return mapped_ptr ();
         }
         Entry& entry = cit->second;
         entry.touch (m_clock.now());
         if (entry.isCached ())
         {
-            ++m_hits;
+            ++p.hits;
             return entry.ptr;
         }
         entry.ptr = entry.lock ();
         if (entry.isCached ())
         {
-            ++m_cache_count;
+            ++p.cache_count;
             return entry.ptr;
         }
-        m_cache.erase (cit);
-        ++m_misses;
+        p.cache.erase (cit);
+        ++p.misses;
         return mapped_ptr ();
     }
     bool insert (key_type const& key, T const& value)
@@ -287,9 +334,10 @@ public:
     bool refreshIfPresent (const key_type& key)
     {
         bool found = false;
-        lock_guard lock (m_mutex);
-        cache_iterator cit = m_cache.find (key);
-        if (cit != m_cache.end ())
+        Partition& p = partition (key);
+        lock_guard lock (p.mutex);
+        cache_iterator cit = p.cache.find (key);
+        if (cit != p.cache.end ())
         {
             Entry& entry = cit->second;
             if (! entry.isCached ())
@@ -297,13 +345,13 @@ public:
                 entry.ptr = entry.lock ();
                 if (entry.isCached ())
                 {
-                    ++m_cache_count;
+                    ++p.cache_count;
                     entry.touch (m_clock.now());
                     found = true;
                 }
                 else
                 {
-                    m_cache.erase (cit);
+                    p.cache.erase (cit);
                 }
             }
             else
@@ -319,15 +367,17 @@ public:
     }
     mutex_type& peekMutex ()
     {
-        return m_mutex;
+        assert (m_partitions.size () == 1);
+        return m_partitions.front ()->mutex;
     }
     std::vector <key_type> getKeys () const
     {
         std::vector <key_type> v;
+        for (auto const& p : m_partitions)
         {
-            lock_guard lock (m_mutex);
-            v.reserve (m_cache.size());
-            for (auto const& _ : m_cache)
+            lock_guard lock (p->mutex);
+            v.reserve (v.size () + p->cache.size());
+            for (auto const& _ : p->cache)
                 v.push_back (_.first);
         }
         return v;
@@ -339,10 +389,17 @@ private:
         {
             beast::insight::Gauge::value_type hit_rate (0);
             {
-                lock_guard lock (m_mutex);
-                auto const total (m_hits + m_misses);
+                std::uint64_t hits = 0;
+                std::uint64_t misses = 0;
+                for (auto const& p : m_partitions)
+                {
+                    lock_guard lock (p->mutex);
+                    hits += p->hits;
+                    misses += p->misses;
+                }
+                auto const total (hits + misses);
                 if (total != 0)
-                    hit_rate = (m_hits * 100) / total;
+                    hit_rate = (hits * 100) / total;
             }
             m_stats.hit_rate.set (hit_rate);
         }
@@ -382,17 +439,29 @@ private:
     };
     using cache_type = hardened_hash_map <key_type, Entry, Hash, KeyEqual>;
     using cache_iterator = typename cache_type::iterator;
+    struct Partition
+    {
+        mutex_type mutable mutex;
+        cache_type cache;
+        int cache_count = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+    Partition& partition (key_type const& key) const
+    {
+        if (m_partitions.size () == 1)
+            return *m_partitions.front ();
+        auto const h = m_hash (key);
+        return *m_partitions[(h >> (sizeof (h) * 4)) % m_partitions.size ()];
+    }
     beast::Journal m_journal;
     clock_type& m_clock;
     Stats m_stats;
-    mutex_type mutable m_mutex;
     std::string m_name;
-    int m_target_size;
-    clock_type::duration m_target_age;
-    int m_cache_count;
-    cache_type m_cache;  
-    std::uint64_t m_hits;
-    std::uint64_t m_misses;
+    std::atomic<int> m_target_size;
+    std::atomic<clock_type::duration> m_target_age;
+    Hash m_hash;
+    std::vector<std::unique_ptr<Partition>> m_partitions;
 };
 }
 #endif
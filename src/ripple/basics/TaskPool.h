@@ -0,0 +1,64 @@
+#ifndef RIPPLE_BASICS_TASKPOOL_H_INCLUDED
+#define RIPPLE_BASICS_TASKPOOL_H_INCLUDED
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+namespace ripple {
+class TaskPool
+{
+public:
+    using Function = std::function<void(std::size_t)>;
+    TaskPool (std::size_t threads, std::string name);
+    ~TaskPool ();
+    TaskPool (TaskPool const&) = delete;
+    TaskPool& operator= (TaskPool const&) = delete;
+    std::size_t
+    concurrency () const
+    {
+        return threads_.size () + 1;
+    }
+    void
+    forEach (std::size_t n, Function const& f,
+        std::size_t limit = std::numeric_limits<std::size_t>::max ());
+private:
+    struct Batch
+    {
+        Batch (std::size_t count, Function const& function,
+                std::size_t helperCount)
+            : n (count)
+            , f (function)
+            , helpers (helperCount)
+        {
+        }
+        std::size_t const n;
+        Function const& f;
+        std::size_t const helpers;
+        std::size_t joined = 0;
+        std::atomic<std::size_t> next {0};
+        std::atomic<bool> failed {false};
+        std::size_t done = 0;
+        std::exception_ptr error;
+    };
+    void
+    work (Batch& batch);
+    void
+    run ();
+    std::string const name_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable doneCond_;
+    std::deque<std::shared_ptr<Batch>> batches_;
+    bool stop_ = false;
+    std::vector<std::thread> threads_;
+};
+}
+#endif
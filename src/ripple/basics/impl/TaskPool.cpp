@@ -0,0 +1,114 @@
+#include <ripple/basics/TaskPool.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <algorithm>
+namespace ripple {
+TaskPool::TaskPool (std::size_t threads, std::string name)
+    : name_ (std::move (name))
+{
+    threads_.reserve (threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        threads_.emplace_back (&TaskPool::run, this);
+}
+TaskPool::~TaskPool ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all ();
+    for (auto& t : threads_)
+        t.join ();
+}
+void
+TaskPool::forEach (std::size_t n, Function const& f, std::size_t limit)
+{
+    if (n == 0)
+        return;
+    auto const helpers = std::min ({threads_.size (), n - 1,
+        std::max<std::size_t> (limit, 1) - 1});
+    auto const batch = std::make_shared<Batch> (n, f, helpers);
+    if (helpers != 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            batches_.push_back (batch);
+        }
+        cond_.notify_all ();
+    }
+    work (*batch);
+    std::unique_lock<std::mutex> lock (mutex_);
+    doneCond_.wait (lock, [&]{ return batch->done == n; });
+    batches_.erase (std::remove (batches_.begin (), batches_.end (), batch),
+        batches_.end ());
+    if (batch->error)
+        std::rethrow_exception (batch->error);
+}
+void
+TaskPool::work (Batch& batch)
+{
+    std::size_t done = 0;
+    std::exception_ptr error;
+    for (auto i = batch.next++; i < batch.n; i = batch.next++)
+    {
+        if (! batch.failed)
+        {
+            try
+            {
+                batch.f (i);
+            }
+            catch (...)
+            {
+                if (! error)
+                    error = std::current_exception ();
+                batch.failed = true;
+            }
+        }
+        ++done;
+    }
+    if (done == 0)
+        return;
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (error && ! batch.error)
+        batch.error = error;
+    batch.done += done;
+    if (batch.done == batch.n)
+        doneCond_.notify_all ();
+}
+void
+TaskPool::run ()
+{
+    beast::setCurrentThreadName (name_);
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (true)
+    {
+        std::shared_ptr<Batch> batch;
+        cond_.wait (lock, [&]
+        {
+            if (stop_)
+                return true;
+            auto it = batches_.begin ();
+            while (it != batches_.end ())
+            {
+                if ((*it)->next >= (*it)->n)
+                {
+                    it = batches_.erase (it);
+                    continue;
+                }
+                if ((*it)->joined < (*it)->helpers)
+                {
+                    batch = *it;
+                    return true;
+                }
+                ++it;
+            }
+            return false;
+        });
+        if (stop_)
+            return;
+        ++batch->joined;
+        lock.unlock ();
+        work (*batch);
+        lock.lock ();
+    }
+}
+}
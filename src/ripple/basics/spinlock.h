@@ -0,0 +1,97 @@
+#ifndef RIPPLE_BASICS_SPINLOCK_H_INCLUDED
+#define RIPPLE_BASICS_SPINLOCK_H_INCLUDED
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#if !defined(__clang__) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+namespace ripple {
+namespace detail {
+inline
+void
+spin_pause() noexcept
+{
+#ifdef _MSC_VER
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    asm volatile("pause");
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+} 
+template <class T>
+class packed_spinlock
+{
+    static_assert(std::is_unsigned<T>::value, "");
+    std::atomic<T>& bits_;
+    T const mask_;
+public:
+    packed_spinlock(packed_spinlock const&) = delete;
+    packed_spinlock& operator=(packed_spinlock const&) = delete;
+    packed_spinlock(std::atomic<T>& lock, int index)
+        : bits_(lock)
+        , mask_(static_cast<T>(1) << index)
+    {
+        assert(index >= 0 && (mask_ != 0));
+    }
+    bool
+    try_lock()
+    {
+        return (bits_.fetch_or(mask_, std::memory_order_acquire) & mask_) == 0;
+    }
+    void
+    lock()
+    {
+        while (!try_lock())
+        {
+            while ((bits_.load(std::memory_order_relaxed) & mask_) != 0)
+                detail::spin_pause();
+        }
+    }
+    void
+    unlock()
+    {
+        bits_.fetch_and(static_cast<T>(~mask_), std::memory_order_release);
+    }
+};
+template <class T>
+class spinlock
+{
+    static_assert(std::is_unsigned<T>::value, "");
+    std::atomic<T>& lock_;
+public:
+    spinlock(spinlock const&) = delete;
+    spinlock& operator=(spinlock const&) = delete;
+    explicit
+    spinlock(std::atomic<T>& lock)
+        : lock_(lock)
+    {
+    }
+    bool
+    try_lock()
+    {
+        T expected = 0;
+        return lock_.compare_exchange_weak(expected,
+            std::numeric_limits<T>::max(),
+            std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    void
+    lock()
+    {
+        while (!try_lock())
+        {
+            while (lock_.load(std::memory_order_relaxed) != 0)
+                detail::spin_pause();
+        }
+    }
+    void
+    unlock()
+    {
+        lock_.store(0, std::memory_order_release);
+    }
+};
+} 
+#endif
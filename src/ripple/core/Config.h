@@ -98,6 +98,11 @@ public:
     std::string                 SSL_VERIFY_FILE;
     std::string                 SSL_VERIFY_DIR;
     std::size_t                 WORKERS = 0;
+    std::size_t                 LEDGER_APPLY_THREADS = 1;
+    std::size_t                 LEDGER_FLUSH_THREADS = 1;
+    std::size_t                 LEDGER_PREFETCH_WINDOW = 32;
+    std::size_t                 SIG_VERIFY_THREADS = 0;
+    bool                        APPLY_ARENA = true;
     boost::optional<beast::IP::Endpoint> rpc_ip;
     std::unordered_set<uint256, beast::uhash<>> features;
 public:
@@ -10,6 +10,7 @@ struct ConfigSection
     static std::string importNodeDatabase () { return "import_db"; }
 };
 #define SECTION_AMENDMENTS              "amendments"
+#define SECTION_APPLY_ARENA             "apply_arena"
 #define SECTION_CLUSTER_NODES           "cluster_nodes"
 #define SECTION_DEBUG_LOGFILE           "debug_logfile"
 #define SECTION_ELB_SUPPORT             "elb_support"
@@ -18,6 +19,9 @@ struct ConfigSection
 #define SECTION_FEE_ACCOUNT_RESERVE     "fee_account_reserve"
 #define SECTION_FEE_OWNER_RESERVE       "fee_owner_reserve"
 #define SECTION_FETCH_DEPTH             "fetch_depth"
+#define SECTION_LEDGER_APPLY_THREADS    "ledger_apply_threads"
+#define SECTION_LEDGER_FLUSH_THREADS    "ledger_flush_threads"
+#define SECTION_LEDGER_PREFETCH_WINDOW "ledger_prefetch_window"
 #define SECTION_LEDGER_HISTORY          "ledger_history"
 #define SECTION_INSIGHT                 "insight"
 #define SECTION_IPS                     "ips"
@@ -32,6 +36,7 @@ struct ConfigSection
 #define SECTION_PEER_PRIVATE            "peer_private"
 #define SECTION_PEERS_MAX               "peers_max"
 #define SECTION_RPC_STARTUP             "rpc_startup"
+#define SECTION_SIG_VERIFY_THREADS      "sig_verify_threads"
 #define SECTION_SIGNING_SUPPORT         "signing_support"
 #define SECTION_SNTP                    "sntp_servers"
 #define SECTION_SSL_VERIFY              "ssl_verify"
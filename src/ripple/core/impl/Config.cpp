@@ -288,6 +288,32 @@ void Config::loadFromString (std::string const& fileContents)
         DEBUG_LOGFILE       = strTemp;
     if (getSingleSection (secConfig, SECTION_WORKERS, strTemp, j_))
         WORKERS      = beast::lexicalCastThrow <std::size_t> (strTemp);
+    if (getSingleSection (secConfig, SECTION_LEDGER_APPLY_THREADS, strTemp, j_))
+    {
+        LEDGER_APPLY_THREADS = beast::lexicalCastThrow <std::size_t> (strTemp);
+        if (LEDGER_APPLY_THREADS < 1)
+            LEDGER_APPLY_THREADS = 1;
+        else if (LEDGER_APPLY_THREADS > 64)
+            LEDGER_APPLY_THREADS = 64;
+    }
+    if (getSingleSection (secConfig, SECTION_LEDGER_FLUSH_THREADS, strTemp, j_))
+    {
+        LEDGER_FLUSH_THREADS = beast::lexicalCastThrow <std::size_t> (strTemp);
+        if (LEDGER_FLUSH_THREADS < 1)
+            LEDGER_FLUSH_THREADS = 1;
+        else if (LEDGER_FLUSH_THREADS > 16)
+            LEDGER_FLUSH_THREADS = 16;
+    }
+    if (getSingleSection (secConfig, SECTION_LEDGER_PREFETCH_WINDOW, strTemp, j_))
+    {
+        LEDGER_PREFETCH_WINDOW = beast::lexicalCastThrow <std::size_t> (strTemp);
+        if (LEDGER_PREFETCH_WINDOW > 1024)
+            LEDGER_PREFETCH_WINDOW = 1024;
+    }
+    if (getSingleSection (secConfig, SECTION_SIG_VERIFY_THREADS, strTemp, j_))
+        SIG_VERIFY_THREADS = beast::lexicalCastThrow <std::size_t> (strTemp);
+    if (getSingleSection (secConfig, SECTION_APPLY_ARENA, strTemp, j_))
+        APPLY_ARENA = beast::lexicalCastThrow <bool> (strTemp);
     if (! RUN_STANDALONE)
     {
         boost::filesystem::path validatorsFile;
@@ -4,10 +4,35 @@
 #include <algorithm>
 #include <string>
 #include <cctype>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 namespace Json
 {
 constexpr unsigned Reader::nest_limit;
 static
+Reader::Location
+findStringDelimiter (Reader::Location first, Reader::Location last)
+{
+#if defined(__SSE2__)
+    __m128i const quote = _mm_set1_epi8 ('"');
+    __m128i const escape = _mm_set1_epi8 ('\\');
+    while (last - first >= 16)
+    {
+        __m128i const chunk = _mm_loadu_si128 (
+            reinterpret_cast<__m128i const*> (first));
+        int const mask = _mm_movemask_epi8 (_mm_or_si128 (
+            _mm_cmpeq_epi8 (chunk, quote), _mm_cmpeq_epi8 (chunk, escape)));
+        if (mask != 0)
+            return first + __builtin_ctz (mask);
+        first += 16;
+    }
+#endif
+    while (first != last && *first != '"' && *first != '\\')
+        ++first;
+    return first;
+}
+static
 std::string
 codePointToUTF8 (unsigned int cp)
 {
@@ -296,16 +321,16 @@ Reader::readNumber ()
 bool
 Reader::readString ()
 {
-    Char c = 0;
     while ( current_ != end_ )
     {
-        c = getNextChar ();
-        if ( c == '\\' )
-            getNextChar ();
-        else if ( c == '"' )
+        current_ = findStringDelimiter ( current_, end_ );
+        if ( current_ == end_ )
             break;
+        if ( getNextChar () == '"' )
+            return true;
+        getNextChar ();
     }
-    return c == '"';
+    return false;
 }
 bool
 Reader::readObject(Token& tokenStart, unsigned depth)
@@ -334,9 +359,10 @@ Reader::readObject(Token& tokenStart, unsigned depth)
                                         colon,
                                         tokenObjectEnd );
         }
-        if (currentValue ().isMember (name))
-            return addError ( "Key '" + name + "' appears twice.", tokenName );
+        auto const members = currentValue ().size ();
         Value& value = currentValue ()[ name ];
+        if (currentValue ().size () == members)
+            return addError ( "Key '" + name + "' appears twice.", tokenName );
         nodes_.push ( &value );
         bool ok = readValue(depth+1);
         nodes_.pop ();
@@ -501,6 +527,11 @@ Reader::decodeString ( Token& token, std::string& decoded )
     Location end = token.end_ - 1;      
     while ( current != end )
     {
+        Location const run = findStringDelimiter ( current, end );
+        decoded.append ( current, run );
+        if ( run == end )
+            break;
+        current = run;
         Char c = *current++;
         if ( c == '"' )
             break;
@@ -547,10 +578,6 @@ Reader::decodeString ( Token& token, std::string& decoded )
                 return addError ( "Bad escape sequence in string", token, current );
             }
         }
-        else
-        {
-            decoded += c;
-        }
     }
     return true;
 }
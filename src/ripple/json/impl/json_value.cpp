@@ -50,6 +50,52 @@ static struct DummyValueAllocatorInitializer
         valueAllocator ();     
     }
 } dummyValueAllocatorInitializer;
+static ripple::Arena*& currentArena ()
+{
+    thread_local ripple::Arena* current = nullptr;
+    return current;
+}
+using ObjectValuesAllocator = std::allocator_traits<
+    Value::ObjectValues::allocator_type>::rebind_alloc<Value::ObjectValues>;
+template <class... Args>
+static Value::ObjectValues* makeObjectValues (
+    ObjectValuesAllocator alloc, Args const&... args )
+{
+    auto const p = alloc.allocate ( 1 );
+    try
+    {
+        new ( p ) Value::ObjectValues ( args... );
+    }
+    catch ( ... )
+    {
+        alloc.deallocate ( p, 1 );
+        ripple::Rethrow ();
+    }
+    return p;
+}
+static void destroyObjectValues ( Value::ObjectValues* map )
+{
+    using ObjectValues = Value::ObjectValues;
+    ObjectValuesAllocator alloc ( map->get_allocator () );
+    map->~ObjectValues ();
+    alloc.deallocate ( map, 1 );
+}
+Value::Scope::Scope ( ripple::Arena& arena )
+    : arena_ ( arena )
+    , prev_ ( currentArena () )
+{
+    currentArena () = &arena_;
+}
+Value::Scope::~Scope ()
+{
+    currentArena () = prev_;
+    if ( prev_ != &arena_ )
+        arena_.reset ();
+}
+ripple::Arena* Value::Scope::current ()
+{
+    return currentArena ();
+}
 Value::CZString::CZString ( int index )
     : cstr_ ( 0 )
     , index_ ( index )
@@ -137,8 +183,11 @@ Value::Value ( ValueType type )
         break;
     case arrayValue:
     case objectValue:
-        value_.map_ = new ObjectValues ();
+    {
+        ObjectValuesAllocator alloc;
+        value_.map_ = makeObjectValues ( alloc, alloc );
         break;
+    }
     case booleanValue:
         value_.bool_ = false;
         break;
@@ -216,7 +265,8 @@ Value::Value ( const Value& other )
         break;
     case arrayValue:
     case objectValue:
-        value_.map_ = new ObjectValues ( *other.value_.map_ );
+        value_.map_ = makeObjectValues ( other.value_.map_->get_allocator ()
+            .select_on_container_copy_construction (), *other.value_.map_ );
         break;
     default:
         JSON_ASSERT_UNREACHABLE;
@@ -239,7 +289,7 @@ Value::~Value ()
     case arrayValue:
     case objectValue:
         if (value_.map_)
-            delete value_.map_;
+            destroyObjectValues (value_.map_);
         break;
     default:
         JSON_ASSERT_UNREACHABLE;
@@ -707,6 +757,11 @@ Value::append ( const Value& value )
 {
     return (*this)[size ()] = value;
 }
+Value&
+Value::append ( Value&& value )
+{
+    return (*this)[size ()] = std::move ( value );
+}
 Value
 Value::get ( const char* key,
              const Value& defaultValue ) const
@@ -112,11 +112,11 @@ bool
 Reader::parse(Value& root, BufferSequence const& bs)
 {
     using namespace boost::asio;
-    std::string s;
-    s.reserve (buffer_size(bs));
+    document_.clear();
+    document_.reserve (buffer_size(bs));
     for (auto const& b : bs)
-        s.append(buffer_cast<char const*>(b), buffer_size(b));
-    return parse(s, root);
+        document_.append(buffer_cast<char const*>(b), buffer_size(b));
+    return parse(document_.data(), document_.data() + document_.size(), root);
 }
 std::istream& operator>> ( std::istream&, Value& );
 } 
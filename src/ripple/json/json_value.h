@@ -1,5 +1,6 @@
 #ifndef RIPPLE_JSON_JSON_VALUE_H_INCLUDED
 #define RIPPLE_JSON_JSON_VALUE_H_INCLUDED
+#include <ripple/basics/Arena.h>
 #include <ripple/json/json_forwards.h>
 #include <cstring>
 #include <functional>
@@ -108,7 +109,72 @@ private:
         int index_;
     };
 public:
-    using ObjectValues = std::map<CZString, Value>;
+    class Scope
+    {
+        ripple::Arena& arena_;
+        ripple::Arena* const prev_;
+    public:
+        Scope ( Scope const& ) = delete;
+        Scope& operator= ( Scope const& ) = delete;
+        explicit Scope ( ripple::Arena& arena );
+        ~Scope ();
+        static ripple::Arena* current ();
+    };
+private:
+    template <class T>
+    class Allocator
+    {
+        template <class>
+        friend class Allocator;
+        ripple::Arena* arena_;
+    public:
+        using value_type = T;
+        Allocator ()
+            : arena_ ( Scope::current () )
+        {
+        }
+        explicit Allocator ( ripple::Arena* arena )
+            : arena_ ( arena )
+        {
+        }
+        template <class U>
+        Allocator ( Allocator<U> const& u )
+            : arena_ ( u.arena_ )
+        {
+        }
+        T* allocate ( std::size_t n )
+        {
+            if ( arena_ )
+            {
+                if ( auto const p = arena_->allocate ( n * sizeof ( T ), alignof ( T ) ) )
+                    return static_cast<T*> ( p );
+            }
+            return static_cast<T*> ( ::operator new ( n * sizeof ( T ) ) );
+        }
+        void deallocate ( T* p, std::size_t )
+        {
+            if ( arena_ && arena_->deallocate ( p ) )
+                return;
+            ::operator delete ( p );
+        }
+        Allocator select_on_container_copy_construction () const
+        {
+            return Allocator ( nullptr );
+        }
+        template <class U>
+        bool operator== ( Allocator<U> const& u ) const
+        {
+            return arena_ == u.arena_;
+        }
+        template <class U>
+        bool operator!= ( Allocator<U> const& u ) const
+        {
+            return arena_ != u.arena_;
+        }
+    };
+public:
+    using ObjectValues = std::map<CZString, Value, std::less<CZString>,
+        Allocator<std::pair<const CZString, Value>>>;
 public:
     Value ( ValueType type = nullValue );
     Value ( Int value );
@@ -156,6 +222,7 @@ public:
                 const Value& defaultValue ) const;
     bool isValidIndex ( UInt index ) const;
     Value& append ( const Value& value );
+    Value& append ( Value&& value );
     Value& operator[] ( const char* key );
     const Value& operator[] ( const char* key ) const;
     Value& operator[] ( std::string const& key );
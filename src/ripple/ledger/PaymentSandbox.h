@@ -4,6 +4,7 @@
 #include <ripple/ledger/Sandbox.h>
 #include <ripple/ledger/detail/ApplyViewBase.h>
 #include <ripple/protocol/AccountID.h>
+#include <ripple/basics/Arena.h>
 #include <map>
 #include <utility>
 namespace ripple {
@@ -48,8 +49,11 @@ private:
     makeKey (AccountID const& a1,
         AccountID const& a2,
             Currency const& c);
-    std::map<Key, Value> credits_;
-    std::map<AccountID, std::uint32_t> ownerCounts_;
+    std::map<Key, Value, std::less<Key>,
+        ArenaAllocator<std::pair<Key const, Value>>> credits_;
+    std::map<AccountID, std::uint32_t, std::less<AccountID>,
+        ArenaAllocator<std::pair<AccountID const, std::uint32_t>>>
+            ownerCounts_;
 };
 } 
 class PaymentSandbox final
@@ -6,7 +6,9 @@
 #include <ripple/ledger/TxMeta.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/XRPAmount.h>
+#include <ripple/basics/Arena.h>
 #include <ripple/beast/utility/Journal.h>
+#include <boost/container/flat_map.hpp>
 #include <memory>
 namespace ripple {
 namespace detail {
@@ -22,8 +24,10 @@ private:
         insert,
         modify,
     };
-    using items_t = std::map<key_type,
-        std::pair<Action, std::shared_ptr<SLE>>>;
+    using items_t = boost::container::flat_map<key_type,
+        std::pair<Action, std::shared_ptr<SLE>>, std::less<key_type>,
+        ArenaAllocator<std::pair<key_type,
+        std::pair<Action, std::shared_ptr<SLE>>>>>;
     items_t items_;
     XRPAmount dropsDestroyed_ = 0;
 public:
@@ -84,7 +88,8 @@ public:
     }
 private:
     using Mods = hash_map<key_type,
-        std::shared_ptr<SLE>>;
+        std::shared_ptr<SLE>, beast::uhash<>, std::equal_to<key_type>,
+        ArenaAllocator<std::pair<key_type const, std::shared_ptr<SLE>>>>;
     static
     void
     threadItem (TxMeta& meta,
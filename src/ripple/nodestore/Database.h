@@ -37,6 +37,9 @@ public:
     std::shared_ptr<NodeObject>
     fetch(uint256 const& hash, std::uint32_t seq) = 0;
     virtual
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch(std::vector<uint256> const& hashes, std::uint32_t seq) = 0;
+    virtual
     bool
     asyncFetch(uint256 const& hash, std::uint32_t seq,
         std::shared_ptr<NodeObject>& object) = 0;
@@ -48,6 +51,8 @@ public:
     virtual
     int
     getDesiredAsyncReadCount(std::uint32_t seq) = 0;
+    std::size_t
+    getAsyncReadCount() const { return asyncReads_; }
     virtual
     float
     getCacheHitRate() = 0;
@@ -67,6 +72,10 @@ public:
     getStoreSize() const { return storeSz_; }
     std::uint32_t
     getFetchSize() const { return fetchSz_; }
+    std::uint32_t
+    getHotFetchTotalCount() const { return hotFetchTotalCount_; }
+    std::uint32_t
+    getHotFetchHitCount() const { return hotFetchHitCount_; }
     int
     fdlimit() const { return fdLimit_; }
     void
@@ -89,17 +98,35 @@ protected:
         storeSz_ += sz;
     }
     void
+    hotFetchStats(std::shared_ptr<NodeObject> const& nObj)
+    {
+        ++hotFetchTotalCount_;
+        if (nObj)
+        {
+            ++hotFetchHitCount_;
+            ++fetchHitCount_;
+            fetchSz_ += nObj->getData().size();
+        }
+    }
+    void
     asyncFetch(uint256 const& hash, std::uint32_t seq,
         std::shared_ptr<TaggedCache<uint256, NodeObject>> const& pCache,
             std::shared_ptr<KeyCache<uint256>> const& nCache);
     std::shared_ptr<NodeObject>
     fetchInternal(uint256 const& hash, Backend& srcBackend);
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatchInternal(std::vector<uint256> const& hashes,
+        Backend& srcBackend);
     void
     importInternal(Backend& dstBackend, Database& srcDB);
     std::shared_ptr<NodeObject>
     doFetch(uint256 const& hash, std::uint32_t seq,
         TaggedCache<uint256, NodeObject>& pCache,
             KeyCache<uint256>& nCache, bool isAsync);
+    std::vector<std::shared_ptr<NodeObject>>
+    doFetchBatch(std::vector<uint256> const& hashes, std::uint32_t seq,
+        TaggedCache<uint256, NodeObject>& pCache,
+            KeyCache<uint256>& nCache, bool isAsync);
     bool
     copyLedger(Backend& dstBackend, Ledger const& srcLedger,
         std::shared_ptr<TaggedCache<uint256, NodeObject>> const& pCache,
@@ -111,6 +138,8 @@ private:
     std::atomic<std::uint32_t> fetchHitCount_ {0};
     std::atomic<std::uint32_t> storeSz_ {0};
     std::atomic<std::uint32_t> fetchSz_ {0};
+    std::atomic<std::uint32_t> hotFetchTotalCount_ {0};
+    std::atomic<std::uint32_t> hotFetchHitCount_ {0};
     std::mutex readLock_;
     std::condition_variable readCondVar_;
     std::condition_variable readGenCondVar_;
@@ -118,6 +147,8 @@ private:
         std::weak_ptr<TaggedCache<uint256, NodeObject>>,
             std::weak_ptr<KeyCache<uint256>>>> read_;
     uint256 readLastHash_;
+    std::size_t readInFlight_ {0};
+    std::atomic<std::size_t> asyncReads_ {0};
     std::vector<std::thread> readThreads_;
     bool readShut_ {false};
     uint64_t readGen_ {0};
@@ -126,6 +157,9 @@ private:
     std::shared_ptr<NodeObject>
     fetchFrom(uint256 const& hash, std::uint32_t seq) = 0;
     virtual
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatchFrom(std::vector<uint256> const& hashes, std::uint32_t seq);
+    virtual
     void
     for_each(std::function <void(std::shared_ptr<NodeObject>)> f) = 0;
     void
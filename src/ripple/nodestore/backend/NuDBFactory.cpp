@@ -5,18 +5,32 @@
 #include <ripple/nodestore/impl/codec.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/nodestore/impl/Tuning.h>
+#include <ripple/nodestore/impl/ZstdCodec.h>
 #include <nudb/nudb.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdint>
 #include <exception>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 namespace ripple {
 namespace NodeStore {
 class NuDBBackend
     : public Backend
+    , public Task
 {
 public:
     static constexpr std::size_t currentType = 1;
@@ -26,6 +40,12 @@ public:
     nudb::store db_;
     std::atomic <bool> deletePath_;
     Scheduler& scheduler_;
+    bool const useZstd_;
+    ZstdCodec zstd_;
+    std::mutex trainMutex_;
+    std::condition_variable trainCond_;
+    std::vector<std::pair<ZstdCodec::Dictionary, std::vector<Blob>>> untrained_;
+    bool training_ = false;
     NuDBBackend (
         size_t keyBytes,
         Section const& keyValues,
@@ -36,6 +56,8 @@ public:
         , name_ (get<std::string>(keyValues, "path"))
         , deletePath_(false)
         , scheduler_ (scheduler)
+        , useZstd_ (useZstd (keyValues))
+        , zstd_ (get<int>(keyValues, "zstd_level", zstdDefaultLevel))
     {
         if (name_.empty())
             Throw<std::runtime_error> (
@@ -53,6 +75,8 @@ public:
         , db_ (context)
         , deletePath_(false)
         , scheduler_ (scheduler)
+        , useZstd_ (useZstd (keyValues))
+        , zstd_ (get<int>(keyValues, "zstd_level", zstdDefaultLevel))
     {
         if (name_.empty())
             Throw<std::runtime_error> (
@@ -62,6 +86,86 @@ public:
     {
         close();
     }
+    static
+    bool
+    useZstd (Section const& keyValues)
+    {
+        auto const compression =
+            get<std::string>(keyValues, "compression", "lz4");
+        if (boost::iequals (compression, "zstd"))
+            return true;
+        if (! boost::iequals (compression, "lz4"))
+            Throw<std::runtime_error> (
+                "nodestore: unknown compression " + compression);
+        return false;
+    }
+    std::string
+    dictionaryPath (ZstdCodec::Dictionary d) const
+    {
+        return (boost::filesystem::path (name_) / ("zstd." +
+            std::to_string (static_cast<int>(d)) + ".dict")).string();
+    }
+    void
+    loadDictionaries ()
+    {
+        for (auto const d : {ZstdCodec::Dictionary::accountState,
+            ZstdCodec::Dictionary::transaction})
+        {
+            if (zstd_.hasDictionary (d))
+                continue;
+            std::ifstream ifs (dictionaryPath (d), std::ios::binary);
+            if (! ifs)
+                continue;
+            Blob const dict {std::istreambuf_iterator<char>(ifs),
+                std::istreambuf_iterator<char>()};
+            if (dict.empty())
+                Throw<std::runtime_error> (
+                    "nodestore: empty zstd dictionary " + dictionaryPath (d));
+            zstd_.setDictionary (d, dict);
+        }
+    }
+    static
+    void
+    syncDirectory (std::string const& path)
+    {
+#ifndef _MSC_VER
+        auto const fd = ::open (path.c_str(), O_RDONLY);
+        if (fd == -1)
+            Throw<std::runtime_error> (
+                "nodestore: unable to open directory " + path);
+        auto const result = ::fsync (fd);
+        ::close (fd);
+        if (result != 0)
+            Throw<std::runtime_error> (
+                "nodestore: unable to sync directory " + path);
+#endif
+    }
+    void
+    saveDictionary (ZstdCodec::Dictionary d, Blob const& dict)
+    {
+        auto const path = dictionaryPath (d);
+        auto const temp = path + ".tmp";
+        boost::filesystem::remove (temp);
+        {
+            nudb::error_code ec;
+            nudb::native_file f;
+            f.create (nudb::file_mode::write, temp, ec);
+            if (! ec)
+                f.write (0, dict.data(), dict.size(), ec);
+            if (! ec)
+                f.sync (ec);
+            if (ec)
+                Throw<std::runtime_error> (
+                    "nodestore: unable to write zstd dictionary " + temp +
+                        ": " + ec.message());
+        }
+        boost::filesystem::rename (temp, path);
+        syncDirectory (name_);
+        zstd_.setDictionary (d, dict);
+        JLOG(j_.info()) <<
+            "trained zstd dictionary " << path <<
+            " (" << dict.size() << " bytes)";
+    }
     std::string
     getName() override
     {
@@ -100,10 +204,12 @@ public:
         if (db_.appnum() != currentType)
             Throw<std::runtime_error>(
                 "nodestore: unknown appnum");
+        loadDictionaries ();
     }
     void
     close() override
     {
+        waitForTraining ();
         if (db_.is_open())
         {
             nudb::error_code ec;
@@ -123,11 +229,11 @@ public:
         pno->reset();
         nudb::error_code ec;
         db_.fetch (key,
-            [key, pno, &status](void const* data, std::size_t size)
+            [this, key, pno, &status](void const* data, std::size_t size)
             {
                 nudb::detail::buffer bf;
                 auto const result =
-                    nodeobject_decompress(data, size, bf);
+                    nodeobject_decompress(data, size, bf, &zstd_);
                 DecodedBlob decoded (key, result.first, result.second);
                 if (! decoded.wasOk ())
                 {
@@ -146,28 +252,121 @@ public:
     bool
     canFetchBatch() override
     {
-        return false;
+        return true;
     }
     std::vector<std::shared_ptr<NodeObject>>
     fetchBatch (std::size_t n, void const* const* keys) override
     {
-        Throw<std::runtime_error> ("pure virtual called");
-        return {};
+        std::vector<std::shared_ptr<NodeObject>> results;
+        results.reserve (n);
+        nudb::detail::buffer bf;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto const key = keys[i];
+            std::shared_ptr<NodeObject> no;
+            nudb::error_code ec;
+            db_.fetch (key,
+                [this, key, &no, &bf](void const* data, std::size_t size)
+                {
+                    auto const result =
+                        nodeobject_decompress(data, size, bf, &zstd_);
+                    DecodedBlob decoded (key, result.first, result.second);
+                    if (! decoded.wasOk ())
+                    {
+                        JLOG(j_.fatal()) <<
+                            "Corrupt NodeObject #" << uint256::fromVoid (key);
+                        return;
+                    }
+                    no = decoded.createObject();
+                }, ec);
+            if(ec && ec != nudb::error::key_not_found)
+                Throw<nudb::system_error>(ec);
+            results.push_back (std::move (no));
+        }
+        return results;
     }
     void
     do_insert (std::shared_ptr <NodeObject> const& no)
     {
         EncodedBlob e;
         e.prepare (no);
+        if (useZstd_)
+        {
+            auto const d = ZstdCodec::classify (e.getData(), e.getSize());
+            if (d != ZstdCodec::Dictionary::none && ! zstd_.hasDictionary (d))
+            {
+                auto samples = zstd_.sample (d, e.getData(), e.getSize());
+                if (! samples.empty())
+                    scheduleTraining (d, std::move (samples));
+            }
+        }
         nudb::error_code ec;
         nudb::detail::buffer bf;
         auto const result = nodeobject_compress(
-            e.getData(), e.getSize(), bf);
+            e.getData(), e.getSize(), bf, useZstd_ ? &zstd_ : nullptr);
         db_.insert (e.getKey(), result.first, result.second, ec);
         if(ec && ec != nudb::error::key_exists)
             Throw<nudb::system_error>(ec);
     }
     void
+    scheduleTraining (ZstdCodec::Dictionary d, std::vector<Blob> samples)
+    {
+        {
+            std::lock_guard<std::mutex> lock (trainMutex_);
+            untrained_.emplace_back (d, std::move (samples));
+            if (training_)
+                return;
+            training_ = true;
+        }
+        scheduler_.scheduleTask (*this);
+    }
+    void
+    performScheduledTask () override
+    {
+        for (;;)
+        {
+            decltype(untrained_) work;
+            {
+                std::lock_guard<std::mutex> lock (trainMutex_);
+                work.swap (untrained_);
+                if (work.empty ())
+                {
+                    training_ = false;
+                    trainCond_.notify_all ();
+                    return;
+                }
+            }
+            for (auto const& w : work)
+            {
+                auto const dict = ZstdCodec::train (
+                    w.second, zstdDictionarySize);
+                if (dict.empty ())
+                {
+                    JLOG(j_.warn()) <<
+                        "unable to train zstd dictionary " <<
+                            dictionaryPath (w.first);
+                    zstd_.resetSampling (w.first);
+                    continue;
+                }
+                try
+                {
+                    saveDictionary (w.first, dict);
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(j_.error()) << e.what();
+                    zstd_.resetSampling (w.first);
+                }
+            }
+        }
+    }
+    void
+    waitForTraining ()
+    {
+        std::unique_lock<std::mutex> lock (trainMutex_);
+        trainCond_.wait (lock, [this]{ return ! training_; });
+    }
+    void
     store (std::shared_ptr <NodeObject> const& no) override
     {
         BatchWriteReport report;
@@ -212,7 +411,7 @@ public:
             {
                 nudb::detail::buffer bf;
                 auto const result =
-                    nodeobject_decompress(data, size, bf);
+                    nodeobject_decompress(data, size, bf, &zstd_);
                 DecodedBlob decoded (key, result.first, result.second);
                 if (! decoded.wasOk ())
                 {
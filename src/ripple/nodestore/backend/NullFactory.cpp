@@ -31,13 +31,12 @@ public:
     bool
     canFetchBatch() override
     {
-        return false;
+        return true;
     }
     std::vector<std::shared_ptr<NodeObject>>
-    fetchBatch (std::size_t n, void const* const* keys) override
+    fetchBatch (std::size_t n, void const* const*) override
     {
-        Throw<std::runtime_error> ("pure virtual called");
-        return {};
+        return std::vector<std::shared_ptr<NodeObject>> (n);
     }
     void
     store (std::shared_ptr<NodeObject> const& object) override
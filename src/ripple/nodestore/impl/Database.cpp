@@ -36,7 +36,8 @@ Database::waitReads()
 {
     std::unique_lock<std::mutex> lock(readLock_);
     std::uint64_t const wakeGen = readGen_ + 2;
-    while (! readShut_ && ! read_.empty() && (readGen_ < wakeGen))
+    while (! readShut_ && (! read_.empty() || readInFlight_ != 0) &&
+        (readGen_ < wakeGen))
         readGenCondVar_.wait(lock);
 }
 void
@@ -66,7 +67,10 @@ Database::asyncFetch(uint256 const& hash, std::uint32_t seq,
 {
     std::lock_guard <std::mutex> lock(readLock_);
     if (read_.emplace(hash, std::make_tuple(seq, pCache, nCache)).second)
+    {
+        ++asyncReads_;
         readCondVar_.notify_one();
+    }
 }
 std::shared_ptr<NodeObject>
 Database::fetchInternal(uint256 const& hash, Backend& srcBackend)
@@ -103,6 +107,43 @@ Database::fetchInternal(uint256 const& hash, Backend& srcBackend)
     }
     return nObj;
 }
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchBatchInternal(std::vector<uint256> const& hashes,
+    Backend& srcBackend)
+{
+    std::vector<std::shared_ptr<NodeObject>> results;
+    if (! srcBackend.canFetchBatch())
+    {
+        results.reserve(hashes.size());
+        for (auto const& hash : hashes)
+            results.push_back(fetchInternal(hash, srcBackend));
+        return results;
+    }
+    std::vector<void const*> keys;
+    keys.reserve(hashes.size());
+    for (auto const& hash : hashes)
+        keys.push_back(hash.begin());
+    try
+    {
+        results = srcBackend.fetchBatch(keys.size(), keys.data());
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) <<
+            "Exception, " << e.what();
+        Rethrow();
+    }
+    assert(results.size() == hashes.size());
+    for (auto const& nObj : results)
+    {
+        if (nObj)
+        {
+            ++fetchHitCount_;
+            fetchSz_ += nObj->getData().size();
+        }
+    }
+    return results;
+}
 void
 Database::importInternal(Backend& dstBackend, Database& srcDB)
 {
@@ -162,6 +203,70 @@ Database::doFetch(uint256 const& hash, std::uint32_t seq,
     scheduler_.onFetch(report);
     return nObj;
 }
+std::vector<std::shared_ptr<NodeObject>>
+Database::doFetchBatch(std::vector<uint256> const& hashes, std::uint32_t seq,
+    TaggedCache<uint256, NodeObject>& pCache,
+        KeyCache<uint256>& nCache, bool isAsync)
+{
+    using namespace std::chrono;
+    auto const before = steady_clock::now();
+    std::vector<std::shared_ptr<NodeObject>> results(hashes.size());
+    std::vector<uint256> missing;
+    std::vector<std::size_t> index;
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        results[i] = pCache.fetch(hashes[i]);
+        if (! results[i] && ! nCache.touch_if_exists(hashes[i]))
+        {
+            missing.push_back(hashes[i]);
+            index.push_back(i);
+        }
+    }
+    if (! missing.empty())
+    {
+        auto fetched = fetchBatchFrom(missing, seq);
+        fetchTotalCount_ += missing.size();
+        for (std::size_t i = 0; i < missing.size(); ++i)
+        {
+            auto& nObj = fetched[i];
+            if (! nObj)
+            {
+                nObj = pCache.fetch(missing[i]);
+                if (! nObj)
+                    nCache.insert(missing[i]);
+            }
+            else
+            {
+                pCache.canonicalize(missing[i], nObj);
+            }
+            results[index[i]] = std::move(nObj);
+        }
+    }
+    FetchReport report;
+    report.isAsync = isAsync;
+    report.elapsed = duration_cast<milliseconds>(
+        steady_clock::now() - before);
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        report.wentToDisk = next < index.size() && index[next] == i;
+        if (report.wentToDisk)
+            ++next;
+        report.wasFound = static_cast<bool>(results[i]);
+        scheduler_.onFetch(report);
+    }
+    return results;
+}
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchBatchFrom(std::vector<uint256> const& hashes,
+    std::uint32_t seq)
+{
+    std::vector<std::shared_ptr<NodeObject>> results;
+    results.reserve(hashes.size());
+    for (auto const& hash : hashes)
+        results.push_back(fetchFrom(hash, seq));
+    return results;
+}
 bool
 Database::copyLedger(Backend& dstBackend, Ledger const& srcLedger,
     std::shared_ptr<TaggedCache<uint256, NodeObject>> const& pCache,
@@ -277,12 +382,13 @@ void
 Database::threadEntry()
 {
     beast::setCurrentThreadName("prefetch");
+    std::vector<uint256> batch;
     while (true)
     {
-        uint256 lastHash;
         std::uint32_t lastSeq;
         std::shared_ptr<TaggedCache<uint256, NodeObject>> lastPcache;
         std::shared_ptr<KeyCache<uint256>> lastNcache;
+        batch.clear();
         {
             std::unique_lock<std::mutex> lock(readLock_);
             while (! readShut_ && read_.empty())
@@ -299,15 +405,36 @@ Database::threadEntry()
                 ++readGen_;
                 readGenCondVar_.notify_all();
             }
-            lastHash = it->first;
             lastSeq = std::get<0>(it->second);
             lastPcache = std::get<1>(it->second).lock();
             lastNcache = std::get<2>(it->second).lock();
-            read_.erase(it);
-            readLastHash_ = lastHash;
+            auto const limit = std::min<std::size_t>(readBatchSize,
+                (read_.size() + readThreads_.size() - 1) /
+                    readThreads_.size());
+            do
+            {
+                batch.push_back(it->first);
+                it = read_.erase(it);
+            }
+            while (it != read_.end() && batch.size() < limit &&
+                std::get<1>(it->second).lock() == lastPcache);
+            readLastHash_ = batch.back();
+            readInFlight_ += batch.size();
+        }
+        if (lastPcache && lastNcache)
+        {
+            if (batch.size() == 1)
+                doFetch(batch.front(), lastSeq,
+                    *lastPcache, *lastNcache, true);
+            else
+                doFetchBatch(batch, lastSeq,
+                    *lastPcache, *lastNcache, true);
         }
-        if (lastPcache && lastPcache)
-            doFetch(lastHash, lastSeq, *lastPcache, *lastNcache, true);
+        std::lock_guard<std::mutex> lock(readLock_);
+        readInFlight_ -= batch.size();
+        asyncReads_ -= batch.size();
+        if (readInFlight_ == 0 && read_.empty())
+            readGenCondVar_.notify_all();
     }
 }
 } 
@@ -1,7 +1,9 @@
 
 #include <ripple/nodestore/impl/DatabaseNodeImp.h>
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/contract.h>
 #include <ripple/protocol/HashPrefix.h>
+#include <boost/filesystem.hpp>
 namespace ripple {
 namespace NodeStore {
 void
@@ -14,6 +16,8 @@ DatabaseNodeImp::store(NodeObjectType type, Blob&& data,
     auto nObj = NodeObject::createObject(type, std::move(data), hash);
     pCache_->canonicalize(hash, nObj, true);
     backend_->store(nObj);
+    if (hotCache_)
+        hotCache_->insert(nObj);
     nCache_->erase(hash);
     storeStats(nObj->getData().size());
 }
@@ -28,6 +32,69 @@ DatabaseNodeImp::asyncFetch(uint256 const& hash,
     return false;
 }
 void
+DatabaseNodeImp::openHotCache(Section const& config)
+{
+    auto const mb = get<std::uint64_t>(config, "hot_cache_mb", 0);
+    if (mb == 0)
+        return;
+    std::string path;
+    if (! get_if_exists(config, "hot_cache_path", path))
+    {
+        path = get<std::string>(config, "path");
+        if (path.empty())
+            Throw<std::runtime_error>(
+                "nodestore: hot_cache_mb requires a path");
+        path = (boost::filesystem::path(path) / "hotcache.dat").string();
+    }
+    hotCache_ = std::make_unique<HotCache>(path, mb << 20, j_);
+}
+std::shared_ptr<NodeObject>
+DatabaseNodeImp::fetchFrom(uint256 const& hash, std::uint32_t seq)
+{
+    if (! hotCache_)
+        return fetchInternal(hash, *backend_);
+    auto nObj = hotCache_->fetch(hash);
+    hotFetchStats(nObj);
+    if (nObj)
+        return nObj;
+    nObj = fetchInternal(hash, *backend_);
+    if (nObj)
+        hotCache_->insert(nObj);
+    return nObj;
+}
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchBatchFrom(std::vector<uint256> const& hashes,
+    std::uint32_t seq)
+{
+    if (! hotCache_)
+        return fetchBatchInternal(hashes, *backend_);
+    std::vector<std::shared_ptr<NodeObject>> results(hashes.size());
+    std::vector<uint256> missing;
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        results[i] = hotCache_->fetch(hashes[i]);
+        hotFetchStats(results[i]);
+        if (! results[i])
+        {
+            missing.push_back(hashes[i]);
+            positions.push_back(i);
+        }
+    }
+    if (missing.empty())
+        return results;
+    auto fetched = fetchBatchInternal(missing, *backend_);
+    for (std::size_t i = 0; i < missing.size(); ++i)
+    {
+        if (fetched[i])
+        {
+            hotCache_->insert(fetched[i]);
+            results[positions[i]] = std::move(fetched[i]);
+        }
+    }
+    return results;
+}
+void
 DatabaseNodeImp::tune(int size, std::chrono::seconds age)
 {
     pCache_->setTargetSize(size);
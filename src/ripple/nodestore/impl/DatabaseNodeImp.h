@@ -1,6 +1,7 @@
 #ifndef RIPPLE_NODESTORE_DATABASENODEIMP_H_INCLUDED
 #define RIPPLE_NODESTORE_DATABASENODEIMP_H_INCLUDED
 #include <ripple/nodestore/Database.h>
+#include <ripple/nodestore/impl/HotCache.h>
 #include <ripple/basics/chrono.h>
 namespace ripple {
 namespace NodeStore {
@@ -20,12 +21,14 @@ public:
         beast::Journal j)
         : Database(name, parent, scheduler, readThreads, config, j)
         , pCache_(std::make_shared<TaggedCache<uint256, NodeObject>>(
-            name, cacheTargetSize, cacheTargetAge, stopwatch(), j))
+            name, cacheTargetSize, cacheTargetAge, stopwatch(), j,
+                beast::insight::NullCollector::New(), cachePartitions))
         , nCache_(std::make_shared<KeyCache<uint256>>(
             name, stopwatch(), cacheTargetSize, cacheTargetAge))
         , backend_(std::move(backend))
     {
         assert(backend_);
+        openHotCache(config);
     }
     ~DatabaseNodeImp() override
     {
@@ -54,6 +57,12 @@ public:
     {
         return doFetch(hash, seq, *pCache_, *nCache_, false);
     }
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch(std::vector<uint256> const& hashes,
+        std::uint32_t seq) override
+    {
+        return doFetchBatch(hashes, seq, *pCache_, *nCache_, false);
+    }
     bool
     asyncFetch(uint256 const& hash, std::uint32_t seq,
         std::shared_ptr<NodeObject>& object) override;
@@ -78,11 +87,14 @@ private:
     std::shared_ptr<TaggedCache<uint256, NodeObject>> pCache_;
     std::shared_ptr<KeyCache<uint256>> nCache_;
     std::unique_ptr<Backend> backend_;
+    std::unique_ptr<HotCache> hotCache_;
+    void
+    openHotCache(Section const& config);
     std::shared_ptr<NodeObject>
-    fetchFrom(uint256 const& hash, std::uint32_t seq) override
-    {
-        return fetchInternal(hash, *backend_);
-    }
+    fetchFrom(uint256 const& hash, std::uint32_t seq) override;
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatchFrom(std::vector<uint256> const& hashes,
+        std::uint32_t seq) override;
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
     {
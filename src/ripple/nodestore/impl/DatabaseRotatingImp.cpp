@@ -15,7 +15,8 @@ DatabaseRotatingImp::DatabaseRotatingImp(
     beast::Journal j)
     : DatabaseRotating(name, parent, scheduler, readThreads, config, j)
     , pCache_(std::make_shared<TaggedCache<uint256, NodeObject>>(
-        name, cacheTargetSize, cacheTargetAge, stopwatch(), j))
+        name, cacheTargetSize, cacheTargetAge, stopwatch(), j,
+            beast::insight::NullCollector::New(), cachePartitions))
     , nCache_(std::make_shared<KeyCache<uint256>>(
         name, stopwatch(), cacheTargetSize, cacheTargetAge))
     , writableBackend_(std::move(writableBackend))
@@ -88,5 +89,35 @@ DatabaseRotatingImp::fetchFrom(uint256 const& hash, std::uint32_t seq)
     }
     return nObj;
 }
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseRotatingImp::fetchBatchFrom(
+    std::vector<uint256> const& hashes, std::uint32_t seq)
+{
+    Backends b = getBackends();
+    auto results = fetchBatchInternal(hashes, *b.writableBackend);
+    std::vector<uint256> missing;
+    std::vector<std::size_t> index;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (! results[i])
+        {
+            missing.push_back(hashes[i]);
+            index.push_back(i);
+        }
+    }
+    if (missing.empty())
+        return results;
+    auto archived = fetchBatchInternal(missing, *b.archiveBackend);
+    for (std::size_t i = 0; i < archived.size(); ++i)
+    {
+        if (archived[i])
+        {
+            getWritableBackend()->store(archived[i]);
+            nCache_->erase(missing[i]);
+            results[index[i]] = std::move(archived[i]);
+        }
+    }
+    return results;
+}
 } 
 } 
@@ -53,6 +53,12 @@ public:
     {
         return doFetch(hash, seq, *pCache_, *nCache_, false);
     }
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch(std::vector<uint256> const& hashes,
+        std::uint32_t seq) override
+    {
+        return doFetchBatch(hashes, seq, *pCache_, *nCache_, false);
+    }
     bool
     asyncFetch(uint256 const& hash, std::uint32_t seq,
         std::shared_ptr<NodeObject>& object) override;
@@ -92,6 +98,8 @@ private:
     }
     std::shared_ptr<NodeObject> fetchFrom(
         uint256 const& hash, std::uint32_t seq) override;
+    std::vector<std::shared_ptr<NodeObject>> fetchBatchFrom(
+        std::vector<uint256> const& hashes, std::uint32_t seq) override;
     void
     for_each(std::function <void(std::shared_ptr<NodeObject>)> f) override
     {
@@ -742,6 +742,18 @@ DatabaseShardImp::fetch(uint256 const& hash, std::uint32_t seq)
         return doFetch(hash, seq, *cache.first, *cache.second, false);
     return {};
 }
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseShardImp::fetchBatch(std::vector<uint256> const& hashes,
+    std::uint32_t seq)
+{
+    auto cache {selectCache(seq)};
+    if (cache.first)
+    {
+        return doFetchBatch(hashes, seq,
+            *cache.first, *cache.second, false);
+    }
+    return std::vector<std::shared_ptr<NodeObject>>(hashes.size());
+}
 bool
 DatabaseShardImp::asyncFetch(uint256 const& hash,
     std::uint32_t seq, std::shared_ptr<NodeObject>& object)
@@ -895,6 +907,34 @@ DatabaseShardImp::fetchFrom(uint256 const& hash, std::uint32_t seq)
     }
     return {};
 }
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseShardImp::fetchBatchFrom(std::vector<uint256> const& hashes,
+    std::uint32_t seq)
+{
+    auto const shardIndex {seqToShardIndex(seq)};
+    std::unique_lock<std::mutex> lock(m_);
+    assert(init_);
+    {
+        auto it = complete_.find(shardIndex);
+        if (it != complete_.end())
+        {
+            lock.unlock();
+            return fetchBatchInternal(hashes, *it->second->getBackend());
+        }
+    }
+    if (incomplete_ && incomplete_->index() == shardIndex)
+    {
+        lock.unlock();
+        return fetchBatchInternal(hashes, *incomplete_->getBackend());
+    }
+    auto it = preShards_.find(shardIndex);
+    if (it != preShards_.end() && it->second)
+    {
+        lock.unlock();
+        return fetchBatchInternal(hashes, *it->second->getBackend());
+    }
+    return std::vector<std::shared_ptr<NodeObject>>(hashes.size());
+}
 boost::optional<std::uint32_t>
 DatabaseShardImp::findShardIndexToAdd(
     std::uint32_t validLedgerSeq, std::lock_guard<std::mutex>&)
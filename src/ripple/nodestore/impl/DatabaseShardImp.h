@@ -93,6 +93,9 @@ public:
         uint256 const& hash, std::uint32_t seq) override;
     std::shared_ptr<NodeObject>
     fetch(uint256 const& hash, std::uint32_t seq) override;
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch(std::vector<uint256> const& hashes,
+        std::uint32_t seq) override;
     bool
     asyncFetch(uint256 const& hash, std::uint32_t seq,
         std::shared_ptr<NodeObject>& object) override;
@@ -130,6 +133,9 @@ private:
     static constexpr auto importMarker_ = "import";
     std::shared_ptr<NodeObject>
     fetchFrom(uint256 const& hash, std::uint32_t seq) override;
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatchFrom(std::vector<uint256> const& hashes,
+        std::uint32_t seq) override;
     void
     for_each(std::function <void(std::shared_ptr<NodeObject>)> f) override
     {
@@ -0,0 +1,285 @@
+#include <ripple/nodestore/impl/HotCache.h>
+#include <ripple/basics/contract.h>
+#include <ripple/basics/Log.h>
+#include <ripple/beast/hash/xxhasher.h>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+namespace ripple {
+namespace NodeStore {
+struct HotCache::Header
+{
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t keyBytes;
+    std::uint64_t capacity;
+    std::uint64_t head;
+    std::uint64_t tail;
+    std::uint64_t used;
+};
+static std::uint64_t constexpr fileMagic = 0x31454843544f4852;
+static std::uint32_t constexpr fileVersion = 1;
+static std::uint32_t constexpr recordMagic = 0x524f5448;
+static std::uint32_t constexpr padMagic = 0x44415048;
+static
+std::uint64_t
+checksum (std::uint8_t type, void const* key,
+    void const* data, std::size_t size)
+{
+    beast::xxhasher h;
+    h (&type, 1);
+    h (key, 32);
+    h (data, size);
+    return static_cast<std::size_t>(h);
+}
+HotCache::HotCache (std::string const& path,
+    std::uint64_t capacity, beast::Journal j)
+    : path_ (path)
+    , capacity_ (((capacity + 7) / 8) * 8)
+    , j_ (j)
+{
+    using namespace boost::filesystem;
+    using namespace boost::interprocess;
+    if (capacity_ < 64 * recordHeaderBytes)
+        Throw<std::runtime_error> (
+            "nodestore: hot cache capacity too small");
+    auto const fileSize = headerBytes + capacity_;
+    bool fresh = false;
+    if (! exists (path_) || file_size (path_) != fileSize)
+    {
+        auto const parent = boost::filesystem::path (path_).parent_path ();
+        if (! parent.empty ())
+            create_directories (parent);
+        std::ofstream ofs (path_, std::ios::binary | std::ios::trunc);
+        if (! ofs)
+            Throw<std::runtime_error> (
+                "nodestore: unable to create hot cache " + path_);
+        ofs.close ();
+        resize_file (path_, fileSize);
+        fresh = true;
+    }
+    file_ = file_mapping (path_.c_str (), read_write);
+    region_ = mapped_region (file_, read_write);
+    header_ = static_cast<Header*>(region_.get_address ());
+    data_ = static_cast<std::uint8_t*>(region_.get_address ()) + headerBytes;
+    auto& h = *header_;
+    if (! fresh && h.magic == fileMagic && h.version == fileVersion &&
+        h.keyBytes == 32 && h.capacity == capacity_ &&
+        h.head < capacity_ && h.tail < capacity_ && h.used <= capacity_)
+    {
+        auto const n = load ();
+        JLOG(j_.info()) <<
+            "hot cache " << path_ << ": " << n << " objects, " <<
+            h.used << " of " << capacity_ << " bytes";
+        return;
+    }
+    std::memset (&h, 0, sizeof (h));
+    h.magic = fileMagic;
+    h.version = fileVersion;
+    h.keyBytes = 32;
+    h.capacity = capacity_;
+}
+HotCache::~HotCache ()
+{
+    try
+    {
+        flush ();
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "hot cache " << path_ << ": " << e.what ();
+    }
+}
+std::shared_ptr<NodeObject>
+HotCache::fetch (uint256 const& hash)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const it = index_.find (hash);
+    if (it == index_.end ())
+    {
+        ++misses_;
+        return {};
+    }
+    auto const offset = it->second;
+    auto const p = data_ + offset;
+    std::uint32_t size;
+    std::memcpy (&size, p + 4, 4);
+    auto const type = static_cast<NodeObjectType>(p[8]);
+    Blob data (p + recordHeaderBytes, p + recordHeaderBytes + size);
+    ++hits_;
+    auto const& h = *header_;
+    auto const age = offset >= h.tail ?
+        offset - h.tail : capacity_ - h.tail + offset;
+    if (age < h.used / 4)
+    {
+        index_.erase (it);
+        append (type, hash, data);
+    }
+    return NodeObject::createObject (type, std::move (data), hash);
+}
+void
+HotCache::insert (std::shared_ptr<NodeObject> const& object)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (index_.count (object->getHash ()) == 0)
+        append (object->getType (), object->getHash (), object->getData ());
+}
+std::size_t
+HotCache::size () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return index_.size ();
+}
+std::uint64_t
+HotCache::bytes () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return header_->used;
+}
+void
+HotCache::flush ()
+{
+    region_.flush ();
+}
+std::uint64_t
+HotCache::recordSize (std::size_t dataSize)
+{
+    return ((recordHeaderBytes + dataSize + 7) / 8) * 8;
+}
+std::uint64_t
+HotCache::contiguous () const
+{
+    auto const& h = *header_;
+    if (h.used == 0)
+        return capacity_ - h.head;
+    if (h.tail > h.head)
+        return h.tail - h.head;
+    if (h.tail < h.head)
+        return capacity_ - h.head;
+    return 0;
+}
+void
+HotCache::evict ()
+{
+    auto& h = *header_;
+    auto const p = data_ + h.tail;
+    std::uint32_t magic = padMagic;
+    if (capacity_ - h.tail >= recordHeaderBytes)
+        std::memcpy (&magic, p, 4);
+    if (magic != recordMagic)
+    {
+        h.used -= capacity_ - h.tail;
+        h.tail = 0;
+    }
+    else
+    {
+        std::uint32_t size;
+        std::memcpy (&size, p + 4, 4);
+        auto const it = index_.find (uint256::fromVoid (p + 16));
+        if (it != index_.end () && it->second == h.tail)
+            index_.erase (it);
+        auto const n = recordSize (size);
+        h.tail += n;
+        h.used -= n;
+        if (h.tail == capacity_)
+            h.tail = 0;
+    }
+    if (h.used == 0)
+        h.head = h.tail = 0;
+}
+void
+HotCache::append (NodeObjectType type, uint256 const& hash,
+    Blob const& data)
+{
+    auto const n = recordSize (data.size ());
+    if (n > capacity_ / 4)
+        return;
+    auto& h = *header_;
+    for (;;)
+    {
+        if (h.used == 0)
+            h.head = h.tail = 0;
+        if (contiguous () >= n)
+            break;
+        if (h.tail < h.head)
+        {
+            if (capacity_ - h.head >= recordHeaderBytes)
+                std::memcpy (data_ + h.head, &padMagic, 4);
+            h.used += capacity_ - h.head;
+            h.head = 0;
+        }
+        else
+        {
+            evict ();
+        }
+    }
+    auto const p = data_ + h.head;
+    std::uint32_t const size = static_cast<std::uint32_t>(data.size ());
+    auto const kind = static_cast<std::uint8_t>(type);
+    auto const sum = checksum (kind, hash.data (), data.data (), data.size ());
+    std::memset (p, 0, recordHeaderBytes);
+    std::memcpy (p + 4, &size, 4);
+    p[8] = kind;
+    std::memcpy (p + 16, hash.data (), 32);
+    std::memcpy (p + 48, &sum, 8);
+    if (! data.empty ())
+        std::memcpy (p + recordHeaderBytes, data.data (), data.size ());
+    std::memcpy (p, &recordMagic, 4);
+    index_[hash] = h.head;
+    h.head += n;
+    h.used += n;
+    if (h.head == capacity_)
+        h.head = 0;
+}
+std::size_t
+HotCache::load ()
+{
+    auto& h = *header_;
+    auto pos = h.tail;
+    auto remaining = h.used;
+    while (remaining > 0)
+    {
+        auto const p = data_ + pos;
+        std::uint32_t magic = padMagic;
+        if (capacity_ - pos >= recordHeaderBytes)
+            std::memcpy (&magic, p, 4);
+        if (magic == padMagic)
+        {
+            auto const skip = capacity_ - pos;
+            if (skip > remaining)
+                break;
+            remaining -= skip;
+            pos = 0;
+            continue;
+        }
+        if (magic != recordMagic)
+            break;
+        std::uint32_t size;
+        std::uint64_t sum;
+        std::memcpy (&size, p + 4, 4);
+        std::memcpy (&sum, p + 48, 8);
+        auto const n = recordSize (size);
+        if (n > remaining || n > capacity_ - pos ||
+            sum != checksum (p[8], p + 16, p + recordHeaderBytes, size))
+            break;
+        index_[uint256::fromVoid (p + 16)] = pos;
+        remaining -= n;
+        pos += n;
+        if (pos == capacity_)
+            pos = 0;
+    }
+    if (remaining > 0)
+    {
+        JLOG(j_.warn()) <<
+            "hot cache " << path_ << ": discarding " << remaining <<
+            " unreadable bytes";
+        h.used -= remaining;
+        h.head = pos;
+        if (h.used == 0)
+            h.head = h.tail = 0;
+    }
+    return index_.size ();
+}
+}
+}
@@ -0,0 +1,86 @@
+#ifndef RIPPLE_NODESTORE_HOTCACHE_H_INCLUDED
+#define RIPPLE_NODESTORE_HOTCACHE_H_INCLUDED
+#include <ripple/nodestore/NodeObject.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/utility/Journal.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+namespace ripple {
+namespace NodeStore {
+class HotCache
+{
+public:
+    static constexpr std::uint64_t headerBytes = 4096;
+    static constexpr std::uint64_t recordHeaderBytes = 56;
+private:
+    struct Header;
+    std::string const path_;
+    std::uint64_t const capacity_;
+    beast::Journal j_;
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    Header* header_;
+    std::uint8_t* data_;
+    std::mutex mutable mutex_;
+    hardened_hash_map<uint256, std::uint64_t> index_;
+    std::atomic<std::uint64_t> hits_ {0};
+    std::atomic<std::uint64_t> misses_ {0};
+public:
+    HotCache (HotCache const&) = delete;
+    HotCache& operator= (HotCache const&) = delete;
+    HotCache (std::string const& path,
+        std::uint64_t capacity, beast::Journal j);
+    ~HotCache ();
+    std::string const&
+    path () const
+    {
+        return path_;
+    }
+    std::uint64_t
+    capacity () const
+    {
+        return capacity_;
+    }
+    std::shared_ptr<NodeObject>
+    fetch (uint256 const& hash);
+    void
+    insert (std::shared_ptr<NodeObject> const& object);
+    std::size_t
+    size () const;
+    std::uint64_t
+    bytes () const;
+    std::uint64_t
+    getHits () const
+    {
+        return hits_;
+    }
+    std::uint64_t
+    getMisses () const
+    {
+        return misses_;
+    }
+    void
+    flush ();
+private:
+    static
+    std::uint64_t
+    recordSize (std::size_t dataSize);
+    std::uint64_t
+    contiguous () const;
+    void
+    evict ();
+    void
+    append (NodeObjectType type, uint256 const& hash,
+        Blob const& data);
+    std::size_t
+    load ();
+};
+}
+}
+#endif
@@ -15,7 +15,8 @@ Shard::Shard(DatabaseShard const& db, std::uint32_t index,
         lastSeq_ - firstSeq_ + 1 : db.ledgersPerShard())
     , pCache_(std::make_shared<PCache>(
         "shard " + std::to_string(index_),
-        cacheSz, cacheAge, stopwatch(), j))
+        cacheSz, cacheAge, stopwatch(), j,
+        beast::insight::NullCollector::New(), cachePartitions))
     , nCache_(std::make_shared<NCache>(
         "shard " + std::to_string(index_),
         stopwatch(), cacheSz, cacheAge))
@@ -1,11 +1,18 @@
 #ifndef RIPPLE_NODESTORE_TUNING_H_INCLUDED
 #define RIPPLE_NODESTORE_TUNING_H_INCLUDED
+#include <chrono>
 namespace ripple {
 namespace NodeStore {
 enum
 {
     cacheTargetSize     = 16384
     ,asyncDivider = 8
+    ,readBatchSize = 64
+    ,cachePartitions = 16
+    ,zstdDefaultLevel = 3
+    ,zstdTrainingSamples = 8192
+    ,zstdMaxTrainingSamples = 65536
+    ,zstdDictionarySize = 16384
 };
 std::chrono::seconds constexpr cacheTargetAge = std::chrono::minutes{5};
 auto constexpr shardCacheSz = 16384;
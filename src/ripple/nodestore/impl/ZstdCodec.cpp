@@ -0,0 +1,221 @@
+#include <ripple/nodestore/impl/ZstdCodec.h>
+#include <ripple/nodestore/impl/Tuning.h>
+#include <ripple/nodestore/NodeObject.h>
+#include <ripple/basics/contract.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <nudb/detail/field.hpp>
+#include <nudb/detail/stream.hpp>
+#include <zdict.h>
+#include <zstd.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+namespace ripple {
+namespace NodeStore {
+struct ZstdCodec::Entry
+{
+    Blob data;
+    ZSTD_CDict* cdict;
+    ZSTD_DDict* ddict;
+    Entry (Blob const& dict, int level)
+        : data (dict)
+        , cdict (ZSTD_createCDict (data.data(), data.size(), level))
+        , ddict (ZSTD_createDDict (data.data(), data.size()))
+    {
+        if (! cdict || ! ddict)
+        {
+            ZSTD_freeCDict (cdict);
+            ZSTD_freeDDict (ddict);
+            Throw<std::runtime_error> (
+                "zstd: unable to load dictionary");
+        }
+    }
+    ~Entry ()
+    {
+        ZSTD_freeCDict (cdict);
+        ZSTD_freeDDict (ddict);
+    }
+};
+static
+ZSTD_CCtx*
+compressContext ()
+{
+    struct Deleter
+    {
+        void operator() (ZSTD_CCtx* ctx) const
+        {
+            ZSTD_freeCCtx (ctx);
+        }
+    };
+    thread_local std::unique_ptr<ZSTD_CCtx, Deleter> ctx {ZSTD_createCCtx ()};
+    if (! ctx)
+        Throw<std::runtime_error> ("zstd compress: no context");
+    return ctx.get();
+}
+static
+ZSTD_DCtx*
+decompressContext ()
+{
+    struct Deleter
+    {
+        void operator() (ZSTD_DCtx* ctx) const
+        {
+            ZSTD_freeDCtx (ctx);
+        }
+    };
+    thread_local std::unique_ptr<ZSTD_DCtx, Deleter> ctx {ZSTD_createDCtx ()};
+    if (! ctx)
+        Throw<std::runtime_error> ("zstd decompress: no context");
+    return ctx.get();
+}
+ZstdCodec::ZstdCodec (int level)
+    : level_ (std::max (1, std::min (level, ZSTD_maxCLevel ())))
+{
+    for (auto& e : entries_)
+        e.store (nullptr);
+    sampling_.fill (true);
+    sampling_[static_cast<std::size_t>(Dictionary::none)] = false;
+    required_.fill (zstdTrainingSamples);
+}
+ZstdCodec::~ZstdCodec () = default;
+ZstdCodec::Dictionary
+ZstdCodec::classify (void const* blob, std::size_t size)
+{
+    using namespace nudb::detail;
+    if (size < 13)
+        return Dictionary::none;
+    istream is (blob, size);
+    std::uint32_t index;
+    std::uint32_t unused;
+    std::uint8_t kind;
+    std::uint32_t prefix;
+    read<std::uint32_t>(is, index);
+    read<std::uint32_t>(is, unused);
+    read<std::uint8_t> (is, kind);
+    read<std::uint32_t>(is, prefix);
+    if (kind == hotACCOUNT_NODE && prefix == HashPrefix::leafNode)
+        return Dictionary::accountState;
+    if (kind == hotTRANSACTION_NODE && prefix == HashPrefix::txNode)
+        return Dictionary::transaction;
+    return Dictionary::none;
+}
+bool
+ZstdCodec::hasDictionary (Dictionary d) const
+{
+    return entries_[static_cast<std::size_t>(d)].load () != nullptr;
+}
+Blob
+ZstdCodec::getDictionary (Dictionary d) const
+{
+    auto const e = entries_[static_cast<std::size_t>(d)].load ();
+    if (! e)
+        return {};
+    return e->data;
+}
+void
+ZstdCodec::setDictionary (Dictionary d, Blob const& dict)
+{
+    auto const i = static_cast<std::size_t>(d);
+    if (d == Dictionary::none || i >= dictionaries)
+        Throw<std::logic_error> ("zstd: bad dictionary");
+    auto entry = std::make_unique<Entry> (dict, level_);
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (entries_[i].load ())
+        Throw<std::logic_error> ("zstd: dictionary already set");
+    entries_[i].store (entry.get ());
+    owned_.push_back (std::move (entry));
+    sampling_[i] = false;
+    samples_[i].clear ();
+    samples_[i].shrink_to_fit ();
+}
+std::vector<Blob>
+ZstdCodec::sample (Dictionary d, void const* blob, std::size_t size)
+{
+    auto const i = static_cast<std::size_t>(d);
+    std::vector<Blob> samples;
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (! sampling_[i])
+        return samples;
+    auto const p = reinterpret_cast<std::uint8_t const*>(blob);
+    samples_[i].emplace_back (p, p + size);
+    if (samples_[i].size () < required_[i])
+        return samples;
+    sampling_[i] = false;
+    samples.swap (samples_[i]);
+    return samples;
+}
+void
+ZstdCodec::resetSampling (Dictionary d)
+{
+    auto const i = static_cast<std::size_t>(d);
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (d == Dictionary::none || entries_[i].load () || sampling_[i])
+        return;
+    required_[i] = std::min<std::size_t> (
+        2 * required_[i], zstdMaxTrainingSamples);
+    sampling_[i] = true;
+}
+Blob
+ZstdCodec::train (std::vector<Blob> const& samples, std::size_t capacity)
+{
+    Blob buffer;
+    std::vector<std::size_t> sizes;
+    sizes.reserve (samples.size ());
+    for (auto const& s : samples)
+    {
+        buffer.insert (buffer.end (), s.begin (), s.end ());
+        sizes.push_back (s.size ());
+    }
+    Blob dict (capacity);
+    auto const n = ZDICT_trainFromBuffer (dict.data (), dict.size (),
+        buffer.data (), sizes.data (), static_cast<unsigned>(sizes.size ()));
+    if (ZDICT_isError (n))
+        return {};
+    dict.resize (n);
+    return dict;
+}
+std::size_t
+ZstdCodec::compressBound (std::size_t size)
+{
+    return ZSTD_compressBound (size);
+}
+std::size_t
+ZstdCodec::compress (Dictionary d, void* out, std::size_t outCapacity,
+    void const* in, std::size_t inSize) const
+{
+    auto const e = entries_[static_cast<std::size_t>(d)].load ();
+    if (d != Dictionary::none && ! e)
+        Throw<std::runtime_error> ("zstd compress: missing dictionary");
+    auto const n = e ?
+        ZSTD_compress_usingCDict (compressContext (),
+            out, outCapacity, in, inSize, e->cdict) :
+        ZSTD_compressCCtx (compressContext (),
+            out, outCapacity, in, inSize, level_);
+    if (ZSTD_isError (n))
+        Throw<std::runtime_error> (
+            std::string ("zstd compress: ") + ZSTD_getErrorName (n));
+    return n;
+}
+void
+ZstdCodec::decompress (Dictionary d, void* out, std::size_t outSize,
+    void const* in, std::size_t inSize) const
+{
+    auto const i = static_cast<std::size_t>(d);
+    if (i >= dictionaries)
+        Throw<std::runtime_error> ("zstd decompress: bad dictionary");
+    auto const e = entries_[i].load ();
+    if (d != Dictionary::none && ! e)
+        Throw<std::runtime_error> ("zstd decompress: missing dictionary");
+    auto const n = e ?
+        ZSTD_decompress_usingDDict (decompressContext (),
+            out, outSize, in, inSize, e->ddict) :
+        ZSTD_decompressDCtx (decompressContext (),
+            out, outSize, in, inSize);
+    if (ZSTD_isError (n))
+        Throw<std::runtime_error> (
+            std::string ("zstd decompress: ") + ZSTD_getErrorName (n));
+    if (n != outSize)
+        Throw<std::runtime_error> ("zstd decompress: size mismatch");
+}
+}
+}
@@ -0,0 +1,71 @@
+#ifndef RIPPLE_NODESTORE_ZSTDCODEC_H_INCLUDED
+#define RIPPLE_NODESTORE_ZSTDCODEC_H_INCLUDED
+#include <ripple/basics/Blob.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+namespace ripple {
+namespace NodeStore {
+class ZstdCodec
+{
+public:
+    enum class Dictionary : std::uint8_t
+    {
+        none = 0,
+        accountState = 1,
+        transaction = 2
+    };
+    static constexpr std::size_t dictionaries = 3;
+private:
+    struct Entry;
+    int const level_;
+    std::array<std::atomic<Entry const*>, dictionaries> entries_;
+    std::vector<std::unique_ptr<Entry>> owned_;
+    std::mutex mutable mutex_;
+    std::array<std::vector<Blob>, dictionaries> samples_;
+    std::array<bool, dictionaries> sampling_;
+    std::array<std::size_t, dictionaries> required_;
+public:
+    ZstdCodec (ZstdCodec const&) = delete;
+    ZstdCodec& operator= (ZstdCodec const&) = delete;
+    explicit
+    ZstdCodec (int level);
+    ~ZstdCodec ();
+    int
+    level () const
+    {
+        return level_;
+    }
+    static
+    Dictionary
+    classify (void const* blob, std::size_t size);
+    bool
+    hasDictionary (Dictionary d) const;
+    Blob
+    getDictionary (Dictionary d) const;
+    void
+    setDictionary (Dictionary d, Blob const& dict);
+    std::vector<Blob>
+    sample (Dictionary d, void const* blob, std::size_t size);
+    void
+    resetSampling (Dictionary d);
+    static
+    Blob
+    train (std::vector<Blob> const& samples, std::size_t capacity);
+    static
+    std::size_t
+    compressBound (std::size_t size);
+    std::size_t
+    compress (Dictionary d, void* out, std::size_t outCapacity,
+        void const* in, std::size_t inSize) const;
+    void
+    decompress (Dictionary d, void* out, std::size_t outSize,
+        void const* in, std::size_t inSize) const;
+};
+}
+}
+#endif
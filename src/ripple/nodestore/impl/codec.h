@@ -4,6 +4,7 @@
 #include <ripple/basics/contract.h>
 #include <nudb/detail/field.hpp>
 #include <ripple/nodestore/impl/varint.h>
+#include <ripple/nodestore/impl/ZstdCodec.h>
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <lz4.h>
@@ -68,8 +69,52 @@ lz4_compress (void const* in,
 }
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
+zstd_decompress (void const* in,
+    std::size_t in_size, BufferFactory&& bf,
+        ZstdCodec const& codec, ZstdCodec::Dictionary dict)
+{
+    using namespace nudb::detail;
+    std::pair<void const*, std::size_t> result;
+    std::uint8_t const* p = reinterpret_cast<
+        std::uint8_t const*>(in);
+    auto const n = read_varint(
+        p, in_size, result.second);
+    if (n == 0)
+        Throw<std::runtime_error> (
+            "zstd decompress: n == 0");
+    void* const out = bf(result.second);
+    result.first = out;
+    codec.decompress(dict, out, result.second,
+        p + n, in_size - n);
+    return result;
+}
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
+zstd_compress (void const* in,
+    std::size_t in_size, BufferFactory&& bf,
+        ZstdCodec const& codec, ZstdCodec::Dictionary dict)
+{
+    using namespace nudb::detail;
+    std::pair<void const*, std::size_t> result;
+    std::array<std::uint8_t, varint_traits<
+        std::size_t>::max> vi;
+    auto const n = write_varint(
+        vi.data(), in_size);
+    auto const out_max =
+        ZstdCodec::compressBound(in_size);
+    std::uint8_t* out = reinterpret_cast<
+        std::uint8_t*>(bf(n + out_max));
+    result.first = out;
+    std::memcpy(out, vi.data(), n);
+    result.second = n + codec.compress(dict,
+        out + n, out_max, in, in_size);
+    return result;
+}
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
 nodeobject_decompress (void const* in,
-    std::size_t in_size, BufferFactory&& bf)
+    std::size_t in_size, BufferFactory&& bf,
+        ZstdCodec const* zstd = nullptr)
 {
     using namespace nudb::detail;
     std::uint8_t const* p = reinterpret_cast<
@@ -250,6 +295,19 @@ nodeobject_decompress (void const* in,
         write(os, is((depth+1)/2), (depth+1)/2);
         break;
     }
+    case 7: 
+    case 8: 
+    case 9: 
+    {
+        if (! zstd)
+            Throw<std::runtime_error> (
+                "nodeobject codec: zstd unavailable, type=" +
+                    std::to_string(type));
+        result = zstd_decompress(
+            p, in_size, bf, *zstd,
+                static_cast<ZstdCodec::Dictionary>(type - 7));
+        break;
+    }
     default:
         Throw<std::runtime_error> (
             "nodeobject codec: bad type=" +
@@ -273,7 +331,8 @@ zero32()
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
 nodeobject_compress (void const* in,
-    std::size_t in_size, BufferFactory&& bf)
+    std::size_t in_size, BufferFactory&& bf,
+        ZstdCodec const* zstd = nullptr)
 {
     using std::runtime_error;
     using namespace nudb::detail;
@@ -417,6 +476,14 @@ nodeobject_compress (void const* in,
             return result;
         }
     }
+    auto dict = ZstdCodec::Dictionary::none;
+    if (zstd)
+    {
+        dict = ZstdCodec::classify(in, in_size);
+        if (! zstd->hasDictionary(dict))
+            dict = ZstdCodec::Dictionary::none;
+        type = 7 + static_cast<std::size_t>(dict);
+    }
     std::array<std::uint8_t, varint_traits<
         std::size_t>::max> vi;
     auto const vn = write_varint(
@@ -441,6 +508,25 @@ nodeobject_compress (void const* in,
         result.second = vn + lzr.second;
         break;
     }
+    case 7: 
+    case 8: 
+    case 9: 
+    {
+        std::uint8_t* p;
+        auto const zr = NodeStore::zstd_compress(
+                in, in_size, [&p, &vn, &bf]
+            (std::size_t n)
+            {
+                p = reinterpret_cast<
+                    std::uint8_t*>(
+                        bf(vn + n));
+                return p + vn;
+            }, *zstd, dict);
+        std::memcpy(p, vi.data(), vn);
+        result.first = p;
+        result.second = vn + zr.second;
+        break;
+    }
     default:
         Throw<std::logic_error> (
             "nodeobject codec: unknown=" +
@@ -4,9 +4,11 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/buffers_iterator.hpp>
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 namespace ripple {
 class Message : public std::enable_shared_from_this <Message>
@@ -15,13 +17,26 @@ public:
     using pointer = std::shared_ptr<Message>;
 public:
     static std::size_t constexpr kHeaderBytes = 6;
+    static std::size_t constexpr kCompressedHeaderBytes = 10;
     static std::size_t constexpr kMaxMessageSize = 64 * 1024 * 1024;
+    static std::size_t constexpr kCompressionThreshold = 512;
+    static std::size_t constexpr kMaxCompressionRatio = 255;
+    static std::uint8_t constexpr kCompressionLZ4 = 0x90;
     Message (::google::protobuf::Message const& message, int type);
     std::vector <uint8_t> const&
     getBuffer () const
     {
         return mBuffer;
     }
+    std::vector <uint8_t> const&
+    getBuffer (bool compressed) const
+    {
+        if (compressed && ! mCompressedBuffer.empty ())
+            return mCompressedBuffer;
+        return mBuffer;
+    }
+    std::chrono::nanoseconds
+    compress ();
     std::size_t
     getCategory () const
     {
@@ -39,7 +54,7 @@ public:
                 Message::kHeaderBytes)
             return 0;
         std::size_t n;
-        n  = std::size_t{*first++} << 24;
+        n  = std::size_t{*first++ & 0x03u} << 24;
         n += std::size_t{*first++} << 16;
         n += std::size_t{*first++} <<  8;
         n += std::size_t{*first};
@@ -53,6 +68,49 @@ public:
         return size(buffers_begin(buffers),
             buffers_end(buffers));
     }
+    template <class FwdIter>
+    static
+    std::enable_if_t<std::is_same<typename
+        FwdIter::value_type, std::uint8_t>::value, std::uint8_t>
+    flags (FwdIter first, FwdIter last)
+    {
+        if (first == last)
+            return 0;
+        return *first & 0xFC;
+    }
+    template <class BufferSequence>
+    static
+    std::uint8_t
+    flags (BufferSequence const& buffers)
+    {
+        return flags(buffers_begin(buffers),
+            buffers_end(buffers));
+    }
+    template <class FwdIter>
+    static
+    std::enable_if_t<std::is_same<typename
+        FwdIter::value_type, std::uint8_t>::value, std::size_t>
+    uncompressedSize (FwdIter first, FwdIter last)
+    {
+        if (std::distance(first, last) <
+                Message::kCompressedHeaderBytes)
+            return 0;
+        std::advance(first, Message::kHeaderBytes);
+        std::size_t n;
+        n  = std::size_t{*first++} << 24;
+        n += std::size_t{*first++} << 16;
+        n += std::size_t{*first++} <<  8;
+        n += std::size_t{*first};
+        return n;
+    }
+    template <class BufferSequence>
+    static
+    std::size_t
+    uncompressedSize (BufferSequence const& buffers)
+    {
+        return uncompressedSize(buffers_begin(buffers),
+            buffers_end(buffers));
+    }
     static int getType (std::vector <uint8_t> const& buf);
     template <class FwdIter>
     static
@@ -93,6 +151,8 @@ private:
     }
     void encodeHeader (unsigned size, int type);
     std::vector <uint8_t> mBuffer;
+    std::vector <uint8_t> mCompressedBuffer;
+    std::once_flag mCompressed;
     std::size_t mCategory;
 };
 }
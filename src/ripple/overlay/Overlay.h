@@ -40,6 +40,10 @@ public:
         beast::IP::Address public_ip;
         int ipLimit = 0;
         std::uint32_t crawlOptions = 0;
+        bool compression = false;
+        bool squelch = false;
+        int serveThreads = 4;
+        std::size_t serveRate = 0;
     };
     using PeerSequence = std::vector <std::shared_ptr<Peer>>;
     virtual ~Overlay() = default;
@@ -84,11 +88,11 @@ public:
     virtual
     void
     relay (protocol::TMProposeSet& m,
-        uint256 const& uid) = 0;
+        uint256 const& uid, PublicKey const& validator) = 0;
     virtual
     void
     relay (protocol::TMValidation& m,
-        uint256 const& uid) = 0;
+        uint256 const& uid, PublicKey const& validator) = 0;
     template <typename UnaryFunc>
     std::enable_if_t<! std::is_void<
             typename UnaryFunc::return_type>::value,
@@ -119,6 +123,7 @@ public:
     virtual std::uint64_t getPeerDisconnect() const = 0;
     virtual void incPeerDisconnectCharges() = 0;
     virtual std::uint64_t getPeerDisconnectCharges() const = 0;
+    virtual Json::Value getLedgerServerJson() const = 0;
     virtual
     Json::Value
     crawlShards(bool pubKey, std::uint32_t hops) = 0;
@@ -170,11 +170,12 @@ ConnectAttempt::onHandshake (error_code ec)
         return close(); 
     req_ = makeRequest(! overlay_.peerFinder().config().peerPrivate,
         remote_endpoint_.address());
-    auto const hello = buildHello (
+    auto hello = buildHello (
         *sharedValue,
         overlay_.setup().public_ip,
         beast::IPAddressConversion::from_asio(remote_endpoint_),
         app_);
+    hello.set_compression (overlay_.setup().compression);
     appendHello (req_, hello);
     setTimer();
     boost::beast::http::async_write(stream_, req_,
@@ -0,0 +1,168 @@
+#include <ripple/overlay/impl/LedgerServer.h>
+#include <ripple/basics/Log.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/protocol/jss.h>
+#include <algorithm>
+#include <string>
+namespace ripple {
+LedgerServer::LedgerServer (int threads, std::size_t bytesPerSecond,
+        std::size_t maxQueue, beast::Journal journal)
+    : j_ (journal)
+    , rate_ (bytesPerSecond)
+    , maxQueue_ (std::max<std::size_t> (maxQueue, 1))
+    , budget_ (bytesPerSecond)
+    , refilled_ (clock_type::now ())
+{
+    while (threads-- > 0)
+        threads_.emplace_back (&LedgerServer::threadEntry, this);
+}
+LedgerServer::~LedgerServer ()
+{
+    stop ();
+}
+bool
+LedgerServer::post (Peer::id_t id, Task task)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (stopping_)
+        return false;
+    auto& queue = queues_[id];
+    if (queue.tasks.size () >= maxQueue_)
+    {
+        ++dropped_;
+        JLOG(j_.debug()) << "Peer " << id << " request queue full";
+        return false;
+    }
+    queue.tasks.push_back (std::move (task));
+    ++queued_;
+    if (! queue.busy && queue.tasks.size () == 1)
+    {
+        ready_.push_back (id);
+        cond_.notify_one ();
+    }
+    return true;
+}
+void
+LedgerServer::erase (Peer::id_t id)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = queues_.find (id);
+    if (iter == queues_.end ())
+        return;
+    queued_ -= iter->second.tasks.size ();
+    if (iter->second.busy)
+    {
+        iter->second.tasks.clear ();
+        return;
+    }
+    queues_.erase (iter);
+    ready_.erase (std::remove (ready_.begin (), ready_.end (), id),
+        ready_.end ());
+}
+void
+LedgerServer::stop ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (stopping_)
+            return;
+        stopping_ = true;
+        cond_.notify_all ();
+    }
+    for (auto& t : threads_)
+        t.join ();
+}
+std::size_t
+LedgerServer::size () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return queued_;
+}
+Json::Value
+LedgerServer::getJson () const
+{
+    Json::Value ret (Json::objectValue);
+    std::lock_guard<std::mutex> lock (mutex_);
+    ret[jss::threads] = static_cast<Json::UInt> (threads_.size ());
+    ret[jss::peers] = static_cast<Json::UInt> (queues_.size ());
+    ret[jss::queued] = static_cast<Json::UInt> (queued_);
+    ret[jss::served] = std::to_string (served_);
+    ret[jss::served_bytes] = std::to_string (servedBytes_);
+    ret[jss::dropped] = std::to_string (dropped_);
+    ret[jss::throttled_us] = std::to_string (throttled_.count ());
+    return ret;
+}
+void
+LedgerServer::refill (clock_type::time_point now)
+{
+    using namespace std::chrono;
+    auto const limit = static_cast<std::int64_t> (rate_);
+    auto const elapsed = duration_cast<microseconds> (now - refilled_);
+    if (elapsed >= seconds (1))
+    {
+        budget_ = limit;
+        refilled_ = now;
+        return;
+    }
+    auto const add = elapsed.count () * limit / 1000000;
+    if (add > 0)
+    {
+        budget_ = std::min (budget_ + add, limit);
+        refilled_ = now;
+    }
+}
+void
+LedgerServer::threadEntry ()
+{
+    using namespace std::chrono;
+    beast::setCurrentThreadName ("LedgerServer");
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (true)
+    {
+        while (! stopping_ && ready_.empty ())
+            cond_.wait (lock);
+        if (stopping_)
+            break;
+        if (rate_ != 0)
+        {
+            auto const now = clock_type::now ();
+            refill (now);
+            if (budget_ <= 0)
+            {
+                auto const deficit = 1 - budget_;
+                cond_.wait_until (lock, now + microseconds (
+                    deficit * 1000000 / static_cast<std::int64_t> (rate_) + 1));
+                throttled_ += duration_cast<microseconds> (
+                    clock_type::now () - now);
+                continue;
+            }
+        }
+        auto const id = ready_.front ();
+        ready_.pop_front ();
+        auto& queue = queues_[id];
+        auto task = std::move (queue.tasks.front ());
+        queue.tasks.pop_front ();
+        queue.busy = true;
+        --queued_;
+        lock.unlock ();
+        auto const bytes = task ();
+        lock.lock ();
+        ++served_;
+        servedBytes_ += bytes;
+        budget_ -= static_cast<std::int64_t> (bytes);
+        auto const iter = queues_.find (id);
+        if (iter == queues_.end ())
+            continue;
+        iter->second.busy = false;
+        if (iter->second.tasks.empty ())
+        {
+            queues_.erase (iter);
+        }
+        else
+        {
+            ready_.push_back (id);
+            cond_.notify_one ();
+        }
+    }
+}
+}
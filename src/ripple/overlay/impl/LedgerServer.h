@@ -0,0 +1,64 @@
+#ifndef RIPPLE_OVERLAY_LEDGERSERVER_H_INCLUDED
+#define RIPPLE_OVERLAY_LEDGERSERVER_H_INCLUDED
+#include <ripple/overlay/Peer.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace ripple {
+class LedgerServer
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using Task = std::function<std::size_t()>;
+    LedgerServer (int threads, std::size_t bytesPerSecond,
+        std::size_t maxQueue, beast::Journal journal);
+    ~LedgerServer ();
+    LedgerServer (LedgerServer const&) = delete;
+    LedgerServer& operator= (LedgerServer const&) = delete;
+    bool
+    post (Peer::id_t id, Task task);
+    void
+    erase (Peer::id_t id);
+    void
+    stop ();
+    std::size_t
+    size () const;
+    Json::Value
+    getJson () const;
+private:
+    struct Queue
+    {
+        std::deque<Task> tasks;
+        bool busy = false;
+    };
+    void
+    threadEntry ();
+    void
+    refill (clock_type::time_point now);
+    beast::Journal const j_;
+    std::size_t const rate_;
+    std::size_t const maxQueue_;
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::map<Peer::id_t, Queue> queues_;
+    std::deque<Peer::id_t> ready_;
+    std::size_t queued_ {0};
+    std::int64_t budget_;
+    clock_type::time_point refilled_;
+    bool stopping_ {false};
+    std::uint64_t served_ {0};
+    std::uint64_t servedBytes_ {0};
+    std::uint64_t dropped_ {0};
+    std::chrono::microseconds throttled_ {0};
+    std::vector<std::thread> threads_;
+};
+}
+#endif
@@ -2,6 +2,7 @@
 #include <ripple/basics/safe_cast.h>
 #include <ripple/overlay/Message.h>
 #include <ripple/overlay/impl/TrafficCount.h>
+#include <lz4.h>
 #include <cstdint>
 namespace ripple {
 Message::Message (::google::protobuf::Message const& message, int type)
@@ -16,6 +17,46 @@ Message::Message (::google::protobuf::Message const& message, int type)
     }
     mCategory = TrafficCount::categorize(message, type, false);
 }
+std::chrono::nanoseconds
+Message::compress ()
+{
+    using namespace std::chrono;
+    nanoseconds elapsed {0};
+    std::call_once (mCompressed,
+        [this, &elapsed]
+        {
+            auto const messageBytes = mBuffer.size () - kHeaderBytes;
+            if (messageBytes < kCompressionThreshold)
+                return;
+            auto const start = steady_clock::now ();
+            std::vector <uint8_t> buffer (kCompressedHeaderBytes +
+                LZ4_compressBound (messageBytes));
+            auto const compressedBytes = LZ4_compress_default (
+                reinterpret_cast<char const*> (&mBuffer [kHeaderBytes]),
+                reinterpret_cast<char*> (&buffer [kCompressedHeaderBytes]),
+                static_cast<int> (messageBytes),
+                static_cast<int> (buffer.size () - kCompressedHeaderBytes));
+            elapsed = duration_cast<nanoseconds> (
+                steady_clock::now () - start);
+            if (compressedBytes <= 0 || kCompressedHeaderBytes +
+                    compressedBytes >= mBuffer.size ())
+                return;
+            buffer.resize (kCompressedHeaderBytes + compressedBytes);
+            buffer[0] = static_cast<std::uint8_t> (kCompressionLZ4 |
+                ((compressedBytes >> 24) & 0x03));
+            buffer[1] = static_cast<std::uint8_t> ((compressedBytes >> 16) & 0xFF);
+            buffer[2] = static_cast<std::uint8_t> ((compressedBytes >> 8) & 0xFF);
+            buffer[3] = static_cast<std::uint8_t> (compressedBytes & 0xFF);
+            buffer[4] = mBuffer[4];
+            buffer[5] = mBuffer[5];
+            buffer[6] = static_cast<std::uint8_t> ((messageBytes >> 24) & 0xFF);
+            buffer[7] = static_cast<std::uint8_t> ((messageBytes >> 16) & 0xFF);
+            buffer[8] = static_cast<std::uint8_t> ((messageBytes >> 8) & 0xFF);
+            buffer[9] = static_cast<std::uint8_t> (messageBytes & 0xFF);
+            mCompressedBuffer = std::move (buffer);
+        });
+    return elapsed;
+}
 bool Message::operator== (Message const& other) const
 {
     return mBuffer == other.mBuffer;
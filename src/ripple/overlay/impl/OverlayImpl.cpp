@@ -88,6 +88,8 @@ OverlayImpl::Timer::on_timer (error_code ec)
     overlay_.autoConnect();
     if ((++overlay_.timer_count_ % Tuning::checkSeconds) == 0)
         overlay_.check();
+    if (overlay_.setup_.squelch)
+        overlay_.slots_.deleteIdle (clock_type::now());
     timer_.expires_from_now (std::chrono::seconds(1));
     timer_.async_wait(overlay_.strand_.wrap(std::bind(
         &Timer::on_timer, shared_from_this(),
@@ -113,6 +115,9 @@ OverlayImpl::OverlayImpl (
     , m_resourceManager (resourceManager)
     , m_peerFinder (PeerFinder::make_Manager (*this, io_service,
         stopwatch(), app_.journal("PeerFinder"), config))
+    , slots_ (*this)
+    , ledgerServer_ (setup.serveThreads, setup.serveRate,
+        Tuning::serveQueue, app_.journal("LedgerServer"))
     , m_resolver (resolver)
     , next_id_(1)
     , timer_count_(0)
@@ -459,6 +464,32 @@ OverlayImpl::onWrite (beast::PropertyStream::Map& stream)
             item["messages_out"] = std::to_string(i.messagesOut.load());
         }
     }
+    {
+        auto const& compression = m_traffic.getCompression();
+        beast::PropertyStream::Map item ("compression", stream);
+        item["bytes_in"] = std::to_string(compression.bytesIn.load());
+        item["uncompressed_bytes_in"] =
+            std::to_string(compression.uncompressedBytesIn.load());
+        item["messages_in"] = std::to_string(compression.messagesIn.load());
+        item["decompress_us"] =
+            std::to_string(compression.nanosecondsIn.load() / 1000);
+        item["bytes_out"] = std::to_string(compression.bytesOut.load());
+        item["uncompressed_bytes_out"] =
+            std::to_string(compression.uncompressedBytesOut.load());
+        item["messages_out"] = std::to_string(compression.messagesOut.load());
+        item["compress_us"] =
+            std::to_string(compression.nanosecondsOut.load() / 1000);
+    }
+    beast::PropertyStream::Set lanes ("lanes", stream);
+    for (auto const& i : m_traffic.getLanes())
+    {
+        beast::PropertyStream::Map item(lanes);
+        item["lane"] = i.name;
+        item["bytes_out"] = std::to_string(i.bytes.load());
+        item["messages_out"] = std::to_string(i.messages.load());
+        item["dropped"] = std::to_string(i.dropped.load());
+        item["wait_us"] = std::to_string(i.waitMicroseconds.load());
+    }
 }
 
 void
@@ -484,8 +515,13 @@ OverlayImpl::activate (std::shared_ptr<PeerImp> const& peer)
 void
 OverlayImpl::onPeerDeactivate (Peer::id_t id)
 {
-    std::lock_guard <decltype(mutex_)> lock (mutex_);
-    ids_.erase(id);
+    {
+        std::lock_guard <decltype(mutex_)> lock (mutex_);
+        ids_.erase(id);
+    }
+    if (setup_.squelch)
+        slots_.deletePeer (id, clock_type::now());
+    ledgerServer_.erase (id);
 }
 void
 OverlayImpl::onManifests (
@@ -558,6 +594,24 @@ OverlayImpl::reportTraffic (
 {
     m_traffic.addCount (cat, isInbound, number);
 }
+void
+OverlayImpl::reportCompression (
+    bool isInbound,
+    std::size_t bytes,
+    std::size_t uncompressedBytes,
+    std::chrono::nanoseconds elapsed)
+{
+    m_traffic.addCompression (isInbound, bytes, uncompressedBytes, elapsed);
+}
+void
+OverlayImpl::reportLane (
+    TrafficCount::lane lane,
+    std::size_t bytes,
+    bool dropped,
+    std::chrono::microseconds wait)
+{
+    m_traffic.addLane (lane, bytes, dropped, wait);
+}
 Json::Value
 OverlayImpl::crawlShards(bool pubKey, std::uint32_t hops)
 {
@@ -882,36 +936,73 @@ OverlayImpl::send (protocol::TMValidation& m)
     app_.getOPs().pubValidation (val);
 }
 void
-OverlayImpl::relay (protocol::TMProposeSet& m, uint256 const& uid)
+OverlayImpl::relay (protocol::TMProposeSet& m, uint256 const& uid,
+    PublicKey const& validator)
 {
     if (m.has_hops() && m.hops() >= maxTTL)
         return;
     if (auto const toSkip = app_.getHashRouter().shouldRelay(uid))
     {
         auto const sm = std::make_shared<Message>(m, protocol::mtPROPOSE_LEDGER);
+        auto const now = clock_type::now();
         for_each([&](std::shared_ptr<PeerImp>&& p)
         {
-            if (toSkip->find(p->id()) == toSkip->end())
+            if (toSkip->find(p->id()) == toSkip->end() &&
+                    ! p->isSquelched(validator, now))
                 p->send(sm);
         });
     }
 }
 void
-OverlayImpl::relay (protocol::TMValidation& m, uint256 const& uid)
+OverlayImpl::relay (protocol::TMValidation& m, uint256 const& uid,
+    PublicKey const& validator)
 {
     if (m.has_hops() && m.hops() >= maxTTL)
         return;
     if (auto const toSkip = app_.getHashRouter().shouldRelay(uid))
     {
         auto const sm = std::make_shared<Message>(m, protocol::mtVALIDATION);
+        auto const now = clock_type::now();
         for_each([&](std::shared_ptr<PeerImp>&& p)
         {
-            if (toSkip->find(p->id()) == toSkip->end())
+            if (toSkip->find(p->id()) == toSkip->end() &&
+                    ! p->isSquelched(validator, now))
                 p->send(sm);
         });
     }
 }
 void
+OverlayImpl::updateSlot (PublicKey const& validator, Peer::id_t id,
+    bool first)
+{
+    if (setup_.squelch)
+        slots_.onMessage (validator, id, first, clock_type::now());
+}
+void
+OverlayImpl::squelch (PublicKey const& validator, Peer::id_t id,
+    std::chrono::seconds duration)
+{
+    if (auto const peer = findPeerByShortID (id))
+    {
+        protocol::TMSquelch m;
+        m.set_squelch (true);
+        m.set_validatorpubkey (validator.data(), validator.size());
+        m.set_squelchduration (duration.count());
+        peer->send (std::make_shared<Message>(m, protocol::mtSQUELCH));
+    }
+}
+void
+OverlayImpl::unsquelch (PublicKey const& validator, Peer::id_t id)
+{
+    if (auto const peer = findPeerByShortID (id))
+    {
+        protocol::TMSquelch m;
+        m.set_squelch (false);
+        m.set_validatorpubkey (validator.data(), validator.size());
+        peer->send (std::make_shared<Message>(m, protocol::mtSQUELCH));
+    }
+}
+void
 OverlayImpl::remove (Child& child)
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
@@ -934,6 +1025,7 @@ OverlayImpl::stop()
             children.emplace_back (element.second.lock());
         }
     } 
+    ledgerServer_.stop();
     for (auto const& child : children)
     {
         if (child != nullptr)
@@ -982,9 +1074,15 @@ setup_Overlay (BasicConfig const& config)
         auto const& section = config.section("overlay");
         setup.context = make_SSLContext("");
         setup.expire = get<bool>(section, "expire", false);
+        setup.compression = get<bool>(section, "compression", false);
+        setup.squelch = get<bool>(section, "squelch", false);
         set(setup.ipLimit, "ip_limit", section);
         if (setup.ipLimit < 0)
             Throw<std::runtime_error>("Configured IP limit is invalid");
+        set(setup.serveThreads, "serve_threads", section);
+        if (setup.serveThreads < 1)
+            Throw<std::runtime_error>("Configured serve threads is invalid");
+        set(setup.serveRate, "serve_rate", section);
         std::string ip;
         set(ip, "public_ip", section);
         if (!ip.empty())
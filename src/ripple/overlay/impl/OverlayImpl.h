@@ -3,6 +3,8 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/core/Job.h>
 #include <ripple/overlay/Overlay.h>
+#include <ripple/overlay/impl/LedgerServer.h>
+#include <ripple/overlay/impl/Squelch.h>
 #include <ripple/overlay/impl/TrafficCount.h>
 #include <ripple/server/Handoff.h>
 #include <ripple/rpc/ServerHandler.h>
@@ -29,7 +31,9 @@ namespace ripple {
 class PeerImp;
 class BasicConfig;
 constexpr std::uint32_t maxTTL = 2;
-class OverlayImpl : public Overlay
+class OverlayImpl
+    : public Overlay
+    , public SquelchHandler
 {
 public:
     class Child
@@ -77,6 +81,8 @@ private:
     Resource::Manager& m_resourceManager;
     std::unique_ptr <PeerFinder::Manager> m_peerFinder;
     TrafficCount m_traffic;
+    Slots slots_;
+    LedgerServer ledgerServer_;
     hash_map <PeerFinder::Slot::ptr,
         std::weak_ptr <PeerImp>> m_peers;
     hash_map<Peer::id_t, std::weak_ptr<PeerImp>> ids_;
@@ -146,10 +152,17 @@ public:
     send (protocol::TMValidation& m) override;
     void
     relay (protocol::TMProposeSet& m,
-        uint256 const& uid) override;
+        uint256 const& uid, PublicKey const& validator) override;
     void
     relay (protocol::TMValidation& m,
-        uint256 const& uid) override;
+        uint256 const& uid, PublicKey const& validator) override;
+    void
+    updateSlot (PublicKey const& validator, Peer::id_t id, bool first);
+    void
+    squelch (PublicKey const& validator, Peer::id_t id,
+        std::chrono::seconds duration) override;
+    void
+    unsquelch (PublicKey const& validator, Peer::id_t id) override;
     void
     add_active (std::shared_ptr<PeerImp> const& peer);
     void
@@ -233,6 +246,18 @@ public:
         bool isInbound,
         int bytes);
     void
+    reportLane (
+        TrafficCount::lane lane,
+        std::size_t bytes,
+        bool dropped,
+        std::chrono::microseconds wait);
+    void
+    reportCompression (
+        bool isInbound,
+        std::size_t bytes,
+        std::size_t uncompressedBytes,
+        std::chrono::nanoseconds elapsed);
+    void
     incJqTransOverflow() override
     {
         ++jqTransOverflow_;
@@ -263,6 +288,16 @@ public:
         return peerDisconnectsCharges_;
     }
     Json::Value
+    getLedgerServerJson() const override
+    {
+        return ledgerServer_.getJson();
+    }
+    LedgerServer&
+    ledgerServer()
+    {
+        return ledgerServer_;
+    }
+    Json::Value
     crawlShards(bool pubKey, std::uint32_t hops) override;
     void
     lastLink(std::uint32_t id);
@@ -8,6 +8,7 @@
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/SigVerifier.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/misc/ValidatorList.h>
 #include <ripple/app/tx/apply.h>
@@ -26,6 +27,7 @@
 #include <algorithm>
 #include <memory>
 #include <sstream>
+#define SF_VERIFIED     SF_PRIVATE1
 using namespace std::chrono_literals;
 namespace ripple {
 PeerImp::PeerImp (Application& app, id_t id, endpoint_type remote_endpoint,
@@ -56,11 +58,16 @@ PeerImp::PeerImp (Application& app, id_t id, endpoint_type remote_endpoint,
     , publicKey_(publicKey)
     , creationTime_ (clock_type::now())
     , hello_(hello)
+    , compressionEnabled_(overlay.setup().compression &&
+        hello.compression())
     , usage_(consumer)
     , fee_ (Resource::feeLightPeer)
     , slot_ (slot)
     , request_(std::move(request))
     , headers_(request_)
+    , send_queue_(std::bind(&OverlayImpl::reportLane, &overlay,
+        std::placeholders::_1, std::placeholders::_2,
+            std::placeholders::_3, std::placeholders::_4))
 {
 }
 PeerImp::~PeerImp ()
@@ -144,9 +151,6 @@ PeerImp::send (Message::pointer const& m)
         return;
     if(detaching_)
         return;
-    overlay_.reportTraffic (
-        safe_cast<TrafficCount::category>(m->getCategory()),
-        false, static_cast<int>(m->getBuffer().size()));
     auto sendq_size = send_queue_.size();
     if (sendq_size < Tuning::targetSendQueue)
     {
@@ -160,19 +164,20 @@ PeerImp::send (Message::pointer const& m)
             (name.empty() ? remote_address_.to_string() : name) <<
                 " sendq: " << sendq_size;
     }
-    send_queue_.push(m);
-    if(sendq_size != 0)
+    auto const pushed = send_queue_.push(m, clock_type::now());
+    if (pushed == SendQueue::Push::dropped)
         return;
-    boost::asio::async_write(
-        stream_,
-        boost::asio::buffer(send_queue_.front()->getBuffer()),
-        bind_executor(
-            strand_,
-            std::bind(
-                &PeerImp::onWriteMessage,
-                shared_from_this(),
-                std::placeholders::_1,
-                std::placeholders::_2)));
+    if (compressionEnabled_)
+    {
+        auto const elapsed = m->compress();
+        overlay_.reportCompression (false,
+            m->getBuffer(true).size(), m->getBuffer().size(), elapsed);
+    }
+    overlay_.reportTraffic (
+        safe_cast<TrafficCount::category>(m->getCategory()),
+        false, static_cast<int>(m->getBuffer(compressionEnabled_).size()));
+    if (pushed == SendQueue::Push::start)
+        doWrite();
 }
 void
 PeerImp::charge (Resource::Charge const& fee)
@@ -231,6 +236,14 @@ PeerImp::json()
     }
     ret[jss::uptime] = static_cast<Json::UInt>(
         std::chrono::duration_cast<std::chrono::seconds>(uptime()).count());
+    {
+        Json::Value& batches = ret[jss::send_batches] = Json::arrayValue;
+        for (auto const count : send_queue_.batches())
+            batches.append(static_cast<Json::UInt>(count));
+        Json::Value& latency = ret[jss::send_latency_us] = Json::arrayValue;
+        for (auto const count : send_queue_.latency())
+            latency.append(static_cast<Json::UInt>(count));
+    }
     std::uint32_t minSeq, maxSeq;
     ledgerRange(minSeq, maxSeq);
     if ((minSeq != 0) || (maxSeq != 0))
@@ -586,6 +599,7 @@ PeerImp::makeResponse (bool crawl,
     resp.insert("Crawl", crawl ? "public" : "private");
     protocol::TMHello hello = buildHello(sharedValue,
         overlay_.setup().public_ip, remote, app_);
+    hello.set_compression(compressionEnabled_);
     appendHello(resp, hello);
     return resp;
 }
@@ -694,6 +708,20 @@ PeerImp::onReadMessage (error_code ec, std::size_t bytes_transferred)
                 std::placeholders::_2)));
 }
 void
+PeerImp::doWrite()
+{
+    boost::asio::async_write(
+        stream_,
+        send_queue_.prepare(compressionEnabled_, clock_type::now()),
+        bind_executor(
+            strand_,
+            std::bind(
+                &PeerImp::onWriteMessage,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2)));
+}
+void
 PeerImp::onWriteMessage (error_code ec, std::size_t bytes_transferred)
 {
     if(! socket_.is_open())
@@ -711,20 +739,9 @@ PeerImp::onWriteMessage (error_code ec, std::size_t bytes_transferred)
             stream << "onWriteMessage";
     }
     assert(! send_queue_.empty());
-    send_queue_.pop();
+    send_queue_.consume(clock_type::now());
     if (! send_queue_.empty())
-    {
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(send_queue_.front()->getBuffer()),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
-    }
+        return doWrite();
     if (gracefulClose_)
     {
         return stream_.async_shutdown(bind_executor(
@@ -741,6 +758,12 @@ PeerImp::onMessageUnknown (std::uint16_t type)
     error_code ec;
     return ec;
 }
+void
+PeerImp::onMessageDecompressed (std::size_t size,
+    std::size_t uncompressedSize, std::chrono::nanoseconds elapsed)
+{
+    overlay_.reportCompression (true, size, uncompressedSize, elapsed);
+}
 PeerImp::error_code
 PeerImp::onMessageBegin (std::uint16_t type,
     std::shared_ptr <::google::protobuf::Message> const& m,
@@ -1159,7 +1182,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
             "Need network ledger";
         return;
     }
-    SerialIter sit (makeSlice(m->rawtransaction()));
+    SerialIter sit (makeSlice(m->rawtransaction()), m);
     try
     {
         auto stx = std::make_shared<STTx const>(sit);
@@ -1191,7 +1214,9 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
             }
         }
         constexpr int max_transactions = 250;
-        if (app_.getJobQueue().getJobCount(jtTRANSACTION) > max_transactions)
+        auto& verifier = app_.getSigVerifier();
+        if (app_.getJobQueue().getJobCount(jtTRANSACTION) +
+            verifier.size() > max_transactions)
         {
             overlay_.incJqTransOverflow();
             JLOG(p_journal_.info()) << "Transaction queue is full";
@@ -1202,14 +1227,23 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
         }
         else
         {
-            app_.getJobQueue ().addJob (
-                jtTRANSACTION, "recvTransaction->checkTransaction",
-                [weak = std::weak_ptr<PeerImp>(shared_from_this()),
-                flags, checkSignature, stx] (Job&) {
-                    if (auto peer = weak.lock())
-                        peer->checkTransaction(flags,
-                            checkSignature, stx);
-                });
+            auto check = [weak = std::weak_ptr<PeerImp>(shared_from_this()),
+                flags, checkSignature, stx, &app = app_] ()
+            {
+                app.getJobQueue ().addJob (
+                    jtTRANSACTION, "recvTransaction->checkTransaction",
+                    [weak, flags, checkSignature, stx] (Job&) {
+                        if (auto peer = weak.lock())
+                            peer->checkTransaction(flags,
+                                checkSignature, stx);
+                    });
+            };
+            if (! checkSignature || ! verifier.verify(stx,
+                app_.getLedgerMaster().getValidatedRules(),
+                    [check] (Validity) { check(); }))
+            {
+                check();
+            }
         }
     }
     catch (std::exception const&)
@@ -1223,12 +1257,26 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetLedger> const& m)
 {
     fee_ = Resource::feeMediumBurdenPeer;
     std::weak_ptr<PeerImp> weak = shared_from_this();
-    app_.getJobQueue().addJob (
-        jtLEDGER_REQ, "recvGetLedger",
-        [weak, m] (Job&) {
+    if (m->itype () == protocol::liTS_CANDIDATE ||
+        (m->has_querytype () && ! m->has_requestcookie ()))
+    {
+        app_.getJobQueue().addJob (
+            jtLEDGER_REQ, "recvGetLedger",
+            [weak, m] (Job&) {
+                if (auto peer = weak.lock())
+                    peer->getLedger(m);
+            });
+        return;
+    }
+    if (! overlay_.ledgerServer().post (id_,
+        [weak, m] () -> std::size_t {
             if (auto peer = weak.lock())
-                peer->getLedger(m);
-        });
+                return peer->getLedger(m);
+            return 0;
+        }))
+    {
+        JLOG(p_journal_.debug()) << "GetLedger: Too many requests";
+    }
 }
 void
 PeerImp::onMessage (std::shared_ptr <protocol::TMLedgerData> const& m)
@@ -1309,12 +1357,15 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMProposeSet> const& m)
     uint256 const suppression = proposalUniqueId (
         proposeHash, prevLedger, set.proposeseq(),
         closeTime, publicKey.slice(), sig);
-    if (! app_.getHashRouter ().addSuppressionPeer (suppression, id_))
+    auto const isTrusted = app_.validators().trusted (publicKey);
+    int flags = 0;
+    if (! app_.getHashRouter ().addSuppressionPeer (suppression, id_, flags))
     {
+        if (isTrusted && (flags & SF_VERIFIED))
+            overlay_.updateSlot (publicKey, id_, false);
         JLOG(p_journal_.trace()) << "Proposal: duplicate";
         return;
     }
-    auto const isTrusted = app_.validators().trusted (publicKey);
     if (!isTrusted)
     {
         if (sanity_.load() == Sanity::insane)
@@ -1616,14 +1667,17 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMValidation> const& m)
             fee_ = Resource::feeUnwantedData;
             return;
         }
+        auto const isTrusted =
+            app_.validators().trusted(val->getSignerPublic ());
+        int flags = 0;
         if (! app_.getHashRouter ().addSuppressionPeer(
-            sha512Half(makeSlice(m->validation())), id_))
+            sha512Half(makeSlice(m->validation())), id_, flags))
         {
+            if (isTrusted && (flags & SF_VERIFIED))
+                overlay_.updateSlot (val->getSignerPublic (), id_, false);
             JLOG(p_journal_.trace()) << "Validation: duplicate";
             return;
         }
-        auto const isTrusted =
-            app_.validators().trusted(val->getSignerPublic ());
         if (!isTrusted && (sanity_.load () == Sanity::insane))
         {
             JLOG(p_journal_.debug()) <<
@@ -1633,14 +1687,21 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMValidation> const& m)
             ! app_.getFeeTrack ().isLoadedLocal ())
         {
             std::weak_ptr<PeerImp> weak = shared_from_this();
-            app_.getJobQueue ().addJob (
-                isTrusted ? jtVALIDATION_t : jtVALIDATION_ut,
-                "recvValidation->checkValidation",
-                [weak, val, m] (Job&)
-                {
-                    if (auto peer = weak.lock())
-                        peer->checkValidation(val, m);
-                });
+            auto check = [weak, val, m, isTrusted, &app = app_] (bool valid)
+            {
+                app.getJobQueue ().addJob (
+                    isTrusted ? jtVALIDATION_t : jtVALIDATION_ut,
+                    "recvValidation->checkValidation",
+                    [weak, val, m, valid] (Job&)
+                    {
+                        if (auto peer = weak.lock())
+                            peer->checkValidation(val, valid, m);
+                    });
+            };
+            if (cluster())
+                check(true);
+            else if (! app_.getSigVerifier().verify(val, check))
+                check(val->isValid());
         }
         else
         {
@@ -1661,7 +1722,8 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m)
     protocol::TMGetObjectByHash& packet = *m;
     if (packet.query ())
     {
-        if (send_queue_.size() >= Tuning::dropSendQueue)
+        if (send_queue_.size(TrafficCount::lane::bulk) >=
+            Tuning::dropSendQueue)
         {
             JLOG(p_journal_.debug()) << "GetObject: Large send queue";
             return;
@@ -1672,46 +1734,16 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m)
             return;
         }
         fee_ = Resource::feeMediumBurdenPeer;
-        protocol::TMGetObjectByHash reply;
-        reply.set_query (false);
-        if (packet.has_seq())
-            reply.set_seq(packet.seq());
-        reply.set_type (packet.type ());
-        if (packet.has_ledgerhash ())
-            reply.set_ledgerhash (packet.ledgerhash ());
-        for (int i = 0; i < packet.objects_size (); ++i)
+        std::weak_ptr<PeerImp> weak = shared_from_this();
+        if (! overlay_.ledgerServer().post (id_,
+            [weak, m] () -> std::size_t {
+                if (auto peer = weak.lock())
+                    return peer->getObjects(m);
+                return 0;
+            }))
         {
-            auto const& obj = packet.objects (i);
-            if (obj.has_hash() && stringIsUint256Sized (obj.hash()))
-            {
-                uint256 const hash {obj.hash()};
-                std::uint32_t seq {obj.has_ledgerseq() ? obj.ledgerseq() : 0};
-                auto hObj {app_.getNodeStore().fetch (hash, seq)};
-                if (!hObj)
-                {
-                    if (auto shardStore = app_.getShardStore())
-                    {
-                        if (seq >= shardStore->earliestSeq())
-                            hObj = shardStore->fetch(hash, seq);
-                    }
-                }
-                if (hObj)
-                {
-                    protocol::TMIndexedObject& newObj = *reply.add_objects ();
-                    newObj.set_hash (hash.begin (), hash.size ());
-                    newObj.set_data (&hObj->getData ().front (),
-                        hObj->getData ().size ());
-                    if (obj.has_nodeid ())
-                        newObj.set_index (obj.nodeid ());
-                    if (obj.has_ledgerseq())
-                        newObj.set_ledgerseq(obj.ledgerseq());
-                }
-            }
+            JLOG(p_journal_.debug()) << "GetObject: Too many requests";
         }
-        JLOG(p_journal_.trace()) <<
-            "GetObj: " << reply.objects_size () <<
-                " of " << packet.objects_size ();
-        send (std::make_shared<Message> (reply, protocol::mtGET_OBJECTS));
     }
     else
     {
@@ -1763,6 +1795,34 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m)
     }
 }
 void
+PeerImp::onMessage (std::shared_ptr <protocol::TMSquelch> const& m)
+{
+    auto const validator = makeSlice(m->validatorpubkey());
+    if (! publicKeyType(validator))
+    {
+        JLOG(p_journal_.warn()) << "Squelch: malformed";
+        fee_ = Resource::feeBadData;
+        return;
+    }
+    PublicKey const key {validator};
+    if (! overlay_.setup().squelch || ! app_.validators().trusted (key))
+    {
+        JLOG(p_journal_.debug()) << "Squelch: ignored";
+        return;
+    }
+    if (! m->squelch())
+    {
+        squelch_.unsquelch (key);
+        return;
+    }
+    if (! squelch_.squelch (key,
+        std::chrono::seconds {m->squelchduration()}, clock_type::now()))
+    {
+        JLOG(p_journal_.warn()) << "Squelch: rejected";
+        fee_ = Resource::feeBadData;
+    }
+}
+void
 PeerImp::addLedger (uint256 const& hash,
     std::lock_guard<std::mutex> const& lockedRecentLock)
 {
@@ -1882,6 +1942,9 @@ PeerImp::checkPropose (Job& job,
     }
     if (isTrusted)
     {
+        app_.getHashRouter ().setFlags (
+            peerPos.suppressionID (), SF_VERIFIED);
+        overlay_.updateSlot (peerPos.publicKey (), id_, true);
         app_.getOPs ().processTrustedProposal (peerPos, packet);
     }
     else
@@ -1891,7 +1954,8 @@ PeerImp::checkPropose (Job& job,
         {
             JLOG(p_journal_.trace()) <<
                 "relaying UNTRUSTED proposal";
-            overlay_.relay(set, peerPos.suppressionID());
+            overlay_.relay(set, peerPos.suppressionID(),
+                peerPos.publicKey());
         }
         else
         {
@@ -1901,24 +1965,30 @@ PeerImp::checkPropose (Job& job,
     }
 }
 void
-PeerImp::checkValidation (STValidation::pointer val,
+PeerImp::checkValidation (STValidation::pointer val, bool valid,
     std::shared_ptr<protocol::TMValidation> const& packet)
 {
     try
     {
-        if (! cluster() && !val->isValid())
+        if (! valid)
         {
             JLOG(p_journal_.warn()) <<
                 "Validation is invalid";
             charge (Resource::feeInvalidRequest);
             return;
         }
+        if (app_.validators().trusted(val->getSignerPublic ()))
+        {
+            app_.getHashRouter ().setFlags (
+                sha512Half(makeSlice(packet->validation())), SF_VERIFIED);
+            overlay_.updateSlot (val->getSignerPublic (), id_, true);
+        }
         if (app_.getOPs ().recvValidation(val, std::to_string(id())) ||
             cluster())
         {
             auto const suppression = sha512Half(
                 makeSlice(val->getSerialized()));
-            overlay_.relay(*packet, suppression);
+            overlay_.relay(*packet, suppression, val->getSignerPublic());
         }
     }
     catch (std::exception const&)
@@ -1972,7 +2042,7 @@ getPeerWithLedger (OverlayImpl& ov,
     });
     return ret;
 }
-void
+std::size_t
 PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
 {
     protocol::TMGetLedger& packet = *m;
@@ -1992,7 +2062,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
         {
             charge (Resource::feeInvalidRequest);
             JLOG(p_journal_.warn()) << "GetLedger: Tx candidate set invalid";
-            return;
+            return 0;
         }
         uint256 const txHash {packet.ledgerhash()};
         shared = app_.getInboundTransactions().getSet (txHash, false);
@@ -2007,16 +2077,16 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
                 if (! v)
                 {
                     JLOG(p_journal_.info()) << "GetLedger: Route TX set failed";
-                    return;
+                    return 0;
                 }
                 packet.set_requestcookie (id ());
                 v->send (std::make_shared<Message> (
                     packet, protocol::mtGET_LEDGER));
-                return;
+                return 0;
             }
             JLOG(p_journal_.debug()) << "GetLedger: Can't provide map ";
             charge (Resource::feeInvalidRequest);
-            return;
+            return 0;
         }
         reply.set_ledgerseq (0);
         reply.set_ledgerhash (txHash.begin (), txHash.size ());
@@ -2025,15 +2095,16 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
     }
     else
     {
-        if (send_queue_.size() >= Tuning::dropSendQueue)
+        if (send_queue_.size(TrafficCount::lane::bulk) >=
+            Tuning::dropSendQueue)
         {
             JLOG(p_journal_.debug()) << "GetLedger: Large send queue";
-            return;
+            return 0;
         }
         if (app_.getFeeTrack().isLoadedLocal() && ! cluster())
         {
             JLOG(p_journal_.debug()) << "GetLedger: Too busy";
-            return;
+            return 0;
         }
         JLOG(p_journal_.trace()) << "GetLedger: Received";
         if (packet.has_ledgerhash ())
@@ -2042,7 +2113,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
             {
                 charge (Resource::feeInvalidRequest);
                 JLOG(p_journal_.warn()) << "GetLedger: Invalid request";
-                return;
+                return 0;
             }
             uint256 const ledgerhash {packet.ledgerhash()};
             logMe += "LedgerHash:";
@@ -2070,13 +2141,13 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
                 if (!v)
                 {
                     JLOG(p_journal_.trace()) << "GetLedger: Cannot route";
-                    return;
+                    return 0;
                 }
                 packet.set_requestcookie (id ());
                 v->send (std::make_shared<Message>(
                     packet, protocol::mtGET_LEDGER));
                 JLOG(p_journal_.debug()) << "GetLedger: Request routed";
-                return;
+                return 0;
             }
         }
         else if (packet.has_ledgerseq ())
@@ -2085,7 +2156,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
                     app_.getLedgerMaster().getEarliestFetch())
             {
                 JLOG(p_journal_.debug()) << "GetLedger: Early ledger request";
-                return;
+                return 0;
             }
             ledger = app_.getLedgerMaster ().getLedgerBySeq (
                 packet.ledgerseq ());
@@ -2109,7 +2180,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
         {
             charge (Resource::feeInvalidRequest);
             JLOG(p_journal_.warn()) << "GetLedger: Unknown request";
-            return;
+            return 0;
         }
         if ((!ledger) || (packet.has_ledgerseq () && (
             packet.ledgerseq () != ledger->info().seq)))
@@ -2119,13 +2190,13 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
             {
                 JLOG(p_journal_.warn()) << "GetLedger: Invalid sequence";
             }
-            return;
+            return 0;
         }
         if (!packet.has_ledgerseq() && (ledger->info().seq <
             app_.getLedgerMaster().getEarliestFetch()))
         {
             JLOG(p_journal_.debug()) << "GetLedger: Early ledger request";
-            return;
+            return 0;
         }
         auto const lHash = ledger->info().hash;
         reply.set_ledgerhash (lHash.begin (), lHash.size ());
@@ -2163,7 +2234,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
             Message::pointer oPacket = std::make_shared<Message> (
                 reply, protocol::mtLEDGER_DATA);
             send (oPacket);
-            return;
+            return oPacket->getBuffer ().size ();
         }
         if (packet.itype () == protocol::liTX_NODE)
         {
@@ -2183,7 +2254,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
         JLOG(p_journal_.warn()) <<
             "GetLedger: Can't find map or empty request";
         charge (Resource::feeInvalidRequest);
-        return;
+        return 0;
     }
     JLOG(p_journal_.trace()) << "GetLedger: " << logMe;
     auto const depth =
@@ -2199,7 +2270,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
         {
             JLOG(p_journal_.warn()) << "GetLedger: Invalid node " << logMe;
             charge (Resource::feeInvalidRequest);
-            return;
+            return 0;
         }
         std::vector<SHAMapNodeID> nodeIDs;
         std::vector< Blob > rawNodes;
@@ -2254,6 +2325,55 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
     Message::pointer oPacket = std::make_shared<Message> (
         reply, protocol::mtLEDGER_DATA);
     send (oPacket);
+    return oPacket->getBuffer ().size ();
+}
+std::size_t
+PeerImp::getObjects (std::shared_ptr<protocol::TMGetObjectByHash> const& m)
+{
+    protocol::TMGetObjectByHash& packet = *m;
+    protocol::TMGetObjectByHash reply;
+    reply.set_query (false);
+    if (packet.has_seq())
+        reply.set_seq(packet.seq());
+    reply.set_type (packet.type ());
+    if (packet.has_ledgerhash ())
+        reply.set_ledgerhash (packet.ledgerhash ());
+    for (int i = 0; i < packet.objects_size (); ++i)
+    {
+        auto const& obj = packet.objects (i);
+        if (obj.has_hash() && stringIsUint256Sized (obj.hash()))
+        {
+            uint256 const hash {obj.hash()};
+            std::uint32_t seq {obj.has_ledgerseq() ? obj.ledgerseq() : 0};
+            auto hObj {app_.getNodeStore().fetch (hash, seq)};
+            if (!hObj)
+            {
+                if (auto shardStore = app_.getShardStore())
+                {
+                    if (seq >= shardStore->earliestSeq())
+                        hObj = shardStore->fetch(hash, seq);
+                }
+            }
+            if (hObj)
+            {
+                protocol::TMIndexedObject& newObj = *reply.add_objects ();
+                newObj.set_hash (hash.begin (), hash.size ());
+                newObj.set_data (&hObj->getData ().front (),
+                    hObj->getData ().size ());
+                if (obj.has_nodeid ())
+                    newObj.set_index (obj.nodeid ());
+                if (obj.has_ledgerseq())
+                    newObj.set_ledgerseq(obj.ledgerseq());
+            }
+        }
+    }
+    JLOG(p_journal_.trace()) <<
+        "GetObj: " << reply.objects_size () <<
+            " of " << packet.objects_size ();
+    auto const message =
+        std::make_shared<Message> (reply, protocol::mtGET_OBJECTS);
+    send (message);
+    return message->getBuffer ().size ();
 }
 void
 PeerImp::peerTXData (uint256 const& hash,
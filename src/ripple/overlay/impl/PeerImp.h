@@ -7,6 +7,7 @@
 #include <ripple/beast/utility/WrappedSink.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/OverlayImpl.h>
+#include <ripple/overlay/impl/SendQueue.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STTx.h>
@@ -16,7 +17,6 @@
 #include <boost/optional.hpp>
 #include <cstdint>
 #include <deque>
-#include <queue>
 #include <shared_mutex>
 namespace ripple {
 class PeerImp
@@ -93,6 +93,7 @@ private:
     std::mutex mutable recentLock_;
     protocol::TMStatusChange last_status_;
     protocol::TMHello const hello_;
+    bool const compressionEnabled_;
     Resource::Consumer usage_;
     Resource::Charge fee_;
     PeerFinder::Slot::ptr const slot_;
@@ -101,13 +102,14 @@ private:
     http_response_type response_;
     boost::beast::http::fields const& headers_;
     boost::beast::multi_buffer write_buffer_;
-    std::queue<Message::pointer> send_queue_;
+    SendQueue send_queue_;
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     int no_ping_ = 0;
     std::unique_ptr <LoadEvent> load_event_;
     std::mutex mutable shardInfoMutex_;
     hash_map<PublicKey, ShardInfo> shardInfo_;
+    Squelch squelch_;
     friend class OverlayImpl;
 public:
     PeerImp (PeerImp const&) = delete;
@@ -249,6 +251,8 @@ private:
     void
     onReadMessage (error_code ec, std::size_t bytes_transferred);
     void
+    doWrite();
+    void
     onWriteMessage (error_code ec, std::size_t bytes_transferred);
 public:
     static
@@ -258,8 +262,21 @@ public:
         return boost::system::errc::make_error_code (
             boost::system::errc::invalid_argument);
     }
+    bool
+    compressionEnabled () const
+    {
+        return compressionEnabled_;
+    }
+    bool
+    isSquelched (PublicKey const& validator, clock_type::time_point now)
+    {
+        return squelch_.isSquelched (validator, now);
+    }
     error_code
     onMessageUnknown (std::uint16_t type);
+    void
+    onMessageDecompressed (std::size_t size,
+        std::size_t uncompressedSize, std::chrono::nanoseconds elapsed);
     error_code
     onMessageBegin (std::uint16_t type,
         std::shared_ptr <::google::protobuf::Message> const& m,
@@ -286,6 +303,7 @@ public:
     void onMessage (std::shared_ptr <protocol::TMHaveTransactionSet> const& m);
     void onMessage (std::shared_ptr <protocol::TMValidation> const& m);
     void onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m);
+    void onMessage (std::shared_ptr <protocol::TMSquelch> const& m);
 private:
     State state() const
     {
@@ -308,10 +326,12 @@ private:
         std::shared_ptr<protocol::TMProposeSet> const& packet,
             RCLCxPeerPos peerPos);
     void
-    checkValidation (STValidation::pointer val,
+    checkValidation (STValidation::pointer val, bool valid,
         std::shared_ptr<protocol::TMValidation> const& packet);
-    void
+    std::size_t
     getLedger (std::shared_ptr<protocol::TMGetLedger> const&packet);
+    std::size_t
+    getObjects (std::shared_ptr<protocol::TMGetObjectByHash> const& packet);
     void
     peerTXData (uint256 const& hash,
         std::shared_ptr <protocol::TMLedgerData> const& pPacket,
@@ -345,11 +365,16 @@ PeerImp::PeerImp (Application& app, std::unique_ptr<beast::asio::ssl_bundle>&& s
     , publicKey_ (publicKey)
     , creationTime_ (clock_type::now())
     , hello_ (hello)
+    , compressionEnabled_ (overlay.setup ().compression &&
+        hello.compression ())
     , usage_ (usage)
     , fee_ (Resource::feeLightPeer)
     , slot_ (std::move(slot))
     , response_(std::move(response))
     , headers_(response_)
+    , send_queue_(std::bind(&OverlayImpl::reportLane, &overlay,
+        std::placeholders::_1, std::placeholders::_2,
+            std::placeholders::_3, std::placeholders::_4))
 {
     read_buffer_.commit (boost::asio::buffer_copy(read_buffer_.prepare(
         boost::asio::buffer_size(buffers)), buffers));
@@ -5,8 +5,13 @@
 #include <ripple/overlay/impl/ZeroCopyStream.h>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/buffers_iterator.hpp>
+#include <boost/beast/core/buffers_prefix.hpp>
+#include <boost/beast/core/buffers_suffix.hpp>
 #include <boost/system/error_code.hpp>
+#include <lz4.h>
+#include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <type_traits>
@@ -48,17 +53,16 @@ template <class T, class Buffers, class Handler>
 std::enable_if_t<std::is_base_of<
     ::google::protobuf::Message, T>::value,
         boost::system::error_code>
-invoke (int type, Buffers const& buffers,
-    Handler& handler)
+invoke (int type, Buffers const& buffers, std::size_t header,
+    std::size_t size, Handler& handler)
 {
     ZeroCopyInputStream<Buffers> stream(buffers);
-    stream.Skip(Message::kHeaderBytes);
+    stream.Skip(header);
     auto const m (std::make_shared<T>());
     if (! m->ParseFromZeroCopyStream(&stream))
         return boost::system::errc::make_error_code(
             boost::system::errc::invalid_argument);
-    auto ec = handler.onMessageBegin (type, m,
-       Message::kHeaderBytes + Message::size (buffers));
+    auto ec = handler.onMessageBegin (type, m, size);
     if (! ec)
     {
         handler.onMessage (m);
@@ -66,6 +70,59 @@ invoke (int type, Buffers const& buffers,
     }
     return ec;
 }
+template <class Buffers>
+char const*
+contiguous (Buffers const& buffers, std::size_t begin, std::size_t end)
+{
+    for (auto it = boost::asio::buffer_sequence_begin(buffers);
+        it != boost::asio::buffer_sequence_end(buffers); ++it)
+    {
+        boost::asio::const_buffer const b (*it);
+        if (begin < b.size())
+        {
+            if (end > b.size())
+                return nullptr;
+            return static_cast<char const*>(b.data()) + begin;
+        }
+        begin -= b.size();
+        end -= b.size();
+    }
+    return nullptr;
+}
+template <class Buffers, class Handler>
+boost::system::error_code
+dispatch (int type, Buffers const& buffers, std::size_t header,
+    std::size_t size, Handler& handler)
+{
+    boost::system::error_code ec;
+    switch (type)
+    {
+    case protocol::mtHELLO:                 ec = invoke<protocol::TMHello> (type, buffers, header, size, handler); break;
+    case protocol::mtMANIFESTS:             ec = invoke<protocol::TMManifests> (type, buffers, header, size, handler); break;
+    case protocol::mtPING:                  ec = invoke<protocol::TMPing> (type, buffers, header, size, handler); break;
+    case protocol::mtCLUSTER:               ec = invoke<protocol::TMCluster> (type, buffers, header, size, handler); break;
+    case protocol::mtGET_SHARD_INFO:        ec = invoke<protocol::TMGetShardInfo> (type, buffers, header, size, handler); break;
+    case protocol::mtSHARD_INFO:            ec = invoke<protocol::TMShardInfo>(type, buffers, header, size, handler); break;
+    case protocol::mtGET_PEER_SHARD_INFO:   ec = invoke<protocol::TMGetPeerShardInfo> (type, buffers, header, size, handler); break;
+    case protocol::mtPEER_SHARD_INFO:       ec = invoke<protocol::TMPeerShardInfo>(type, buffers, header, size, handler); break;
+    case protocol::mtGET_PEERS:             ec = invoke<protocol::TMGetPeers> (type, buffers, header, size, handler); break;
+    case protocol::mtPEERS:                 ec = invoke<protocol::TMPeers> (type, buffers, header, size, handler); break;
+    case protocol::mtENDPOINTS:             ec = invoke<protocol::TMEndpoints> (type, buffers, header, size, handler); break;
+    case protocol::mtTRANSACTION:           ec = invoke<protocol::TMTransaction> (type, buffers, header, size, handler); break;
+    case protocol::mtGET_LEDGER:            ec = invoke<protocol::TMGetLedger> (type, buffers, header, size, handler); break;
+    case protocol::mtLEDGER_DATA:           ec = invoke<protocol::TMLedgerData> (type, buffers, header, size, handler); break;
+    case protocol::mtPROPOSE_LEDGER:        ec = invoke<protocol::TMProposeSet> (type, buffers, header, size, handler); break;
+    case protocol::mtSTATUS_CHANGE:         ec = invoke<protocol::TMStatusChange> (type, buffers, header, size, handler); break;
+    case protocol::mtHAVE_SET:              ec = invoke<protocol::TMHaveTransactionSet> (type, buffers, header, size, handler); break;
+    case protocol::mtVALIDATION:            ec = invoke<protocol::TMValidation> (type, buffers, header, size, handler); break;
+    case protocol::mtGET_OBJECTS:           ec = invoke<protocol::TMGetObjectByHash> (type, buffers, header, size, handler); break;
+    case protocol::mtSQUELCH:               ec = invoke<protocol::TMSquelch> (type, buffers, header, size, handler); break;
+    default:
+        ec = handler.onMessageUnknown (type);
+        break;
+    }
+    return ec;
+}
 }
 template <class Buffers, class Handler>
 std::pair <std::size_t, boost::system::error_code>
@@ -81,34 +138,65 @@ invokeProtocolMessage (Buffers const& buffers, Handler& handler)
         result.second = make_error_code(boost::system::errc::message_size);
         return result;
     }
-    auto const size = Message::kHeaderBytes + Message::size(buffers);
+    auto const flags = Message::flags(buffers);
+    if (flags != 0 && (flags != Message::kCompressionLZ4 ||
+        ! handler.compressionEnabled()))
+    {
+        result.second = make_error_code(boost::system::errc::protocol_error);
+        return result;
+    }
+    auto const header = flags ?
+        Message::kCompressedHeaderBytes : Message::kHeaderBytes;
+    if (bs < header)
+        return result;
+    auto const size = header + Message::size(buffers);
     if (bs < size)
         return result;
     auto const type = Message::type(buffers);
-    switch (type)
+    if (flags)
     {
-    case protocol::mtHELLO:                 ec = detail::invoke<protocol::TMHello> (type, buffers, handler); break;
-    case protocol::mtMANIFESTS:             ec = detail::invoke<protocol::TMManifests> (type, buffers, handler); break;
-    case protocol::mtPING:                  ec = detail::invoke<protocol::TMPing> (type, buffers, handler); break;
-    case protocol::mtCLUSTER:               ec = detail::invoke<protocol::TMCluster> (type, buffers, handler); break;
-    case protocol::mtGET_SHARD_INFO:        ec = detail::invoke<protocol::TMGetShardInfo> (type, buffers, handler); break;
-    case protocol::mtSHARD_INFO:            ec = detail::invoke<protocol::TMShardInfo>(type, buffers, handler); break;
-    case protocol::mtGET_PEER_SHARD_INFO:   ec = detail::invoke<protocol::TMGetPeerShardInfo> (type, buffers, handler); break;
-    case protocol::mtPEER_SHARD_INFO:       ec = detail::invoke<protocol::TMPeerShardInfo>(type, buffers, handler); break;
-    case protocol::mtGET_PEERS:             ec = detail::invoke<protocol::TMGetPeers> (type, buffers, handler); break;
-    case protocol::mtPEERS:                 ec = detail::invoke<protocol::TMPeers> (type, buffers, handler); break;
-    case protocol::mtENDPOINTS:             ec = detail::invoke<protocol::TMEndpoints> (type, buffers, handler); break;
-    case protocol::mtTRANSACTION:           ec = detail::invoke<protocol::TMTransaction> (type, buffers, handler); break;
-    case protocol::mtGET_LEDGER:            ec = detail::invoke<protocol::TMGetLedger> (type, buffers, handler); break;
-    case protocol::mtLEDGER_DATA:           ec = detail::invoke<protocol::TMLedgerData> (type, buffers, handler); break;
-    case protocol::mtPROPOSE_LEDGER:        ec = detail::invoke<protocol::TMProposeSet> (type, buffers, handler); break;
-    case protocol::mtSTATUS_CHANGE:         ec = detail::invoke<protocol::TMStatusChange> (type, buffers, handler); break;
-    case protocol::mtHAVE_SET:              ec = detail::invoke<protocol::TMHaveTransactionSet> (type, buffers, handler); break;
-    case protocol::mtVALIDATION:            ec = detail::invoke<protocol::TMValidation> (type, buffers, handler); break;
-    case protocol::mtGET_OBJECTS:           ec = detail::invoke<protocol::TMGetObjectByHash> (type, buffers, handler); break;
-    default:
-        ec = handler.onMessageUnknown (type);
-        break;
+        using namespace std::chrono;
+        auto const uncompressed = Message::uncompressedSize(buffers);
+        if (uncompressed > Message::kMaxMessageSize ||
+            uncompressed > (size - header) * Message::kMaxCompressionRatio)
+        {
+            result.second = make_error_code(boost::system::errc::message_size);
+            return result;
+        }
+        auto const start = steady_clock::now();
+        std::vector<std::uint8_t> compressed;
+        char const* source = detail::contiguous(buffers, header, size);
+        if (source == nullptr)
+        {
+            compressed.resize(size - header);
+            boost::beast::buffers_suffix<Buffers> body (buffers);
+            body.consume(header);
+            boost::asio::buffer_copy(boost::asio::buffer(compressed), body);
+            source = reinterpret_cast<char const*>(compressed.data());
+        }
+        std::vector<std::uint8_t> payload (uncompressed);
+        if (LZ4_decompress_safe(
+                source,
+                reinterpret_cast<char*>(payload.data()),
+                static_cast<int>(size - header),
+                static_cast<int>(uncompressed)) !=
+                    static_cast<int>(uncompressed))
+        {
+            result.second = make_error_code(
+                boost::system::errc::invalid_argument);
+            return result;
+        }
+        handler.onMessageDecompressed (size,
+            Message::kHeaderBytes + uncompressed,
+                duration_cast<nanoseconds>(steady_clock::now() - start));
+        std::array<boost::asio::const_buffer, 1> const decompressed {{
+            boost::asio::buffer(payload) }};
+        ec = detail::dispatch (type, decompressed, 0, size, handler);
+    }
+    else
+    {
+        ec = detail::dispatch (type, boost::beast::buffers_prefix(
+            size, buffers), header, size, handler);
     }
     if (! ec)
         result.first = size;
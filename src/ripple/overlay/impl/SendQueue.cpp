@@ -0,0 +1,121 @@
+#include <ripple/overlay/impl/SendQueue.h>
+#include <cassert>
+namespace ripple {
+static
+std::size_t
+bucket (std::uint64_t value, std::size_t buckets)
+{
+    std::size_t i = 0;
+    while (value > 1 && i + 1 < buckets)
+    {
+        value >>= 1;
+        ++i;
+    }
+    return i;
+}
+static std::array<std::size_t, SendQueue::lanes> const weights {{
+    Tuning::consensusWeight,
+    Tuning::transactionWeight,
+    Tuning::bulkWeight }};
+SendQueue::SendQueue (Report report, std::size_t batchBytes)
+    : report_ (std::move (report))
+    , batchBytes_ (batchBytes)
+    , credits_ (weights)
+{
+}
+SendQueue::Push
+SendQueue::push (std::shared_ptr<Message> const& m,
+    clock_type::time_point now)
+{
+    auto const l = TrafficCount::classify (
+        safe_cast<TrafficCount::category> (m->getCategory ()));
+    auto& queue = lanes_[safe_cast<std::size_t> (l)];
+    if (l == lane::transaction && queue.size () >= Tuning::dropTxSendQueue)
+    {
+        if (report_)
+            report_ (l, m->getBuffer ().size (), true,
+                std::chrono::microseconds {0});
+        return Push::dropped;
+    }
+    queue.push_back ({m, now, l});
+    ++queued_;
+    return size () == 1 ? Push::start : Push::queued;
+}
+std::size_t
+SendQueue::select ()
+{
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (std::size_t i = 0; i < lanes; ++i)
+            if (credits_[i] > 0 && ! lanes_[i].empty ())
+                return i;
+        credits_ = weights;
+    }
+    return lanes;
+}
+boost::asio::const_buffer
+SendQueue::prepare (bool compressed, clock_type::time_point now)
+{
+    assert (queued_ > 0 && inflight_.empty ());
+    start_ = now;
+    compressed_ = compressed;
+    std::size_t bytes = 0;
+    for (auto i = select (); i != lanes; i = select ())
+    {
+        auto& queue = lanes_[i];
+        auto const n = queue.front ().message->getBuffer (compressed).size ();
+        if (! inflight_.empty () && bytes + n > batchBytes_)
+            break;
+        bytes += n;
+        --credits_[i];
+        inflight_.push_back (std::move (queue.front ()));
+        queue.pop_front ();
+        --queued_;
+    }
+    if (inflight_.size () == 1)
+        return boost::asio::buffer (
+            inflight_.front ().message->getBuffer (compressed));
+    batch_.clear ();
+    batch_.reserve (bytes);
+    for (auto const& entry : inflight_)
+    {
+        auto const& buffer = entry.message->getBuffer (compressed);
+        batch_.insert (batch_.end (), buffer.begin (), buffer.end ());
+    }
+    return boost::asio::buffer (batch_);
+}
+std::size_t
+SendQueue::consume (clock_type::time_point now)
+{
+    using namespace std::chrono;
+    assert (! inflight_.empty ());
+    auto const n = inflight_.size ();
+    if (report_)
+    {
+        for (auto const& entry : inflight_)
+            report_ (entry.l, entry.message->getBuffer (compressed_).size (),
+                false, duration_cast<microseconds> (now - entry.queued));
+    }
+    inflight_.clear ();
+    ++batches_[bucket (n, batchBuckets)];
+    ++latency_[bucket (duration_cast<microseconds> (
+        now - start_).count (), latencyBuckets)];
+    return n;
+}
+std::array<std::uint64_t, SendQueue::batchBuckets>
+SendQueue::batches () const
+{
+    std::array<std::uint64_t, batchBuckets> result;
+    for (std::size_t i = 0; i < batchBuckets; ++i)
+        result[i] = batches_[i].load ();
+    return result;
+}
+std::array<std::uint64_t, SendQueue::latencyBuckets>
+SendQueue::latency () const
+{
+    std::array<std::uint64_t, latencyBuckets> result;
+    for (std::size_t i = 0; i < latencyBuckets; ++i)
+        result[i] = latency_[i].load ();
+    return result;
+}
+}
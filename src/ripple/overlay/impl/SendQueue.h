@@ -0,0 +1,84 @@
+#ifndef RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#define RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+namespace ripple {
+class SendQueue
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using lane = TrafficCount::lane;
+    using Report = std::function<void(lane l, std::size_t bytes,
+        bool dropped, std::chrono::microseconds wait)>;
+    enum class Push
+    {
+        dropped,
+        queued,
+        start
+    };
+    static std::size_t constexpr lanes = 3;
+    static std::size_t constexpr batchBuckets = 8;
+    static std::size_t constexpr latencyBuckets = 20;
+    explicit
+    SendQueue (Report report = {},
+        std::size_t batchBytes = Tuning::sendBatchBytes);
+    SendQueue (SendQueue const&) = delete;
+    SendQueue& operator= (SendQueue const&) = delete;
+    std::size_t
+    size () const
+    {
+        return queued_ + inflight_.size ();
+    }
+    std::size_t
+    size (lane l) const
+    {
+        return lanes_[safe_cast<std::size_t>(l)].size ();
+    }
+    bool
+    empty () const
+    {
+        return size () == 0;
+    }
+    Push
+    push (std::shared_ptr<Message> const& m, clock_type::time_point now);
+    boost::asio::const_buffer
+    prepare (bool compressed, clock_type::time_point now);
+    std::size_t
+    consume (clock_type::time_point now);
+    std::array<std::uint64_t, batchBuckets>
+    batches () const;
+    std::array<std::uint64_t, latencyBuckets>
+    latency () const;
+private:
+    struct Entry
+    {
+        std::shared_ptr<Message> message;
+        clock_type::time_point queued;
+        lane l;
+    };
+    std::size_t
+    select ();
+    Report const report_;
+    std::size_t const batchBytes_;
+    std::array<std::deque<Entry>, lanes> lanes_;
+    std::array<std::size_t, lanes> credits_ {};
+    std::size_t queued_ = 0;
+    std::vector<Entry> inflight_;
+    std::vector<std::uint8_t> batch_;
+    bool compressed_ = false;
+    clock_type::time_point start_;
+    std::array<std::atomic<std::uint64_t>, batchBuckets> batches_ {};
+    std::array<std::atomic<std::uint64_t>, latencyBuckets> latency_ {};
+};
+}
+#endif
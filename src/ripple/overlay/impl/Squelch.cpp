@@ -0,0 +1,192 @@
+#include <ripple/overlay/impl/Squelch.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/basics/random.h>
+#include <algorithm>
+namespace ripple {
+bool
+Squelch::squelch (PublicKey const& validator,
+    std::chrono::seconds duration, clock_type::time_point now)
+{
+    if (duration < Tuning::squelchMinDuration ||
+        duration > Tuning::squelchMaxDuration)
+        return false;
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = squelched_.find (validator);
+    if (iter != squelched_.end ())
+    {
+        iter->second = now + duration;
+        return true;
+    }
+    if (squelched_.size () >= Tuning::squelchMaxEntries)
+    {
+        for (auto i = squelched_.begin (); i != squelched_.end ();)
+        {
+            if (i->second <= now)
+                i = squelched_.erase (i);
+            else
+                ++i;
+        }
+        if (squelched_.size () >= Tuning::squelchMaxEntries)
+            return false;
+    }
+    squelched_.emplace (validator, now + duration);
+    return true;
+}
+void
+Squelch::unsquelch (PublicKey const& validator)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    squelched_.erase (validator);
+}
+bool
+Squelch::isSquelched (PublicKey const& validator,
+    clock_type::time_point now)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = squelched_.find (validator);
+    if (iter == squelched_.end ())
+        return false;
+    if (iter->second > now)
+        return true;
+    squelched_.erase (iter);
+    return false;
+}
+Slots::Slots (SquelchHandler& handler)
+    : handler_ (handler)
+{
+}
+void
+Slots::onMessage (PublicKey const& validator, Peer::id_t id,
+    bool first, clock_type::time_point now)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto& slot = slots_[validator];
+    auto& source = slot.sources[id];
+    source.last = now;
+    if (first)
+        ++source.first;
+    if (slot.selected)
+    {
+        if (! source.selected && source.expire <= now)
+            squelch (validator, id, source, now);
+        return;
+    }
+    if (first && ++slot.first >= Tuning::squelchThreshold)
+        select (validator, slot, now);
+}
+void
+Slots::deletePeer (Peer::id_t id, clock_type::time_point now)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    for (auto iter = slots_.begin (); iter != slots_.end ();)
+    {
+        auto& slot = iter->second;
+        auto const source = slot.sources.find (id);
+        if (source != slot.sources.end ())
+        {
+            auto const selected = source->second.selected;
+            slot.sources.erase (source);
+            if (selected)
+                reset (iter->first, slot, now);
+        }
+        if (slot.sources.empty ())
+            iter = slots_.erase (iter);
+        else
+            ++iter;
+    }
+}
+void
+Slots::deleteIdle (clock_type::time_point now)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    for (auto iter = slots_.begin (); iter != slots_.end ();)
+    {
+        auto& slot = iter->second;
+        bool active = false;
+        bool idle = false;
+        for (auto const& source : slot.sources)
+        {
+            if (now - source.second.last <= Tuning::squelchIdle)
+                active = true;
+            else if (source.second.selected)
+                idle = true;
+        }
+        if (idle || ! active)
+            reset (iter->first, slot, now);
+        if (! active)
+            iter = slots_.erase (iter);
+        else
+            ++iter;
+    }
+}
+std::vector<Peer::id_t>
+Slots::getSelected (PublicKey const& validator) const
+{
+    std::vector<Peer::id_t> selected;
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = slots_.find (validator);
+    if (iter != slots_.end ())
+    {
+        for (auto const& source : iter->second.sources)
+            if (source.second.selected)
+                selected.push_back (source.first);
+    }
+    return selected;
+}
+std::size_t
+Slots::size () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return slots_.size ();
+}
+void
+Slots::select (PublicKey const& validator, Slot& slot,
+    clock_type::time_point now)
+{
+    if (slot.sources.size () <= Tuning::squelchSources)
+        return;
+    std::vector<std::pair<std::size_t, Peer::id_t>> ranked;
+    ranked.reserve (slot.sources.size ());
+    for (auto const& source : slot.sources)
+        ranked.emplace_back (source.second.first, source.first);
+    std::partial_sort (ranked.begin (),
+        ranked.begin () + Tuning::squelchSources, ranked.end (),
+        [](auto const& lhs, auto const& rhs)
+        {
+            if (lhs.first != rhs.first)
+                return lhs.first > rhs.first;
+            return lhs.second < rhs.second;
+        });
+    for (std::size_t i = 0; i < Tuning::squelchSources; ++i)
+        slot.sources[ranked[i].second].selected = true;
+    slot.selected = true;
+    for (auto& source : slot.sources)
+        if (! source.second.selected)
+            squelch (validator, source.first, source.second, now);
+}
+void
+Slots::squelch (PublicKey const& validator, Peer::id_t id,
+    Source& source, clock_type::time_point now)
+{
+    std::chrono::seconds const duration {rand_int (
+        Tuning::squelchMinDuration.count (),
+        Tuning::squelchMaxDuration.count ())};
+    source.expire = now + duration;
+    handler_.squelch (validator, id, duration);
+}
+void
+Slots::reset (PublicKey const& validator, Slot& slot,
+    clock_type::time_point now)
+{
+    for (auto& source : slot.sources)
+    {
+        if (! source.second.selected && source.second.expire > now)
+            handler_.unsquelch (validator, source.first);
+        source.second.first = 0;
+        source.second.expire = clock_type::time_point{};
+        source.second.selected = false;
+    }
+    slot.first = 0;
+    slot.selected = false;
+}
+}
@@ -0,0 +1,85 @@
+#ifndef RIPPLE_OVERLAY_SQUELCH_H_INCLUDED
+#define RIPPLE_OVERLAY_SQUELCH_H_INCLUDED
+#include <ripple/overlay/Peer.h>
+#include <ripple/protocol/PublicKey.h>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+namespace ripple {
+class Squelch
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    bool
+    squelch (PublicKey const& validator, std::chrono::seconds duration,
+        clock_type::time_point now);
+    void
+    unsquelch (PublicKey const& validator);
+    bool
+    isSquelched (PublicKey const& validator, clock_type::time_point now);
+private:
+    std::mutex mutex_;
+    std::map<PublicKey, clock_type::time_point> squelched_;
+};
+class SquelchHandler
+{
+public:
+    virtual ~SquelchHandler() = default;
+    virtual
+    void
+    squelch (PublicKey const& validator, Peer::id_t id,
+        std::chrono::seconds duration) = 0;
+    virtual
+    void
+    unsquelch (PublicKey const& validator, Peer::id_t id) = 0;
+};
+class Slots
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    explicit
+    Slots (SquelchHandler& handler);
+    Slots (Slots const&) = delete;
+    Slots& operator= (Slots const&) = delete;
+    void
+    onMessage (PublicKey const& validator, Peer::id_t id, bool first,
+        clock_type::time_point now);
+    void
+    deletePeer (Peer::id_t id, clock_type::time_point now);
+    void
+    deleteIdle (clock_type::time_point now);
+    std::vector<Peer::id_t>
+    getSelected (PublicKey const& validator) const;
+    std::size_t
+    size () const;
+private:
+    struct Source
+    {
+        std::size_t first = 0;
+        clock_type::time_point last;
+        clock_type::time_point expire;
+        bool selected = false;
+    };
+    struct Slot
+    {
+        std::map<Peer::id_t, Source> sources;
+        std::size_t first = 0;
+        bool selected = false;
+    };
+    void
+    select (PublicKey const& validator, Slot& slot,
+        clock_type::time_point now);
+    void
+    squelch (PublicKey const& validator, Peer::id_t id, Source& source,
+        clock_type::time_point now);
+    void
+    reset (PublicKey const& validator, Slot& slot,
+        clock_type::time_point now);
+    SquelchHandler& handler_;
+    std::mutex mutable mutex_;
+    std::map<PublicKey, Slot> slots_;
+};
+}
+#endif
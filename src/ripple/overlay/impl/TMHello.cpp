@@ -112,6 +112,8 @@ appendHello (boost::beast::http::fields& h,
         h.insert ("Local-IP", hello.local_ip_str());
     if (hello.has_remote_ip())
         h.insert ("Remote-IP", hello.remote_ip_str());
+    if (hello.compression())
+        h.insert ("X-Offer-Compression", "lz4");
 }
 std::vector<ProtocolVersion>
 parse_ProtocolVersions(boost::beast::string_view const& value)
@@ -247,6 +249,18 @@ parseHello (bool request, boost::beast::http::fields const& h, beast::Journal jo
             hello.set_remote_ip_str(address.to_string());
         }
     }
+    {
+        auto const iter = h.find ("X-Offer-Compression");
+        if (iter != h.end())
+        {
+            for (auto const& algorithm :
+                    beast::rfc2616::split_commas (iter->value()))
+            {
+                if (algorithm == "lz4")
+                    hello.set_compression (true);
+            }
+        }
+    }
     return hello;
 }
 boost::optional<PublicKey>
@@ -15,7 +15,8 @@ TrafficCount::category TrafficCount::categorize (
         return TrafficCount::category::manifests;
     if ((type == protocol::mtENDPOINTS) ||
             (type == protocol::mtPEERS) ||
-            (type == protocol::mtGET_PEERS))
+            (type == protocol::mtGET_PEERS) ||
+            (type == protocol::mtSQUELCH))
         return TrafficCount::category::overlay;
     if ((type == protocol::mtGET_SHARD_INFO) ||
             (type == protocol::mtSHARD_INFO) ||
@@ -100,4 +101,27 @@ TrafficCount::category TrafficCount::categorize (
     }
     return TrafficCount::category::unknown;
 }
+TrafficCount::lane TrafficCount::classify (category cat)
+{
+    switch (cat)
+    {
+    case category::base:
+    case category::cluster:
+    case category::overlay:
+    case category::manifests:
+    case category::proposal:
+    case category::validation:
+    case category::get_set:
+    case category::share_set:
+    case category::ld_tsc_get:
+    case category::ld_tsc_share:
+    case category::gl_tsc_share:
+    case category::gl_tsc_get:
+        return lane::consensus;
+    case category::transaction:
+        return lane::transaction;
+    default:
+        return lane::bulk;
+    }
+}
 } 
@@ -4,6 +4,7 @@
 #include <ripple/protocol/messages.h>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 namespace ripple {
 class TrafficCount
@@ -34,6 +35,37 @@ public:
             return messagesIn || messagesOut;
         }
     };
+    class CompressionStats
+    {
+    public:
+        std::atomic<std::uint64_t> bytesIn {0};
+        std::atomic<std::uint64_t> bytesOut {0};
+        std::atomic<std::uint64_t> uncompressedBytesIn {0};
+        std::atomic<std::uint64_t> uncompressedBytesOut {0};
+        std::atomic<std::uint64_t> messagesIn {0};
+        std::atomic<std::uint64_t> messagesOut {0};
+        std::atomic<std::uint64_t> nanosecondsIn {0};
+        std::atomic<std::uint64_t> nanosecondsOut {0};
+    };
+    class LaneStats
+    {
+    public:
+        std::string const name;
+        std::atomic<std::uint64_t> bytes {0};
+        std::atomic<std::uint64_t> messages {0};
+        std::atomic<std::uint64_t> dropped {0};
+        std::atomic<std::uint64_t> waitMicroseconds {0};
+        LaneStats(char const* n)
+            : name (n)
+        {
+        }
+    };
+    enum class lane : std::size_t
+    {
+        consensus,
+        transaction,
+        bulk
+    };
     enum category : std::size_t
     {
         base,           
@@ -81,6 +113,7 @@ public:
     static category categorize (
         ::google::protobuf::Message const& message,
         int type, bool inbound);
+    static lane classify (category cat);
     void addCount (category cat, bool inbound, int bytes)
     {
         assert (cat <= category::unknown);
@@ -95,12 +128,57 @@ public:
             ++counts_[cat].messagesOut;
         }
     }
+    void addCompression (bool inbound, std::size_t bytes,
+        std::size_t uncompressedBytes, std::chrono::nanoseconds elapsed)
+    {
+        if (inbound)
+        {
+            compression_.nanosecondsIn += elapsed.count ();
+            if (bytes == uncompressedBytes)
+                return;
+            compression_.bytesIn += bytes;
+            compression_.uncompressedBytesIn += uncompressedBytes;
+            ++compression_.messagesIn;
+        }
+        else
+        {
+            compression_.nanosecondsOut += elapsed.count ();
+            if (bytes == uncompressedBytes)
+                return;
+            compression_.bytesOut += bytes;
+            compression_.uncompressedBytesOut += uncompressedBytes;
+            ++compression_.messagesOut;
+        }
+    }
+    void addLane (lane l, std::size_t bytes, bool dropped,
+        std::chrono::microseconds wait)
+    {
+        auto& stats = lanes_[safe_cast<std::size_t>(l)];
+        if (dropped)
+        {
+            ++stats.dropped;
+            return;
+        }
+        stats.bytes += bytes;
+        ++stats.messages;
+        stats.waitMicroseconds += wait.count ();
+    }
     TrafficCount() = default;
     auto
     getCounts () const
     {
         return counts_;
     }
+    CompressionStats const&
+    getCompression () const
+    {
+        return compression_;
+    }
+    std::array<LaneStats, 3> const&
+    getLanes () const
+    {
+        return lanes_;
+    }
 protected:
     std::array<TrafficStats, category::unknown + 1> counts_
     {{
@@ -146,6 +224,13 @@ protected:
         { "getobject (get)" },                                    
         { "unknown" }                                             
     }};
+    CompressionStats compression_;
+    std::array<LaneStats, 3> lanes_
+    {{
+        { "consensus" },
+        { "transaction" },
+        { "bulk" }
+    }};
 };
 }
 #endif
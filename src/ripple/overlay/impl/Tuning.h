@@ -19,8 +19,20 @@ enum
     dropSendQueue       =   192,
     targetSendQueue     =   128,
     sendQueueLogFreq    =    64,
+    sendBatchBytes      = 65536,
+    dropTxSendQueue     =    64,
+    consensusWeight     =     8,
+    transactionWeight   =     4,
+    bulkWeight          =     1,
+    serveQueue          =    32,
+    squelchThreshold    =    20,
+    squelchSources      =     3,
+    squelchMaxEntries   =  1024,
 };
 std::chrono::milliseconds constexpr peerHighLatency{300};
+std::chrono::seconds constexpr squelchMinDuration{300};
+std::chrono::seconds constexpr squelchMaxDuration{600};
+std::chrono::seconds constexpr squelchIdle{8};
 } 
 } 
 #endif
@@ -150,6 +150,15 @@ verify (PublicKey const& publicKey,
     Slice const& m,
     Slice const& sig,
     bool mustBeFullyCanonical = true);
+struct SignedMessage
+{
+    PublicKey const* publicKey;
+    Slice message;
+    Slice signature;
+    bool mustBeFullyCanonical;
+};
+bool
+verifyBatch (SignedMessage const* items, bool* valid, std::size_t count);
 NodeID
 calcNodeID (PublicKey const&);
 AccountID
@@ -62,6 +62,10 @@ public:
         return elements_.size ();
     }
     int getIndex (SField const&) const;
+    std::vector<int> const& order () const
+    {
+        return order_;
+    }
     SOEStyle
     style(SField const& sf) const
     {
@@ -70,6 +74,7 @@ public:
 private:
     std::vector<SOElement> elements_;
     std::vector<int> indices_;              
+    std::vector<int> order_;
 };
 } 
 #endif
@@ -15,7 +15,9 @@ public:
     STBlob () = default;
     STBlob (STBlob const& rhs)
         :STBase(rhs)
-        , value_ (rhs.data (), rhs.size ())
+        , value_ (rhs.owner_ ? Buffer () : Buffer (rhs.data (), rhs.size ()))
+        , owner_ (rhs.owner_)
+        , shared_ (rhs.shared_)
     {
     }
     STBlob (SField const& f,
@@ -45,13 +47,17 @@ public:
     std::size_t
     size() const
     {
-        return value_.size();
+        return value().size();
     }
     std::uint8_t const*
     data() const
     {
-        return reinterpret_cast<
-            std::uint8_t const*>(value_.data());
+        return value().data();
+    }
+    bool
+    shared() const noexcept
+    {
+        return owner_ != nullptr;
     }
     SerializedTypeID
     getSType () const override
@@ -66,39 +72,46 @@ public:
         assert (fName->isBinary ());
         assert ((fName->fieldType == STI_VL) ||
             (fName->fieldType == STI_ACCOUNT));
-        s.addVL (value_.data (), value_.size ());
+        s.addVL (data (), size ());
     }
     STBlob&
     operator= (Slice const& slice)
     {
         value_ = Buffer(slice.data(), slice.size());
+        owner_.reset();
         return *this;
     }
     value_type
     value() const noexcept
     {
+        if (owner_)
+            return shared_;
         return value_;
     }
     STBlob&
     operator= (Buffer&& buffer)
     {
         value_ = std::move(buffer);
+        owner_.reset();
         return *this;
     }
     void
     setValue (Buffer&& b)
     {
         value_ = std::move (b);
+        owner_.reset();
     }
     bool
     isEquivalent (const STBase& t) const override;
     bool
     isDefault () const override
     {
-        return value_.empty ();
+        return value().empty ();
     }
 private:
     Buffer value_;
+    std::shared_ptr<void const> owner_;
+    Slice shared_;
 };
 } 
 #endif
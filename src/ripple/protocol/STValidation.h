@@ -100,6 +100,8 @@ public:
     }
     uint256
     getSigningHash() const;
+    Blob
+    getSigningData() const;
     void
     setTrusted()
     {
@@ -11,6 +11,7 @@
 #include <cassert>
 #include <cstdint>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <type_traits>
 namespace ripple {
@@ -246,6 +247,7 @@ private:
     std::uint8_t const* p_;
     std::size_t remain_;
     std::size_t used_ = 0;
+    std::shared_ptr<void const> owner_;
 public:
     SerialIter (void const* data,
             std::size_t size) noexcept;
@@ -253,6 +255,11 @@ public:
         : SerialIter(slice.data(), slice.size())
     {
     }
+    SerialIter (Slice const& slice, std::shared_ptr<void const> owner)
+        : SerialIter(slice.data(), slice.size())
+    {
+        owner_ = std::move(owner);
+    }
     template<int N>
     explicit SerialIter (std::uint8_t const (&data)[N])
         : SerialIter(&data[0], N)
@@ -271,6 +278,11 @@ public:
     {
         return static_cast<int>(remain_);
     }
+    std::shared_ptr<void const> const&
+    owner() const noexcept
+    {
+        return owner_;
+    }
     unsigned char
     get8();
     std::uint16_t
@@ -7,6 +7,7 @@
 #include <boost/multiprecision/cpp_int.hpp>
 #include <ed25519-donna/ed25519.h>
 #include <type_traits>
+#include <vector>
 namespace ripple {
 std::ostream&
 operator<<(std::ostream& os, PublicKey const& pk)
@@ -227,6 +228,50 @@ verify (PublicKey const& publicKey,
     }
     return false;
 }
+bool
+verifyBatch (SignedMessage const* items, bool* valid, std::size_t count)
+{
+    std::vector<std::size_t> index;
+    std::vector<unsigned char const*> m;
+    std::vector<std::size_t> mlen;
+    std::vector<unsigned char const*> pk;
+    std::vector<unsigned char const*> rs;
+    index.reserve (count);
+    m.reserve (count);
+    mlen.reserve (count);
+    pk.reserve (count);
+    rs.reserve (count);
+    bool result = true;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto const& item = items[i];
+        auto const type = publicKeyType (*item.publicKey);
+        if (type == KeyType::ed25519 && ed25519Canonical (item.signature))
+        {
+            index.push_back (i);
+            m.push_back (item.message.data ());
+            mlen.push_back (item.message.size ());
+            pk.push_back (item.publicKey->data () + 1);
+            rs.push_back (item.signature.data ());
+            continue;
+        }
+        valid[i] = type && *type == KeyType::secp256k1 &&
+            verify (*item.publicKey, item.message, item.signature,
+                item.mustBeFullyCanonical);
+        result = result && valid[i];
+    }
+    if (index.empty ())
+        return result;
+    std::vector<int> ok (index.size ());
+    ed25519_sign_open_batch (m.data (), mlen.data (), pk.data (),
+        rs.data (), index.size (), ok.data ());
+    for (std::size_t j = 0; j < index.size (); ++j)
+    {
+        valid[index[j]] = ok[j] != 0;
+        result = result && valid[index[j]];
+    }
+    return result;
+}
 NodeID
 calcNodeID (PublicKey const& pk)
 {
@@ -1,5 +1,7 @@
 
 #include <ripple/protocol/SOTemplate.h>
+#include <algorithm>
+#include <numeric>
 namespace ripple {
 SOTemplate::SOTemplate (
     std::initializer_list<SOElement> uniqueFields,
@@ -18,6 +20,14 @@ SOTemplate::SOTemplate (
             Throw<std::runtime_error> ("Duplicate field index for SOTemplate.");
         indices_[sField.getNum ()] = i;
     }
+    order_.resize (elements_.size ());
+    std::iota (order_.begin (), order_.end (), 0);
+    std::sort (order_.begin (), order_.end (),
+        [this] (int lhs, int rhs)
+        {
+            return elements_[lhs].sField ().fieldCode <
+                elements_[rhs].sField ().fieldCode;
+        });
 }
 int SOTemplate::getIndex (SField const& sField) const
 {
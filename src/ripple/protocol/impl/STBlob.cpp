@@ -4,18 +4,26 @@
 namespace ripple {
 STBlob::STBlob (SerialIter& st, SField const& name)
     : STBase (name)
-    , value_ (st.getVLBuffer ())
 {
+    if (st.owner ())
+    {
+        shared_ = st.getSlice (st.getVLDataLength ());
+        owner_ = st.owner ();
+    }
+    else
+    {
+        value_ = st.getVLBuffer ();
+    }
 }
 std::string
 STBlob::getText () const
 {
-    return strHex (value_);
+    return strHex (value ());
 }
 bool
 STBlob::isEquivalent (const STBase& t) const
 {
     const STBlob* v = dynamic_cast<const STBlob*> (&t);
-    return v && (value_ == v->value_);
+    return v && (value () == v->value ());
 }
 } 
@@ -79,40 +79,50 @@ void STObject::applyTemplate (const SOTemplate& type) noexcept (false)
         Throw<FieldErr> (text);
     };
     mType = &type;
-    decltype(v_) v;
-    v.reserve(type.size());
+    std::vector<int> slots (type.size (), -1);
+    SField const* disallowed = nullptr;
+    for (std::size_t i = 0; i < v_.size (); ++i)
+    {
+        SField const& f = v_[i]->getFName ();
+        auto const index = f.getNum () > 0 ? type.getIndex (f) : -1;
+        if (index != -1 && slots[index] == -1)
+            slots[index] = i;
+        else if (! disallowed && ! f.isDiscardable ())
+            disallowed = &f;
+    }
+    auto slot = slots.cbegin ();
     for (auto const& e : type)
     {
-        auto const iter = std::find_if(
-            v_.begin(), v_.end(), [&](detail::STVar const& b)
-                { return b.get().getFName() == e.sField(); });
-        if (iter != v_.end())
+        auto const i = *slot++;
+        if (i != -1)
         {
-            if ((e.style() == soeDEFAULT) && iter->get().isDefault())
+            if ((e.style() == soeDEFAULT) && v_[i].get().isDefault())
             {
                 throwFieldErr (e.sField().fieldName,
                     "may not be explicitly set to default.");
             }
-            v.emplace_back(std::move(*iter));
-            v_.erase(iter);
         }
-        else
+        else if (e.style() == soeREQUIRED)
         {
-            if (e.style() == soeREQUIRED)
-            {
-                throwFieldErr (e.sField().fieldName,
-                    "is required but missing.");
-            }
-            v.emplace_back(detail::nonPresentObject, e.sField());
+            throwFieldErr (e.sField().fieldName,
+                "is required but missing.");
         }
     }
-    for (auto const& e : v_)
+    if (disallowed)
     {
-        if (! e->getFName().isDiscardable())
-        {
-            throwFieldErr (e->getFName().getName(),
-                "found in disallowed location.");
-        }
+        throwFieldErr (disallowed->getName(),
+            "found in disallowed location.");
+    }
+    decltype(v_) v;
+    v.reserve(type.size());
+    slot = slots.cbegin ();
+    for (auto const& e : type)
+    {
+        auto const i = *slot++;
+        if (i != -1)
+            v.emplace_back(std::move(v_[i]));
+        else
+            v.emplace_back(detail::nonPresentObject, e.sField());
     }
     v_.swap(v);
 }
@@ -547,20 +557,36 @@ bool STObject::operator== (const STObject& obj) const
         return false;
     return true;
 }
+static
+void
+addField (Serializer& s, STBase const& field)
+{
+    SerializedTypeID const sType {field.getSType()};
+    assert ((sType != STI_OBJECT) ||
+        (field.getFName().fieldType == STI_OBJECT));
+    field.addFieldID (s);
+    field.add (s);
+    if (sType == STI_ARRAY || sType == STI_OBJECT)
+        s.addFieldID (sType, 1);
+}
 void STObject::add (Serializer& s, WhichFields whichFields) const
 {
-    std::vector<STBase const*> const
-        fields {getSortedFields (*this, whichFields)};
-    for (STBase const* const field : fields)
+    if (mType != nullptr && v_.size () == mType->size ())
     {
-        SerializedTypeID const sType {field->getSType()};
-        assert ((sType != STI_OBJECT) ||
-            (field->getFName().fieldType == STI_OBJECT));
-        field->addFieldID (s);
-        field->add (s);
-        if (sType == STI_ARRAY || sType == STI_OBJECT)
-            s.addFieldID (sType, 1);
+        for (int const index : mType->order ())
+        {
+            STBase const& field = v_[index].get();
+            assert (mType->getIndex (field.getFName()) == index);
+            if ((field.getSType() != STI_NOTPRESENT) &&
+                field.getFName().shouldInclude (whichFields))
+            {
+                addField (s, field);
+            }
+        }
+        return;
     }
+    for (STBase const* const field : getSortedFields (*this, whichFields))
+        addField (s, *field);
 }
 std::vector<STBase const*>
 STObject::getSortedFields (
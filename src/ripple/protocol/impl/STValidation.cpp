@@ -48,6 +48,13 @@ uint256 STValidation::getSigningHash () const
 {
     return STObject::getSigningHash (HashPrefix::validation);
 }
+Blob STValidation::getSigningData () const
+{
+    Serializer s;
+    s.add32 (HashPrefix::validation);
+    addWithoutSigningFields (s);
+    return s.getData ();
+}
 uint256 STValidation::getLedgerHash () const
 {
     return getFieldH256 (sfLedgerHash);
@@ -0,0 +1,353 @@
+#include <ripple/protocol/digest.h>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define RIPPLE_SHA512_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define RIPPLE_SHA512_BATCH_X86 0
+#endif
+namespace ripple {
+namespace detail {
+namespace sha512_batch {
+static std::uint64_t const K[80] =
+{
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+static std::uint64_t const IV[8] =
+{
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+using lanes_fn = void (*)(std::uint8_t const* data, std::size_t stride,
+    std::size_t blocks, std::uint64_t* state);
+struct Engine
+{
+    char const* name;
+    std::size_t lanes;
+    lanes_fn hash;
+};
+static
+std::size_t
+paddedBlocks (std::size_t size)
+{
+    return (size + 17 + 127) / 128;
+}
+static
+void
+pad (Slice const& message, std::uint8_t* out, std::size_t blocks)
+{
+    auto const size = message.size();
+    auto const total = blocks * 128;
+    if (size != 0)
+        std::memcpy (out, message.data(), size);
+    out[size] = 0x80;
+    std::memset (out + size + 1, 0, total - size - 1);
+    std::uint64_t bits = static_cast<std::uint64_t>(size) << 3;
+    for (int i = 1; i <= 8; ++i, bits >>= 8)
+        out[total - i] = static_cast<std::uint8_t>(bits);
+}
+#if RIPPLE_SHA512_BATCH_X86
+template <int N>
+__attribute__((target("avx2"), always_inline)) inline
+__m256i
+ror4 (__m256i x)
+{
+    return _mm256_or_si256 (
+        _mm256_srli_epi64 (x, N), _mm256_slli_epi64 (x, 64 - N));
+}
+__attribute__((target("avx2")))
+static
+void
+hashLanes4 (std::uint8_t const* data, std::size_t stride,
+    std::size_t blocks, std::uint64_t* state)
+{
+    auto const swap = _mm256_setr_epi8 (
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    auto const index = _mm256_setr_epi64x (0,
+        static_cast<long long>(stride),
+        static_cast<long long>(2 * stride),
+        static_cast<long long>(3 * stride));
+    __m256i s[8];
+    for (int i = 0; i < 8; ++i)
+        s[i] = _mm256_set1_epi64x (static_cast<long long>(IV[i]));
+    for (std::size_t block = 0; block < blocks; ++block)
+    {
+        auto const p = data + block * 128;
+        __m256i w[16];
+        auto a = s[0], b = s[1], c = s[2], d = s[3];
+        auto e = s[4], f = s[5], g = s[6], h = s[7];
+        for (int t = 0; t < 80; ++t)
+        {
+            __m256i x;
+            if (t < 16)
+            {
+                x = _mm256_shuffle_epi8 (_mm256_i64gather_epi64 (
+                    reinterpret_cast<long long const*>(p + 8 * t),
+                        index, 1), swap);
+            }
+            else
+            {
+                auto const w2 = w[(t - 2) & 15];
+                auto const w15 = w[(t - 15) & 15];
+                auto const s0 = _mm256_xor_si256 (
+                    _mm256_xor_si256 (ror4<1>(w15), ror4<8>(w15)),
+                        _mm256_srli_epi64 (w15, 7));
+                auto const s1 = _mm256_xor_si256 (
+                    _mm256_xor_si256 (ror4<19>(w2), ror4<61>(w2)),
+                        _mm256_srli_epi64 (w2, 6));
+                x = _mm256_add_epi64 (
+                    _mm256_add_epi64 (w[t & 15], s0),
+                        _mm256_add_epi64 (w[(t - 7) & 15], s1));
+            }
+            w[t & 15] = x;
+            auto const S1 = _mm256_xor_si256 (
+                _mm256_xor_si256 (ror4<14>(e), ror4<18>(e)), ror4<41>(e));
+            auto const ch = _mm256_xor_si256 (
+                _mm256_and_si256 (e, f), _mm256_andnot_si256 (e, g));
+            auto const t1 = _mm256_add_epi64 (
+                _mm256_add_epi64 (_mm256_add_epi64 (h, S1), ch),
+                    _mm256_add_epi64 (x, _mm256_set1_epi64x (
+                        static_cast<long long>(K[t]))));
+            auto const S0 = _mm256_xor_si256 (
+                _mm256_xor_si256 (ror4<28>(a), ror4<34>(a)), ror4<39>(a));
+            auto const maj = _mm256_or_si256 (_mm256_and_si256 (a, b),
+                _mm256_and_si256 (c, _mm256_or_si256 (a, b)));
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi64 (d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi64 (t1, _mm256_add_epi64 (S0, maj));
+        }
+        s[0] = _mm256_add_epi64 (s[0], a);
+        s[1] = _mm256_add_epi64 (s[1], b);
+        s[2] = _mm256_add_epi64 (s[2], c);
+        s[3] = _mm256_add_epi64 (s[3], d);
+        s[4] = _mm256_add_epi64 (s[4], e);
+        s[5] = _mm256_add_epi64 (s[5], f);
+        s[6] = _mm256_add_epi64 (s[6], g);
+        s[7] = _mm256_add_epi64 (s[7], h);
+    }
+    for (int i = 0; i < 4; ++i)
+        _mm256_storeu_si256 (
+            reinterpret_cast<__m256i*>(state + 4 * i), s[i]);
+}
+template <int N>
+__attribute__((target("avx512f,avx512bw"), always_inline)) inline
+__m512i
+ror8 (__m512i x)
+{
+    return _mm512_ror_epi64 (x, N);
+}
+__attribute__((target("avx512f,avx512bw")))
+static
+void
+hashLanes8 (std::uint8_t const* data, std::size_t stride,
+    std::size_t blocks, std::uint64_t* state)
+{
+    auto const swap = _mm512_set_epi64 (
+        0x08090a0b0c0d0e0fLL, 0x0001020304050607LL,
+        0x08090a0b0c0d0e0fLL, 0x0001020304050607LL,
+        0x08090a0b0c0d0e0fLL, 0x0001020304050607LL,
+        0x08090a0b0c0d0e0fLL, 0x0001020304050607LL);
+    auto const lane = static_cast<long long>(stride);
+    auto const index = _mm512_set_epi64 (7 * lane, 6 * lane, 5 * lane,
+        4 * lane, 3 * lane, 2 * lane, lane, 0);
+    __m512i s[8];
+    for (int i = 0; i < 8; ++i)
+        s[i] = _mm512_set1_epi64 (static_cast<long long>(IV[i]));
+    for (std::size_t block = 0; block < blocks; ++block)
+    {
+        auto const p = data + block * 128;
+        __m512i w[16];
+        auto a = s[0], b = s[1], c = s[2], d = s[3];
+        auto e = s[4], f = s[5], g = s[6], h = s[7];
+        for (int t = 0; t < 80; ++t)
+        {
+            __m512i x;
+            if (t < 16)
+            {
+                x = _mm512_shuffle_epi8 (_mm512_i64gather_epi64 (
+                    index, p + 8 * t, 1), swap);
+            }
+            else
+            {
+                auto const w2 = w[(t - 2) & 15];
+                auto const w15 = w[(t - 15) & 15];
+                auto const s0 = _mm512_ternarylogic_epi64 (ror8<1>(w15),
+                    ror8<8>(w15), _mm512_srli_epi64 (w15, 7), 0x96);
+                auto const s1 = _mm512_ternarylogic_epi64 (ror8<19>(w2),
+                    ror8<61>(w2), _mm512_srli_epi64 (w2, 6), 0x96);
+                x = _mm512_add_epi64 (
+                    _mm512_add_epi64 (w[t & 15], s0),
+                        _mm512_add_epi64 (w[(t - 7) & 15], s1));
+            }
+            w[t & 15] = x;
+            auto const S1 = _mm512_ternarylogic_epi64 (
+                ror8<14>(e), ror8<18>(e), ror8<41>(e), 0x96);
+            auto const ch = _mm512_ternarylogic_epi64 (e, f, g, 0xca);
+            auto const t1 = _mm512_add_epi64 (
+                _mm512_add_epi64 (_mm512_add_epi64 (h, S1), ch),
+                    _mm512_add_epi64 (x, _mm512_set1_epi64 (
+                        static_cast<long long>(K[t]))));
+            auto const S0 = _mm512_ternarylogic_epi64 (
+                ror8<28>(a), ror8<34>(a), ror8<39>(a), 0x96);
+            auto const maj = _mm512_ternarylogic_epi64 (a, b, c, 0xe8);
+            h = g;
+            g = f;
+            f = e;
+            e = _mm512_add_epi64 (d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm512_add_epi64 (t1, _mm512_add_epi64 (S0, maj));
+        }
+        s[0] = _mm512_add_epi64 (s[0], a);
+        s[1] = _mm512_add_epi64 (s[1], b);
+        s[2] = _mm512_add_epi64 (s[2], c);
+        s[3] = _mm512_add_epi64 (s[3], d);
+        s[4] = _mm512_add_epi64 (s[4], e);
+        s[5] = _mm512_add_epi64 (s[5], f);
+        s[6] = _mm512_add_epi64 (s[6], g);
+        s[7] = _mm512_add_epi64 (s[7], h);
+    }
+    for (int i = 0; i < 4; ++i)
+        _mm512_storeu_si512 (state + 8 * i, s[i]);
+}
+#endif
+static
+std::vector<Engine>
+detectEngines ()
+{
+    std::vector<Engine> engines;
+#if RIPPLE_SHA512_BATCH_X86
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx512f") &&
+            __builtin_cpu_supports ("avx512bw"))
+        engines.push_back ({"avx512", 8, &hashLanes8});
+    if (__builtin_cpu_supports ("avx2"))
+        engines.push_back ({"avx2", 4, &hashLanes4});
+#endif
+    return engines;
+}
+static
+std::vector<Engine> const&
+engines ()
+{
+    static std::vector<Engine> const e = detectEngines ();
+    return e;
+}
+static
+void
+hashGroup (Engine const& engine, Slice const* messages, uint256* digests,
+    std::size_t const* order, std::size_t blocks,
+        std::vector<std::uint8_t>& buffer)
+{
+    auto const stride = blocks * 128;
+    buffer.resize (engine.lanes * stride);
+    for (std::size_t i = 0; i < engine.lanes; ++i)
+        pad (messages[order[i]], buffer.data() + i * stride, blocks);
+    std::uint64_t state[4 * 8];
+    engine.hash (buffer.data(), stride, blocks, state);
+    for (std::size_t i = 0; i < engine.lanes; ++i)
+    {
+        auto out = digests[order[i]].begin();
+        for (int word = 0; word < 4; ++word)
+        {
+            auto const v = state[word * engine.lanes + i];
+            for (int shift = 56; shift >= 0; shift -= 8)
+                *out++ = static_cast<std::uint8_t>(v >> shift);
+        }
+    }
+}
+} 
+} 
+char const*
+sha512HalfBatchEngine ()
+{
+    auto const& engines = detail::sha512_batch::engines ();
+    if (engines.empty ())
+        return "scalar";
+    return engines.front().name;
+}
+void
+sha512HalfBatch (Slice const* messages, uint256* digests, std::size_t count)
+{
+    using namespace detail::sha512_batch;
+    auto const& available = engines ();
+    std::vector<std::size_t> order;
+    std::vector<std::size_t> blocks;
+    if (! available.empty () && count > 1)
+    {
+        order.resize (count);
+        std::iota (order.begin(), order.end(), std::size_t{0});
+        blocks.resize (count);
+        for (std::size_t i = 0; i < count; ++i)
+            blocks[i] = paddedBlocks (messages[i].size());
+        std::stable_sort (order.begin(), order.end(),
+            [&blocks](std::size_t x, std::size_t y)
+            {
+                return blocks[x] < blocks[y];
+            });
+    }
+    std::vector<std::uint8_t> buffer;
+    std::size_t i = 0;
+    while (i < order.size())
+    {
+        auto const group = blocks[order[i]];
+        auto j = i;
+        while (j < order.size() && blocks[order[j]] == group)
+            ++j;
+        for (auto const& engine : available)
+        {
+            while (j - i >= engine.lanes)
+            {
+                hashGroup (engine, messages, digests, &order[i], group,
+                    buffer);
+                i += engine.lanes;
+            }
+        }
+        for (; i < j; ++i)
+            digests[order[i]] = sha512Half (messages[order[i]]);
+    }
+    if (order.empty ())
+    {
+        for (std::size_t k = 0; k < count; ++k)
+            digests[k] = sha512Half (messages[k]);
+    }
+}
+} 
@@ -82,6 +82,10 @@ JSS ( alternatives );
 JSS ( amendment_blocked );          
 JSS ( amendments );                 
 JSS ( amount );                     
+JSS ( apply_arena_allocs );         
+JSS ( apply_arena_bytes );          
+JSS ( apply_arena_fallbacks );      
+JSS ( apply_arena_resets );         
 JSS ( asks );                       
 JSS ( assets );                     
 JSS ( authorized );                 
@@ -150,6 +154,7 @@ JSS ( dir_entry );
 JSS ( dir_index );                  
 JSS ( dir_root );                   
 JSS ( directory );                  
+JSS ( dropped );                    
 JSS ( drops );                      
 JSS ( duration_us );                
 JSS ( enabled );                    
@@ -162,6 +167,7 @@ JSS ( error_code );
 JSS ( error_exception );            
 JSS ( error_message );              
 JSS ( escrow );                     
+JSS ( eta_seconds );                
 JSS ( expand );                     
 JSS ( expected_ledger_size );       
 JSS ( expiration );                 
@@ -220,6 +226,7 @@ JSS ( last_close );
 JSS ( last_refresh_time );          
 JSS ( last_refresh_status );        
 JSS ( last_refresh_message );       
+JSS ( last_rotated );               
 JSS ( ledger );                     
 JSS ( ledger_current_index );       
 JSS ( ledger_data );                
@@ -230,6 +237,7 @@ JSS ( ledger_index_max );
 JSS ( ledger_index_min );           
 JSS ( ledger_max );                 
 JSS ( ledger_min );                 
+JSS ( ledger_server );              
 JSS ( ledger_time );                
 JSS ( levels );                     
 JSS ( limit );                      
@@ -284,17 +292,21 @@ JSS ( no_ripple_peer );
 JSS ( node );                       
 JSS ( node_binary );                
 JSS ( node_hit_rate );              
+JSS ( node_hot_reads_hit );         
+JSS ( node_hot_reads_total );       
 JSS ( node_read_bytes );            
 JSS ( node_reads_hit );             
 JSS ( node_reads_total );           
 JSS ( node_writes );                
 JSS ( node_written_bytes );         
 JSS ( nodes );                      
+JSS ( nodes_copied );               
 JSS ( obligations );                
 JSS ( offer );                      
 JSS ( offers );                     
 JSS ( offline );                    
 JSS ( offset );                     
+JSS ( online_delete );              
 JSS ( open );                       
 JSS ( open_ledger_fee );            
 JSS ( open_ledger_level );          
@@ -363,10 +375,14 @@ JSS ( search_depth );
 JSS ( secret );                     
 JSS ( seed );                       
 JSS ( seed_hex );                   
+JSS ( send_batches );               
 JSS ( send_currencies );            
+JSS ( send_latency_us );            
 JSS ( send_max );                   
 JSS ( seq );                        
 JSS ( seqNum );                     
+JSS ( served );                     
+JSS ( served_bytes );               
 JSS ( server_state );               
 JSS ( server_state_duration_us );   
 JSS ( server_status );              
@@ -406,7 +422,9 @@ JSS ( taker_gets );
 JSS ( taker_gets_funded );          
 JSS ( taker_pays );                 
 JSS ( taker_pays_funded );          
+JSS ( threads );                    
 JSS ( threshold );                  
+JSS ( throttled_us );               
 JSS ( ticket );                     
 JSS ( time );
 JSS ( timeouts );                   
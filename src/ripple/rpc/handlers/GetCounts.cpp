@@ -4,6 +4,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/basics/Arena.h>
 #include <ripple/basics/UptimeClock.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/json/json_value.h>
@@ -78,6 +79,22 @@ Json::Value getCountsJson(Application& app, int minObjectCount)
     ret[jss::node_reads_hit] = app.getNodeStore().getFetchHitCount();
     ret[jss::node_written_bytes] = app.getNodeStore().getStoreSize();
     ret[jss::node_read_bytes] = app.getNodeStore().getFetchSize();
+    if (auto const hotReads = app.getNodeStore().getHotFetchTotalCount())
+    {
+        ret[jss::node_hot_reads_total] = hotReads;
+        ret[jss::node_hot_reads_hit] =
+            app.getNodeStore().getHotFetchHitCount();
+    }
+    auto const& arena = Arena::totals();
+    if (auto const allocs = arena.allocations.load())
+    {
+        ret[jss::apply_arena_allocs] = static_cast<Json::UInt> (allocs);
+        ret[jss::apply_arena_bytes] = std::to_string (arena.bytes.load());
+        ret[jss::apply_arena_fallbacks] =
+            static_cast<Json::UInt> (arena.fallbacks.load());
+        ret[jss::apply_arena_resets] =
+            static_cast<Json::UInt> (arena.resets.load());
+    }
     if (auto shardStore = app.getShardStore())
     {
         Json::Value& jv = (ret[jss::shards] = Json::objectValue);
@@ -287,11 +287,13 @@ ServerHandlerImp::onWSMessage(
         {
             auto const jr =
                 this->processSession(session, coro, jv);
-            auto const s = to_string(jr);
-            auto const n = s.length();
-            boost::beast::multi_buffer sb(n);
-            sb.commit(boost::asio::buffer_copy(
-                sb.prepare(n), boost::asio::buffer(s.c_str(), n)));
+            boost::beast::multi_buffer sb;
+            Json::stream(jr,
+                [&sb](auto const p, auto const n)
+                {
+                    sb.commit(boost::asio::buffer_copy(
+                        sb.prepare(n), boost::asio::buffer(p, n)));
+                });
             session->send(std::make_shared<
                 StreambufWSMsg<decltype(sb)>>(std::move(sb)));
             session->complete();
@@ -438,7 +440,8 @@ ServerHandlerImp::processSession (std::shared_ptr<Session> const& session,
             if(iter != session->request().end())
                 return iter->value();
             return boost::beast::string_view{};
-        }());
+        }(),
+        session->request().version() >= 11);
     if(beast::rfc2616::is_keep_alive(session->request()))
         session->complete();
     else
@@ -462,7 +465,8 @@ void
 ServerHandlerImp::processRequest (Port const& port,
     std::string const& request, beast::IP::Endpoint const& remoteIPAddress,
         Output&& output, std::shared_ptr<JobQueue::Coro> coro,
-        boost::string_view forwardedFor, boost::string_view user)
+        boost::string_view forwardedFor, boost::string_view user,
+        bool chunked)
 {
     auto rpcJ = app_.journal ("RPC");
     Json::Value jsonOrig;
@@ -726,22 +730,21 @@ ServerHandlerImp::processRequest (Port const& port,
         else
             reply = std::move(r);
     }
-    auto response = to_string (reply);
     rpc_time_.notify (
         std::chrono::duration_cast <std::chrono::milliseconds> (
             std::chrono::high_resolution_clock::now () - start));
     ++rpc_requests_;
-    rpc_size_.notify (beast::insight::Event::value_type{response.size()});
-    response += '\n';
     if (auto stream = m_journal.debug())
     {
         static const int maxSize = 10000;
+        auto const response = to_string (reply);
         if (response.size() <= maxSize)
             stream << "Reply: " << response;
         else
             stream << "Reply: " << response.substr (0, maxSize);
     }
-    HTTPReply (200, response, output, rpcJ);
+    auto const bytes = HTTPReply (200, reply, chunked, output, rpcJ);
+    rpc_size_.notify (beast::insight::Event::value_type{bytes});
 }
 
 Handoff
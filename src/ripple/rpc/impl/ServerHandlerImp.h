@@ -121,7 +121,8 @@ private:
     processRequest (Port const& port, std::string const& request,
         beast::IP::Endpoint const& remoteIPAddress, Output&&,
         std::shared_ptr<JobQueue::Coro> coro,
-        boost::string_view forwardedFor, boost::string_view user);
+        boost::string_view forwardedFor, boost::string_view user,
+        bool chunked);
     Handoff
     statusResponse(http_request_type const& request) const;
 };
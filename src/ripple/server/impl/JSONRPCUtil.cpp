@@ -4,8 +4,10 @@
 #include <ripple/protocol/jss.h>
 #include <ripple/protocol/BuildInfo.h>
 #include <ripple/protocol/SystemParameters.h>
+#include <ripple/json/json_writer.h>
 #include <ripple/json/to_string.h>
 #include <boost/algorithm/string.hpp>
+#include <sstream>
 namespace ripple {
 std::string getHTTPHeaderTimestamp ()
 {
@@ -23,6 +25,24 @@ std::string getHTTPHeaderTimestamp ()
         &now_gmt);
     return std::string (buffer);
 }
+static void writeHeaders (int nStatus, Json::Output const& output)
+{
+    switch (nStatus)
+    {
+    case 200: output ("HTTP/1.1 200 OK\r\n"); break;
+    case 400: output ("HTTP/1.1 400 Bad Request\r\n"); break;
+    case 403: output ("HTTP/1.1 403 Forbidden\r\n"); break;
+    case 404: output ("HTTP/1.1 404 Not Found\r\n"); break;
+    case 500: output ("HTTP/1.1 500 Internal Server Error\r\n"); break;
+    case 503: output ("HTTP/1.1 503 Server is overloaded\r\n"); break;
+    }
+    output (getHTTPHeaderTimestamp ());
+    output ("Connection: Keep-Alive\r\n"
+            "Content-Type: application/json; charset=UTF-8\r\n");
+    output ("Server: " + systemName () + "-json-rpc/");
+    output (BuildInfo::getFullVersionString ());
+    output ("\r\n");
+}
 void HTTPReply (
     int nStatus, std::string const& content, Json::Output const& output, beast::Journal j)
 {
@@ -51,26 +71,63 @@ void HTTPReply (
                     "<BODY><H1>401 Unauthorized.</H1></BODY>\r\n");
         return;
     }
-    switch (nStatus)
-    {
-    case 200: output ("HTTP/1.1 200 OK\r\n"); break;
-    case 400: output ("HTTP/1.1 400 Bad Request\r\n"); break;
-    case 403: output ("HTTP/1.1 403 Forbidden\r\n"); break;
-    case 404: output ("HTTP/1.1 404 Not Found\r\n"); break;
-    case 500: output ("HTTP/1.1 500 Internal Server Error\r\n"); break;
-    case 503: output ("HTTP/1.1 503 Server is overloaded\r\n"); break;
-    }
-    output (getHTTPHeaderTimestamp ());
-    output ("Connection: Keep-Alive\r\n"
-            "Content-Length: ");
+    writeHeaders (nStatus, output);
+    output ("Content-Length: ");
     output (std::to_string(content.size () + 2));
-    output ("\r\n"
-            "Content-Type: application/json; charset=UTF-8\r\n");
-    output ("Server: " + systemName () + "-json-rpc/");
-    output (BuildInfo::getFullVersionString ());
     output ("\r\n"
             "\r\n");
     output (content);
     output ("\r\n");
 }
+std::size_t HTTPReply (
+    int nStatus, Json::Value const& content, bool chunked,
+        Json::Output const& output, beast::Journal j)
+{
+    JLOG (j.trace())
+        << "HTTP Reply " << nStatus << " " << content;
+    std::size_t const chunkSize = 65536;
+    std::string buffer;
+    std::size_t bytes = 0;
+    bool streaming = false;
+    auto flush = [&]
+    {
+        if (! streaming)
+        {
+            writeHeaders (nStatus, output);
+            output ("Transfer-Encoding: chunked\r\n"
+                    "\r\n");
+            streaming = true;
+        }
+        std::stringstream chunk;
+        chunk << std::hex << buffer.size () << "\r\n";
+        output (chunk.str ());
+        buffer.append ("\r\n");
+        output (buffer);
+        buffer.clear ();
+    };
+    Json::stream (content,
+        [&](void const* data, std::size_t n)
+        {
+            buffer.append (static_cast<char const*> (data), n);
+            bytes += n;
+            if (chunked && buffer.size () >= chunkSize)
+                flush ();
+        });
+    if (! streaming)
+    {
+        writeHeaders (nStatus, output);
+        output ("Content-Length: ");
+        output (std::to_string (buffer.size () + 2));
+        output ("\r\n"
+                "\r\n");
+        output (buffer);
+        output ("\r\n");
+        return bytes;
+    }
+    if (! buffer.empty ())
+        flush ();
+    output ("0\r\n"
+            "\r\n");
+    return bytes;
+}
 } 
@@ -1,9 +1,13 @@
 #ifndef RIPPLE_SERVER_JSONRPCUTIL_H_INCLUDED
 #define RIPPLE_SERVER_JSONRPCUTIL_H_INCLUDED
+#include <ripple/beast/utility/Journal.h>
 #include <ripple/json/json_value.h>
 #include <ripple/json/Output.h>
 namespace ripple {
 void HTTPReply (
     int nStatus, std::string const& strMsg, Json::Output const&, beast::Journal j);
+std::size_t HTTPReply (
+    int nStatus, Json::Value const& content, bool chunked,
+        Json::Output const&, beast::Journal j);
 } 
 #endif
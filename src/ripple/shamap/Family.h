@@ -1,10 +1,12 @@
 #ifndef RIPPLE_SHAMAP_FAMILY_H_INCLUDED
 #define RIPPLE_SHAMAP_FAMILY_H_INCLUDED
 #include <ripple/basics/Log.h>
+#include <ripple/basics/TaskPool.h>
 #include <ripple/shamap/FullBelowCache.h>
 #include <ripple/shamap/TreeNodeCache.h>
 #include <ripple/nodestore/Database.h>
 #include <ripple/beast/utility/Journal.h>
+#include <cstddef>
 #include <cstdint>
 namespace ripple {
 class Family
@@ -36,6 +38,12 @@ public:
     bool
     isShardBacked() const = 0;
     virtual
+    TaskPool&
+    flushPool() = 0;
+    virtual
+    std::size_t
+    prefetchWindow() const = 0;
+    virtual
     void
     missing_node (std::uint32_t refNum) = 0;
     virtual
@@ -101,6 +101,8 @@ public:
     const_iterator upper_bound(uint256 const& id) const;
     void visitNodes (std::function<bool (
         SHAMapAbstractNode&)> const& function) const;
+    bool visitBranch (int branch, std::function<bool (
+        SHAMapAbstractNode&)> const& function) const;
     void visitDifferences(SHAMap const* have,
         std::function<bool (SHAMapAbstractNode&)>) const;
     void visitLeaves(std::function<void (
@@ -181,6 +183,9 @@ private:
         int branch, SHAMapSyncFilter* filter) const;
     std::shared_ptr<SHAMapAbstractNode>
         descendNoStore (std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
+    void prefetch (SHAMapInnerNode* parent, int branch = 0) const;
+    bool visitChildren (std::shared_ptr<SHAMapInnerNode> node,
+        std::function<bool (SHAMapAbstractNode&)> const& function) const;
     std::shared_ptr<SHAMapItem const> const& onlyBelow (SHAMapAbstractNode*) const;
     bool hasInnerNode (SHAMapNodeID const& nodeID, SHAMapHash const& hash) const;
     bool hasLeafNode (uint256 const& tag, SHAMapHash const& hash) const;
@@ -190,6 +195,16 @@ private:
                      std::shared_ptr<SHAMapItem const> const& otherMapItem,
                      bool isFirstMap, Delta & differences, int & maxCount) const;
     int walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq);
+    std::shared_ptr<SHAMapAbstractNode>
+        flushNode (std::shared_ptr<SHAMapAbstractNode> node, bool doWrite,
+                   NodeObjectType t, std::uint32_t seq) const;
+    std::shared_ptr<SHAMapInnerNode>
+        flushSubTree (std::shared_ptr<SHAMapInnerNode> node, bool doWrite,
+                      NodeObjectType t, std::uint32_t seq, int& flushed) const;
+    std::shared_ptr<SHAMapInnerNode>
+        flushSubTreeParallel (std::shared_ptr<SHAMapInnerNode> node,
+                              bool doWrite, NodeObjectType t, std::uint32_t seq,
+                              TaskPool& pool, int& flushed) const;
     bool isInconsistentNode(std::shared_ptr<SHAMapAbstractNode> const& node) const;
     struct MissingNodes
     {
@@ -4,10 +4,12 @@
 #include <ripple/shamap/SHAMapNodeID.h>
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/beast/utility/Journal.h>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
-#include <mutex>
 #include <string>
+#include <vector>
 namespace ripple {
 enum SHANodeFormat
 {
@@ -91,6 +93,7 @@ public:
     virtual std::shared_ptr<SHAMapAbstractNode> clone(std::uint32_t seq) const = 0;
     virtual uint256 const& key() const = 0;
     virtual void invariants(bool is_v2, bool is_root = false) const = 0;
+    static void updateHashes (std::vector<SHAMapAbstractNode*> const& nodes);
     static std::shared_ptr<SHAMapAbstractNode>
         make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat format,
              SHAMapHash const& hash, bool hashValid, beast::Journal j,
@@ -100,13 +103,20 @@ class SHAMapInnerNodeV2;
 class SHAMapInnerNode
     : public SHAMapAbstractNode
 {
-    std::array<SHAMapHash, 16>          mHashes;
-    std::shared_ptr<SHAMapAbstractNode> mChildren[16];
-    int                             mIsBranch = 0;
+    void*                           mArrays = nullptr;
     std::uint32_t                   mFullBelowGen = 0;
-    static std::mutex               childLock;
+    std::uint16_t                   mIsBranch = 0;
+    std::uint8_t                    mCapacity = 0;
+    mutable std::atomic<std::uint16_t> lock_ {0};
+    SHAMapHash* hashes () const;
+    std::shared_ptr<SHAMapAbstractNode>* children () const;
+    int getChildIndex (int branch) const;
+    void resizeChildArrays (std::uint16_t isBranch);
+    void setHashes (std::array<SHAMapHash, 16> const& hashes);
 public:
     SHAMapInnerNode(std::uint32_t seq);
+    ~SHAMapInnerNode();
+    static std::size_t childArrayBytes ();
     std::shared_ptr<SHAMapAbstractNode> clone(std::uint32_t seq) const override;
     bool isEmpty () const;
     bool isEmptyBranch (int m) const;
@@ -122,6 +132,7 @@ public:
     void setFullBelowGen (std::uint32_t gen);
     bool updateHash () override;
     void updateHashDeep();
+    void updateChildHashes();
     void addRaw (Serializer&, SHANodeFormat format) const override;
     std::string getString (SHAMapNodeID const&) const override;
     uint256 const& key() const override;
@@ -253,6 +264,31 @@ SHAMapInnerNode::SHAMapInnerNode(std::uint32_t seq)
 {
 }
 inline
+SHAMapHash*
+SHAMapInnerNode::hashes () const
+{
+    return static_cast<SHAMapHash*>(mArrays);
+}
+inline
+std::shared_ptr<SHAMapAbstractNode>*
+SHAMapInnerNode::children () const
+{
+    return reinterpret_cast<std::shared_ptr<SHAMapAbstractNode>*>(
+        hashes() + mCapacity);
+}
+inline
+int
+SHAMapInnerNode::getChildIndex (int branch) const
+{
+    if (mCapacity == 16)
+        return branch;
+    int index = 0;
+    for (unsigned below = mIsBranch & ((1u << branch) - 1); below != 0;
+            below &= below - 1)
+        ++index;
+    return index;
+}
+inline
 bool
 SHAMapInnerNode::isEmptyBranch (int m) const
 {
@@ -262,8 +298,11 @@ inline
 SHAMapHash const&
 SHAMapInnerNode::getChildHash (int m) const
 {
+    static SHAMapHash const zero;
     assert ((m >= 0) && (m < 16) && (getType() == tnINNER));
-    return mHashes[m];
+    if (isEmptyBranch (m))
+        return zero;
+    return hashes()[getChildIndex (m)];
 }
 inline
 bool
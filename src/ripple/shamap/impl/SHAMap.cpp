@@ -409,6 +409,62 @@ SHAMap::descendAsync (SHAMapInnerNode* parent, int branch,
         ptr = parent->canonicalizeChild (branch, std::move(ptr));
     return ptr.get ();
 }
+void
+SHAMap::prefetch (SHAMapInnerNode* parent, int branch) const
+{
+    if (!backed_)
+        return;
+    auto const window = f_.prefetchWindow ();
+    auto& db = f_.db ();
+    auto const full = [&]
+    {
+        return db.getAsyncReadCount () >= window;
+    };
+    if (window == 0 || full ())
+        return;
+    std::vector<std::shared_ptr<SHAMapInnerNode>> decoded;
+    auto issue = [&](SHAMapInnerNode* node, int first, bool expand)
+    {
+        for (int i = first; i < 16; ++i)
+        {
+            if (node->isEmptyBranch (i) || node->getChildPointer (i))
+                continue;
+            auto const& hash = node->getChildHash (i);
+            if (getCache (hash))
+                continue;
+            if (full ())
+                return;
+            std::shared_ptr<NodeObject> obj;
+            if (! db.asyncFetch (hash.as_uint256(), ledgerSeq_, obj))
+                continue;
+            if (!obj)
+                continue;
+            std::shared_ptr<SHAMapAbstractNode> ptr;
+            try
+            {
+                ptr = SHAMapAbstractNode::make (makeSlice (obj->getData()),
+                    0, snfPREFIX, hash, true, f_.journal());
+            }
+            catch (std::exception const&)
+            {
+                continue;
+            }
+            if (!ptr)
+                continue;
+            canonicalize (hash, ptr);
+            if (expand && ptr->isInner ())
+                decoded.push_back (
+                    std::static_pointer_cast<SHAMapInnerNode>(ptr));
+        }
+    };
+    issue (parent, branch, true);
+    for (auto const& node : decoded)
+    {
+        if (full ())
+            break;
+        issue (node.get (), 0, false);
+    }
+}
 template <class Node>
 std::shared_ptr<Node>
 SHAMap::unshareNode (std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
@@ -451,6 +507,7 @@ SHAMap::firstBelow(std::shared_ptr<SHAMapAbstractNode> node,
             stack.push({inner, stack.top().second.getChildNodeID(branch)});
         }
     }
+    prefetch (inner.get ());
     for (int i = 0; i < 16;)
     {
         if (!inner->isEmptyBranch(i))
@@ -473,6 +530,7 @@ SHAMap::firstBelow(std::shared_ptr<SHAMapAbstractNode> node,
             {
                 stack.push({inner, stack.top().second.getChildNodeID(branch)});
             }
+            prefetch (inner.get ());
             i = 0;  
         }
         else
@@ -945,17 +1003,13 @@ int
 SHAMap::walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq)
 {
     int flushed = 0;
-    Serializer s;
     if (!root_ || (root_->getSeq() == 0))
         return flushed;
     if (root_->isLeaf())
     { 
         root_ = preFlushNode (std::move(root_));
         root_->updateHash();
-        if (doWrite && backed_)
-            root_ = writeNode(t, seq, std::move(root_));
-        else
-            root_->setSeq (0);
+        root_ = flushNode (std::move(root_), doWrite, t, seq);
         return 1;
     }
     auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
@@ -967,64 +1021,136 @@ SHAMap::walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq)
             root_ = std::make_shared<SHAMapInnerNode>(0);
         return 1;
     }
-    using StackEntry = std::pair <std::shared_ptr<SHAMapInnerNode>, int>;
-    std::stack <StackEntry, std::vector<StackEntry>> stack;
     node = preFlushNode(std::move(node));
-    int pos = 0;
-    while (1)
+    auto& pool = f_.flushPool();
+    if (pool.concurrency() > 1)
+        root_ = flushSubTreeParallel (std::move(node), doWrite, t, seq,
+            pool, flushed);
+    else
+        root_ = flushSubTree (std::move(node), doWrite, t, seq, flushed);
+    return flushed;
+}
+std::shared_ptr<SHAMapAbstractNode>
+SHAMap::flushNode (std::shared_ptr<SHAMapAbstractNode> node, bool doWrite,
+    NodeObjectType t, std::uint32_t seq) const
+{
+    if (doWrite && backed_)
+        return writeNode(t, seq, std::move(node));
+    node->setSeq (0);
+    return node;
+}
+std::shared_ptr<SHAMapInnerNode>
+SHAMap::flushSubTree (std::shared_ptr<SHAMapInnerNode> node, bool doWrite,
+    NodeObjectType t, std::uint32_t seq, int& flushed) const
+{
+    struct DirtyNode
+    {
+        std::shared_ptr<SHAMapAbstractNode> node;
+        SHAMapInnerNode* parent;
+        int branch;
+        int depth;
+    };
+    std::vector<DirtyNode> dirty;
+    dirty.push_back ({std::move(node), nullptr, 0, 0});
+    for (std::size_t i = 0; i < dirty.size(); ++i)
     {
-        while (pos < 16)
+        if (!dirty[i].node->isInner ())
+            continue;
+        auto inner = static_cast<SHAMapInnerNode*>(dirty[i].node.get());
+        assert (inner->getSeq() == seq_);
+        for (int branch = 0; branch < 16; ++branch)
         {
-            if (node->isEmptyBranch (pos))
+            if (inner->isEmptyBranch (branch))
+                continue;
+            auto child = inner->getChild (branch);
+            if (child && (child->getSeq() != 0))
             {
-                ++pos;
-            }
-            else
-            {
-                int branch = pos;
-                auto child = node->getChild(pos++);
-                if (child && (child->getSeq() != 0))
-                {
-                    child = preFlushNode(std::move(child));
-                    if (child->isInner ())
-                    {
-                        stack.emplace (std::move (node), branch);
-                        node = std::static_pointer_cast<SHAMapInnerNode>(std::move(child));
-                        pos = 0;
-                    }
-                    else
-                    {
-                        ++flushed;
-                        assert (node->getSeq() == seq_);
-                        child->updateHash();
-                        if (doWrite && backed_)
-                            child = writeNode(t, seq, std::move(child));
-                        else
-                            child->setSeq (0);
-                        node->shareChild (branch, child);
-                    }
-                }
+                child = preFlushNode(std::move(child));
+                inner->shareChild (branch, child);
+                dirty.push_back ({std::move(child), inner, branch,
+                    dirty[i].depth + 1});
             }
         }
-        node->updateHashDeep();
-        if (doWrite && backed_)
-            node = std::static_pointer_cast<SHAMapInnerNode>(writeNode(t, seq,
-                                                                       std::move(node)));
-        else
-            node->setSeq (0);
+    }
+    std::vector<SHAMapAbstractNode*> level;
+    auto end = dirty.size();
+    while (end != 0)
+    {
+        auto const depth = dirty[end - 1].depth;
+        auto begin = end;
+        while (begin != 0 && dirty[begin - 1].depth == depth)
+            --begin;
+        level.clear();
+        for (auto i = begin; i < end; ++i)
+        {
+            auto n = dirty[i].node.get();
+            if (n->isInner ())
+                static_cast<SHAMapInnerNode*>(n)->updateChildHashes();
+            level.push_back (n);
+        }
+        SHAMapAbstractNode::updateHashes (level);
+        end = begin;
+    }
+    for (auto i = dirty.size(); i-- > 1;)
+    {
+        auto& d = dirty[i];
+        d.node = flushNode(std::move(d.node), doWrite, t, seq);
+        d.parent->shareChild (d.branch, d.node);
         ++flushed;
-        if (stack.empty ())
-           break;
-        auto parent = std::move (stack.top().first);
-        pos = stack.top().second;
-        stack.pop();
-        assert (parent->getSeq() == seq_);
-        parent->shareChild (pos, node);
-        node = std::move (parent);
-        ++pos;
     }
-    root_ = std::move (node);
-    return flushed;
+    ++flushed;
+    return std::static_pointer_cast<SHAMapInnerNode>(
+        flushNode(std::move(dirty.front().node), doWrite, t, seq));
+}
+std::shared_ptr<SHAMapInnerNode>
+SHAMap::flushSubTreeParallel (std::shared_ptr<SHAMapInnerNode> node,
+    bool doWrite, NodeObjectType t, std::uint32_t seq,
+        TaskPool& pool, int& flushed) const
+{
+    struct SubTree
+    {
+        int branch;
+        std::shared_ptr<SHAMapInnerNode> node;
+        int flushed;
+    };
+    std::vector<SubTree> subtrees;
+    subtrees.reserve (16);
+    for (int branch = 0; branch < 16; ++branch)
+    {
+        if (node->isEmptyBranch (branch))
+            continue;
+        auto child = node->getChild (branch);
+        if (!child || (child->getSeq() == 0))
+            continue;
+        child = preFlushNode(std::move(child));
+        if (child->isInner ())
+        {
+            subtrees.push_back ({branch,
+                std::static_pointer_cast<SHAMapInnerNode>(std::move(child)), 0});
+        }
+        else
+        {
+            ++flushed;
+            child->updateHash();
+            child = flushNode(std::move(child), doWrite, t, seq);
+            node->shareChild (branch, child);
+        }
+    }
+    pool.forEach (subtrees.size(), [&](std::size_t i)
+    {
+        auto& st = subtrees[i];
+        st.node = flushSubTree (std::move(st.node), doWrite, t, seq,
+            st.flushed);
+    });
+    for (auto& st : subtrees)
+    {
+        node->shareChild (st.branch, st.node);
+        flushed += st.flushed;
+    }
+    node->updateHashDeep();
+    ++flushed;
+    return std::static_pointer_cast<SHAMapInnerNode>(
+        flushNode(std::move(node), doWrite, t, seq));
 }
 void SHAMap::dump (bool hash) const
 {
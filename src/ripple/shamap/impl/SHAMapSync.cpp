@@ -25,10 +25,34 @@ SHAMap::visitNodes(std::function<bool (
     function (*root_);
     if (! root_->isInner ())
         return;
+    visitChildren (std::static_pointer_cast<SHAMapInnerNode>(root_), function);
+}
+bool
+SHAMap::visitBranch(int branch, std::function<bool (
+    SHAMapAbstractNode&)> const& function) const
+{
+    assert (root_->isValid ());
+    if (! root_ || ! root_->isInner ())
+        return true;
+    auto const root = std::static_pointer_cast<SHAMapInnerNode>(root_);
+    if (root->isEmptyBranch (branch))
+        return true;
+    auto child = descendNoStore (root, branch);
+    if (! function (*child))
+        return false;
+    if (child->isLeaf ())
+        return true;
+    return visitChildren (
+        std::static_pointer_cast<SHAMapInnerNode>(child), function);
+}
+bool
+SHAMap::visitChildren(std::shared_ptr<SHAMapInnerNode> node,
+    std::function<bool (SHAMapAbstractNode&)> const& function) const
+{
     using StackEntry = std::pair <int, std::shared_ptr<SHAMapInnerNode>>;
     std::stack <StackEntry, std::vector <StackEntry>> stack;
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
     int pos = 0;
+    prefetch (node.get ());
     while (1)
     {
         while (pos < 16)
@@ -38,7 +62,7 @@ SHAMap::visitNodes(std::function<bool (
             {
                 std::shared_ptr<SHAMapAbstractNode> child = descendNoStore (node, pos);
                 if (! function (*child))
-                    return;
+                    return false;
                 if (child->isLeaf ())
                     ++pos;
                 else
@@ -51,6 +75,7 @@ SHAMap::visitNodes(std::function<bool (
                     }
                     node = std::static_pointer_cast<SHAMapInnerNode>(child);
                     pos = 0;
+                    prefetch (node.get ());
                 }
             }
             else
@@ -62,7 +87,9 @@ SHAMap::visitNodes(std::function<bool (
             break;
         std::tie(pos, node) = stack.top ();
         stack.pop ();
+        prefetch (node.get (), pos);
     }
+    return true;
 }
 void
 SHAMap::visitDifferences(SHAMap const* have,
@@ -93,6 +120,7 @@ SHAMap::visitDifferences(SHAMap const* have,
         stack.pop ();
         if (! function (*node))
             return;
+        prefetch (node);
         for (int i = 0; i < 16; ++i)
         {
             if (! node->isEmptyBranch (i))
@@ -4,27 +4,158 @@
 #include <ripple/basics/Log.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/basics/Slice.h>
+#include <ripple/basics/SlabAllocator.h>
+#include <ripple/basics/spinlock.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/beast/core/LexicalCast.h>
-#include <mutex>
 #include <openssl/sha.h>
 namespace ripple {
-std::mutex SHAMapInnerNode::childLock;
 SHAMapAbstractNode::~SHAMapAbstractNode() = default;
+static
+std::size_t
+childArrayCapacity (int branches)
+{
+    if (branches == 0)
+        return 0;
+    if (branches <= 2)
+        return 2;
+    if (branches <= 4)
+        return 4;
+    if (branches <= 6)
+        return 6;
+    return 16;
+}
+static
+SlabAllocator&
+childArrayPool (std::size_t capacity)
+{
+    static std::size_t const slot = sizeof(SHAMapHash) +
+        sizeof(std::shared_ptr<SHAMapAbstractNode>);
+    static SlabAllocator* const pools[] =
+    {
+        new SlabAllocator (2 * slot, 512),
+        new SlabAllocator (4 * slot, 256),
+        new SlabAllocator (6 * slot, 256),
+        new SlabAllocator (16 * slot, 128)
+    };
+    switch (capacity)
+    {
+    case 2: return *pools[0];
+    case 4: return *pools[1];
+    case 6: return *pools[2];
+    default:
+        break;
+    }
+    assert (capacity == 16);
+    return *pools[3];
+}
+SHAMapInnerNode::~SHAMapInnerNode()
+{
+    resizeChildArrays (0);
+}
+std::size_t
+SHAMapInnerNode::childArrayBytes ()
+{
+    std::size_t bytes = 0;
+    for (std::size_t capacity : {2, 4, 6, 16})
+    {
+        auto const& pool = childArrayPool (capacity);
+        bytes += pool.reserved () * pool.size ();
+    }
+    return bytes;
+}
+void
+SHAMapInnerNode::resizeChildArrays (std::uint16_t isBranch)
+{
+    if (isBranch == mIsBranch)
+        return;
+    int count = 0;
+    for (unsigned bits = isBranch; bits != 0; bits &= bits - 1)
+        ++count;
+    auto const capacity = childArrayCapacity (count);
+    if (capacity == 16 && mCapacity == 16)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            if ((isBranch & (1 << i)) == 0)
+            {
+                hashes()[i].zero();
+                children()[i].reset();
+            }
+        }
+        mIsBranch = isBranch;
+        return;
+    }
+    void* arrays = nullptr;
+    if (capacity != 0)
+    {
+        arrays = childArrayPool (capacity).allocate ();
+        auto const h = static_cast<SHAMapHash*>(arrays);
+        auto const c = reinterpret_cast<
+            std::shared_ptr<SHAMapAbstractNode>*>(h + capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            new (h + i) SHAMapHash ();
+            new (c + i) std::shared_ptr<SHAMapAbstractNode> ();
+        }
+        int index = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            if ((isBranch & (1 << i)) == 0)
+                continue;
+            auto const slot = (capacity == 16) ? i : index++;
+            if (!isEmptyBranch (i))
+            {
+                auto const old = getChildIndex (i);
+                h[slot] = hashes()[old];
+                c[slot] = std::move (children()[old]);
+            }
+        }
+    }
+    if (mArrays != nullptr)
+    {
+        for (std::size_t i = 0; i < mCapacity; ++i)
+        {
+            hashes()[i].~SHAMapHash ();
+            children()[i].~shared_ptr ();
+        }
+        childArrayPool (mCapacity).deallocate (mArrays);
+    }
+    mArrays = arrays;
+    mCapacity = static_cast<std::uint8_t>(capacity);
+    mIsBranch = isBranch;
+}
+void
+SHAMapInnerNode::setHashes (std::array<SHAMapHash, 16> const& hashes)
+{
+    std::uint16_t isBranch = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (hashes[i].isNonZero ())
+            isBranch |= (1 << i);
+    }
+    resizeChildArrays (isBranch);
+    for (int i = 0; i < 16; ++i)
+    {
+        if (!isEmptyBranch (i))
+            this->hashes()[getChildIndex (i)] = hashes[i];
+    }
+}
 std::shared_ptr<SHAMapAbstractNode>
 SHAMapInnerNode::clone(std::uint32_t seq) const
 {
     auto p = std::make_shared<SHAMapInnerNode>(seq);
     p->mHash = mHash;
-    p->mIsBranch = mIsBranch;
     p->mFullBelowGen = mFullBelowGen;
-    p->mHashes = mHashes;
-    std::lock_guard <std::mutex> lock(childLock);
-    for (int i = 0; i < 16; ++i)
+    p->resizeChildArrays (mIsBranch);
+    spinlock<std::uint16_t> sl(lock_);
+    std::lock_guard<spinlock<std::uint16_t>> lock(sl);
+    for (int i = 0; i < mCapacity; ++i)
     {
-        p->mChildren[i] = mChildren[i];
-        assert(std::dynamic_pointer_cast<SHAMapInnerNodeV2>(p->mChildren[i]) == nullptr);
+        p->hashes()[i] = hashes()[i];
+        p->children()[i] = children()[i];
+        assert(std::dynamic_pointer_cast<SHAMapInnerNodeV2>(p->children()[i]) == nullptr);
     }
     return std::move(p);
 }
@@ -33,18 +164,19 @@ SHAMapInnerNodeV2::clone(std::uint32_t seq) const
 {
     auto p = std::make_shared<SHAMapInnerNodeV2>(seq);
     p->mHash = mHash;
-    p->mIsBranch = mIsBranch;
     p->mFullBelowGen = mFullBelowGen;
-    p->mHashes = mHashes;
+    p->resizeChildArrays (mIsBranch);
     p->common_ = common_;
     p->depth_ = depth_;
-    std::lock_guard <std::mutex> lock(childLock);
-    for (int i = 0; i < 16; ++i)
+    spinlock<std::uint16_t> sl(lock_);
+    std::lock_guard<spinlock<std::uint16_t>> lock(sl);
+    for (int i = 0; i < mCapacity; ++i)
     {
-        p->mChildren[i] = mChildren[i];
-        if (p->mChildren[i] != nullptr)
-            assert(std::dynamic_pointer_cast<SHAMapInnerNodeV2>(p->mChildren[i]) != nullptr ||
-                   std::dynamic_pointer_cast<SHAMapTreeNode>(p->mChildren[i]) != nullptr);
+        p->hashes()[i] = hashes()[i];
+        p->children()[i] = children()[i];
+        if (p->children()[i] != nullptr)
+            assert(std::dynamic_pointer_cast<SHAMapInnerNodeV2>(p->children()[i]) != nullptr ||
+                   std::dynamic_pointer_cast<SHAMapTreeNode>(p->children()[i]) != nullptr);
     }
     return std::move(p);
 }
@@ -110,12 +242,10 @@ SHAMapAbstractNode::make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat
             if (len != 512)
                 Throw<std::runtime_error> ("invalid FI node");
             auto ret = std::make_shared<SHAMapInnerNode>(seq);
+            std::array<SHAMapHash, 16> hashes;
             for (int i = 0; i < 16; ++i)
-            {
-                s.get256 (ret->mHashes[i].as_uint256(), i * 32);
-                if (ret->mHashes[i].isNonZero ())
-                    ret->mIsBranch |= (1 << i);
-            }
+                s.get256 (hashes[i].as_uint256(), i * 32);
+            ret->setHashes (hashes);
             if (hashValid)
                 ret->mHash = hash;
             else
@@ -125,6 +255,7 @@ SHAMapAbstractNode::make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat
         else if (type == 3)
         {
             auto ret = std::make_shared<SHAMapInnerNode>(seq);
+            std::array<SHAMapHash, 16> hashes;
             for (int i = 0; i < (len / 33); ++i)
             {
                 int pos;
@@ -132,10 +263,9 @@ SHAMapAbstractNode::make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat
                     Throw<std::runtime_error> ("short CI node");
                 if ((pos < 0) || (pos >= 16))
                     Throw<std::runtime_error> ("invalid CI node");
-                s.get256 (ret->mHashes[pos].as_uint256(), i * 33);
-                if (ret->mHashes[pos].isNonZero ())
-                    ret->mIsBranch |= (1 << pos);
+                s.get256 (hashes[pos].as_uint256(), i * 33);
             }
+            ret->setHashes (hashes);
             if (hashValid)
                 ret->mHash = hash;
             else
@@ -161,12 +291,10 @@ SHAMapAbstractNode::make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat
             if (len != 512)
                 Throw<std::runtime_error> ("invalid FI node");
             auto ret = std::make_shared<SHAMapInnerNodeV2>(seq);
+            std::array<SHAMapHash, 16> hashes;
             for (int i = 0; i < 16; ++i)
-            {
-                s.get256 (ret->mHashes[i].as_uint256(), i * 32);
-                if (ret->mHashes[i].isNonZero ())
-                    ret->mIsBranch |= (1 << i);
-            }
+                s.get256 (hashes[i].as_uint256(), i * 32);
+            ret->setHashes (hashes);
             ret->set_common(id.getDepth(), id.getNodeID());
             if (hashValid)
                 ret->mHash = hash;
@@ -177,6 +305,7 @@ SHAMapAbstractNode::make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat
         else if (type == 6)
         {
             auto ret = std::make_shared<SHAMapInnerNodeV2>(seq);
+            std::array<SHAMapHash, 16> hashes;
             for (int i = 0; i < (len / 33); ++i)
             {
                 int pos;
@@ -184,10 +313,9 @@ SHAMapAbstractNode::make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat
                     Throw<std::runtime_error> ("short CI node");
                 if ((pos < 0) || (pos >= 16))
                     Throw<std::runtime_error> ("invalid CI node");
-                s.get256 (ret->mHashes[pos].as_uint256(), i * 33);
-                if (ret->mHashes[pos].isNonZero ())
-                    ret->mIsBranch |= (1 << pos);
+                s.get256 (hashes[pos].as_uint256(), i * 33);
             }
+            ret->setHashes (hashes);
             ret->set_common(id.getDepth(), id.getNodeID());
             if (hashValid)
                 ret->mHash = hash;
@@ -248,12 +376,10 @@ SHAMapAbstractNode::make(Slice const& rawNode, std::uint32_t seq, SHANodeFormat
                 ret = std::make_shared<SHAMapInnerNodeV2>(seq);
             else
                 ret = std::make_shared<SHAMapInnerNode>(seq);
+            std::array<SHAMapHash, 16> hashes;
             for (int i = 0; i < 16; ++i)
-            {
-                s.get256 (ret->mHashes[i].as_uint256(), i * 32);
-                if (ret->mHashes[i].isNonZero ())
-                    ret->mIsBranch |= (1 << i);
-            }
+                s.get256 (hashes[i].as_uint256(), i * 32);
+            ret->setHashes (hashes);
             if (isV2)
             {
                 auto temp = std::static_pointer_cast<SHAMapInnerNodeV2>(ret);
@@ -306,8 +432,8 @@ SHAMapInnerNode::updateHash()
         sha512_half_hasher h;
         using beast::hash_append;
         hash_append(h, HashPrefix::innerNode);
-        for(auto const& hh : mHashes)
-            hash_append(h, hh);
+        for (int i = 0; i < 16; ++i)
+            hash_append(h, getChildHash (i));
         nh = static_cast<typename
             sha512_half_hasher::result_type>(h);
     }
@@ -319,12 +445,49 @@ SHAMapInnerNode::updateHash()
 void
 SHAMapInnerNode::updateHashDeep()
 {
-    for (auto pos = 0; pos < 16; ++pos)
+    updateChildHashes();
+    updateHash();
+}
+void
+SHAMapInnerNode::updateChildHashes()
+{
+    for (auto pos = 0; pos < mCapacity; ++pos)
     {
-        if (mChildren[pos] != nullptr)
-            mHashes[pos] = mChildren[pos]->getNodeHash();
+        if (children()[pos] != nullptr)
+            hashes()[pos] = children()[pos]->getNodeHash();
     }
-    updateHash();
+}
+void
+SHAMapAbstractNode::updateHashes (std::vector<SHAMapAbstractNode*> const& nodes)
+{
+    Serializer s (static_cast<int>(nodes.size() * 580));
+    std::vector<std::size_t> offsets;
+    std::vector<SHAMapAbstractNode*> hashed;
+    offsets.reserve (nodes.size() + 1);
+    hashed.reserve (nodes.size());
+    for (auto node : nodes)
+    {
+        if (node->isInner () &&
+            static_cast<SHAMapInnerNode const*>(node)->isEmpty ())
+        {
+            node->mHash.zero();
+            continue;
+        }
+        offsets.push_back (s.size());
+        node->addRaw (s, snfPREFIX);
+        hashed.push_back (node);
+    }
+    offsets.push_back (s.size());
+    auto const data = s.slice().data();
+    std::vector<Slice> messages;
+    messages.reserve (hashed.size());
+    for (std::size_t i = 0; i < hashed.size(); ++i)
+        messages.emplace_back (data + offsets[i],
+            offsets[i + 1] - offsets[i]);
+    std::vector<uint256> digests (hashed.size());
+    sha512HalfBatch (messages.data(), digests.data(), messages.size());
+    for (std::size_t i = 0; i < hashed.size(); ++i)
+        hashed[i]->mHash = SHAMapHash{digests[i]};
 }
 bool
 SHAMapTreeNode::updateHash()
@@ -370,25 +533,25 @@ SHAMapInnerNode::addRaw(Serializer& s, SHANodeFormat format) const
         if (format == snfPREFIX)
         {
             s.add32 (HashPrefix::innerNode);
-            for (auto const& hh : mHashes)
-                s.add256 (hh.as_uint256());
+            for (int i = 0; i < 16; ++i)
+                s.add256 (getChildHash (i).as_uint256());
         }
         else  
         {
             if (getBranchCount () < 12)
             {
-                for (int i = 0; i < mHashes.size(); ++i)
+                for (int i = 0; i < 16; ++i)
                     if (!isEmptyBranch (i))
                     {
-                        s.add256 (mHashes[i].as_uint256());
+                        s.add256 (getChildHash (i).as_uint256());
                         s.add8 (i);
                     }
                 s.add8 (3);
             }
             else
             {
-                for (auto const& hh : mHashes)
-                    s.add256 (hh.as_uint256());
+                for (int i = 0; i < 16; ++i)
+                    s.add256 (getChildHash (i).as_uint256());
                 s.add8 (2);
             }
         }
@@ -404,7 +567,7 @@ SHAMapInnerNodeV2::addRaw(Serializer& s, SHANodeFormat format) const
         assert(depth_ <= 64);
         s.add32 (HashPrefix::innerNodeV2);
         for (int i = 0 ; i < 16; ++i)
-            s.add256 (mHashes[i].as_uint256());
+            s.add256 (getChildHash (i).as_uint256());
         s.add8(depth_);
         auto x = common_.begin();
         for (auto i = 0; i < (depth_+1)/2; ++i, ++x)
@@ -526,14 +689,14 @@ std::string
 SHAMapInnerNode::getString(const SHAMapNodeID & id) const
 {
     std::string ret = SHAMapAbstractNode::getString(id);
-    for (int i = 0; i < mHashes.size(); ++i)
+    for (int i = 0; i < 16; ++i)
     {
         if (!isEmptyBranch (i))
         {
             ret += "\nb";
             ret += beast::lexicalCastThrow <std::string> (i);
             ret += " = ";
-            ret += to_string (mHashes[i]);
+            ret += to_string (getChildHash (i));
         }
     }
     return ret;
@@ -565,13 +728,16 @@ SHAMapInnerNode::setChild(int m, std::shared_ptr<SHAMapAbstractNode> const& chil
     assert (mType == tnINNER);
     assert (mSeq != 0);
     assert (child.get() != this);
-    mHashes[m].zero();
     mHash.zero();
     if (child)
-        mIsBranch |= (1 << m);
+    {
+        resizeChildArrays (mIsBranch | (1 << m));
+        auto const index = getChildIndex (m);
+        hashes()[index].zero();
+        children()[index] = child;
+    }
     else
-        mIsBranch &= ~ (1 << m);
-    mChildren[m] = child;
+        resizeChildArrays (mIsBranch & ~ (1 << m));
 }
 void SHAMapInnerNode::shareChild (int m, std::shared_ptr<SHAMapAbstractNode> const& child)
 {
@@ -580,23 +746,30 @@ void SHAMapInnerNode::shareChild (int m, std::shared_ptr<SHAMapAbstractNode> con
     assert (mSeq != 0);
     assert (child);
     assert (child.get() != this);
-    mChildren[m] = child;
+    assert (!isEmptyBranch (m));
+    children()[getChildIndex (m)] = child;
 }
 SHAMapAbstractNode*
 SHAMapInnerNode::getChildPointer (int branch)
 {
     assert (branch >= 0 && branch < 16);
     assert (isInner());
-    std::lock_guard <std::mutex> lock (childLock);
-    return mChildren[branch].get ();
+    packed_spinlock<std::uint16_t> sl(lock_, branch);
+    std::lock_guard<packed_spinlock<std::uint16_t>> lock(sl);
+    if (isEmptyBranch (branch))
+        return nullptr;
+    return children()[getChildIndex (branch)].get ();
 }
 std::shared_ptr<SHAMapAbstractNode>
 SHAMapInnerNode::getChild (int branch)
 {
     assert (branch >= 0 && branch < 16);
     assert (isInner());
-    std::lock_guard <std::mutex> lock (childLock);
-    return mChildren[branch];
+    packed_spinlock<std::uint16_t> sl(lock_, branch);
+    std::lock_guard<packed_spinlock<std::uint16_t>> lock(sl);
+    if (isEmptyBranch (branch))
+        return {};
+    return children()[getChildIndex (branch)];
 }
 std::shared_ptr<SHAMapAbstractNode>
 SHAMapInnerNode::canonicalizeChild(int branch, std::shared_ptr<SHAMapAbstractNode> node)
@@ -604,16 +777,18 @@ SHAMapInnerNode::canonicalizeChild(int branch, std::shared_ptr<SHAMapAbstractNod
     assert (branch >= 0 && branch < 16);
     assert (isInner());
     assert (node);
-    assert (node->getNodeHash() == mHashes[branch]);
-    std::lock_guard <std::mutex> lock (childLock);
-    if (mChildren[branch])
+    assert (node->getNodeHash() == getChildHash (branch));
+    packed_spinlock<std::uint16_t> sl(lock_, branch);
+    std::lock_guard<packed_spinlock<std::uint16_t>> lock(sl);
+    auto& child = children()[getChildIndex (branch)];
+    if (child)
     {
-        node = mChildren[branch];
+        node = child;
     }
     else
     {
         assert(std::dynamic_pointer_cast<SHAMapInnerNodeV2>(node) == nullptr);
-        mChildren[branch] = node;
+        child = node;
     }
     return node;
 }
@@ -623,17 +798,19 @@ SHAMapInnerNodeV2::canonicalizeChild(int branch, std::shared_ptr<SHAMapAbstractN
     assert (branch >= 0 && branch < 16);
     assert (isInner());
     assert (node);
-    assert (node->getNodeHash() == mHashes[branch]);
-    std::lock_guard <std::mutex> lock (childLock);
-    if (mChildren[branch])
+    assert (node->getNodeHash() == getChildHash (branch));
+    packed_spinlock<std::uint16_t> sl(lock_, branch);
+    std::lock_guard<packed_spinlock<std::uint16_t>> lock(sl);
+    auto& child = children()[getChildIndex (branch)];
+    if (child)
     {
-        node = mChildren[branch];
+        node = child;
     }
     else
     {
         assert(std::dynamic_pointer_cast<SHAMapInnerNodeV2>(node) != nullptr ||
                std::dynamic_pointer_cast<SHAMapTreeNode>(node)    != nullptr);
-        mChildren[branch] = node;
+        child = node;
     }
     return node;
 }
@@ -702,10 +879,9 @@ SHAMapInnerNodeV2::setChildren(std::shared_ptr<SHAMapTreeNode> const& child1,
         b2 = *k2 >> 4;
         depth_ = 2*depth_;
     }
-    mChildren[b1] = child1;
-    mIsBranch |= 1 << b1;
-    mChildren[b2] = child2;
-    mIsBranch |= 1 << b2;
+    resizeChildArrays (mIsBranch | (1 << b1) | (1 << b2));
+    children()[getChildIndex (b1)] = child1;
+    children()[getChildIndex (b2)] = child2;
 }
 void
 SHAMapInnerNodeV2::set_common(int depth, uint256 const& common)
@@ -738,11 +914,12 @@ SHAMapInnerNode::invariants(bool is_v2, bool is_root) const
     unsigned count = 0;
     for (int i = 0; i < 16; ++i)
     {
-        if (mHashes[i].isNonZero())
+        if (getChildHash (i).isNonZero())
         {
             assert((mIsBranch & (1 << i)) != 0);
-            if (mChildren[i] != nullptr)
-                mChildren[i]->invariants(is_v2);
+            auto const& child = children()[getChildIndex (i)];
+            if (child != nullptr)
+                child->invariants(is_v2);
             ++count;
         }
         else
@@ -765,19 +942,20 @@ SHAMapInnerNodeV2::invariants(bool is_v2, bool is_root) const
     unsigned count = 0;
     for (int i = 0; i < 16; ++i)
     {
-        if (mHashes[i].isNonZero())
+        if (getChildHash (i).isNonZero())
         {
             assert((mIsBranch & (1 << i)) != 0);
-            if (mChildren[i] != nullptr)
+            auto const& child = children()[getChildIndex (i)];
+            if (child != nullptr)
             {
-                assert(mHashes[i] == mChildren[i]->getNodeHash());
+                assert(getChildHash (i) == child->getNodeHash());
 #ifndef NDEBUG
-                auto const& childID = mChildren[i]->key();
+                auto const& childID = child->key();
                 SHAMapNodeID nodeID {depth(), common()};
                 assert (i == nodeID.selectBranch(childID));
 #endif
                 assert(has_common_prefix(childID));
-                mChildren[i]->invariants(is_v2);
+                child->invariants(is_v2);
             }
             ++count;
         }
@@ -5,5 +5,6 @@
 #include <ripple/basics/impl/PerfLogImp.cpp>
 #include <ripple/basics/impl/ResolverAsio.cpp>
 #include <ripple/basics/impl/Sustain.cpp>
+#include <ripple/basics/impl/TaskPool.cpp>
 #include <ripple/basics/impl/UptimeClock.cpp>
 #include <ripple/basics/impl/Archive.cpp>
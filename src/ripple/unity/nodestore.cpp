@@ -11,6 +11,8 @@
 #include <ripple/nodestore/impl/DummyScheduler.cpp>
 #include <ripple/nodestore/impl/DecodedBlob.cpp>
 #include <ripple/nodestore/impl/EncodedBlob.cpp>
+#include <ripple/nodestore/impl/HotCache.cpp>
 #include <ripple/nodestore/impl/ManagerImp.cpp>
 #include <ripple/nodestore/impl/NodeObject.cpp>
 #include <ripple/nodestore/impl/Shard.cpp>
+#include <ripple/nodestore/impl/ZstdCodec.cpp>
@@ -1,5 +1,6 @@
 
 #include <ripple/overlay/impl/Cluster.cpp>
 #include <ripple/overlay/impl/ConnectAttempt.cpp>
+#include <ripple/overlay/impl/LedgerServer.cpp>
 #include <ripple/overlay/impl/Message.cpp>
 #include <ripple/overlay/impl/OverlayImpl.cpp>
@@ -1,6 +1,8 @@
 
 #include <ripple/overlay/impl/PeerImp.cpp>
 #include <ripple/overlay/impl/PeerSet.cpp>
+#include <ripple/overlay/impl/SendQueue.cpp>
+#include <ripple/overlay/impl/Squelch.cpp>
 #include <ripple/overlay/impl/TMHello.cpp>
 #include <ripple/overlay/impl/TrafficCount.cpp>
 #if DOXYGEN
@@ -3,6 +3,7 @@
 #include <ripple/protocol/impl/Book.cpp>
 #include <ripple/protocol/impl/BuildInfo.cpp>
 #include <ripple/protocol/impl/digest.cpp>
+#include <ripple/protocol/impl/sha512_batch.cpp>
 #include <ripple/protocol/impl/ErrorCodes.cpp>
 #include <ripple/protocol/impl/Feature.cpp>
 #include <ripple/protocol/impl/HashPrefix.cpp>
@@ -0,0 +1,228 @@
+#include <test/jtx.h>
+#include <ripple/app/ledger/BuildLedger.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/misc/CanonicalTXSet.h>
+#include <chrono>
+#include <set>
+#include <thread>
+namespace ripple {
+namespace test {
+class BuildLedger_test : public beast::unit_test::suite
+{
+protected:
+    struct Built
+    {
+        std::shared_ptr<Ledger> ledger;
+        std::set<TxID> failed;
+        std::size_t retried;
+    };
+    static
+    std::unique_ptr<Config>
+    applyThreads (std::size_t threads)
+    {
+        return jtx::envconfig ([threads](std::unique_ptr<Config> cfg)
+            {
+                cfg->LEDGER_APPLY_THREADS = threads;
+                return cfg;
+            });
+    }
+    static
+    Built
+    build (jtx::Env& env, std::shared_ptr<Ledger const> const& parent,
+        std::vector<std::shared_ptr<STTx const>> const& txs,
+            std::size_t threads)
+    {
+        using namespace std::chrono_literals;
+        env.app ().config ().LEDGER_APPLY_THREADS = threads;
+        CanonicalTXSet set (parent->info ().hash);
+        for (auto const& tx : txs)
+            set.insert (tx);
+        Built result;
+        result.ledger = buildLedger (parent, parent->info ().closeTime + 10s,
+            true, parent->info ().closeTimeResolution, env.app (), set,
+                result.failed, env.journal);
+        result.retried = set.size ();
+        return result;
+    }
+    static
+    std::vector<jtx::Account>
+    fund (jtx::Env& env, jtx::Account const& gw, std::size_t count)
+    {
+        using namespace jtx;
+        auto const USD = gw["USD"];
+        env.fund (XRP (100000000), gw);
+        std::vector<Account> accounts;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            accounts.emplace_back ("trader" + std::to_string (i));
+            env.fund (XRP (1000000), accounts.back ());
+        }
+        env.close ();
+        for (auto const& account : accounts)
+        {
+            env (trust (account, USD (100000000)));
+            env (pay (gw, account, USD (1000000)));
+        }
+        env.close ();
+        return accounts;
+    }
+    void
+    expectSame (Built const& serial, Built const& parallel)
+    {
+        auto const& s = serial.ledger->info ();
+        auto const& p = parallel.ledger->info ();
+        BEAST_EXPECT(s.hash == p.hash);
+        BEAST_EXPECT(s.txHash == p.txHash);
+        BEAST_EXPECT(s.accountHash == p.accountHash);
+        BEAST_EXPECT(s.drops == p.drops);
+        BEAST_EXPECT(serial.failed == parallel.failed);
+        BEAST_EXPECT(serial.retried == parallel.retried);
+    }
+};
+class BuildLedgerCheck_test : public BuildLedger_test
+{
+    void
+    testDeterminism ()
+    {
+        using namespace jtx;
+        testcase ("determinism");
+        Env env (*this, applyThreads (8));
+        Account const gw ("gateway");
+        auto const USD = gw["USD"];
+        auto const accounts = fund (env, gw, 40);
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (std::size_t i = 0; i < accounts.size (); ++i)
+        {
+            auto const& account = accounts[i];
+            auto const s = env.seq (account);
+            auto add = [&](JTx const& jt)
+            {
+                txs.push_back (jt.stx);
+            };
+            add (env.jt (pay (account, accounts[(i + 1) % accounts.size ()],
+                XRP (100 + i)), seq (s), fee (10)));
+            if (i % 2)
+                add (env.jt (offer (account, USD (10), XRP (95 + i % 10)),
+                    seq (s + 1), fee (10)));
+            else
+                add (env.jt (offer (account, XRP (95 + i % 10), USD (10)),
+                    seq (s + 1), fee (10)));
+            add (env.jt (pay (account, accounts[(i * 7) % accounts.size ()],
+                USD (5)), seq (s + 2), fee (10)));
+            add (env.jt (pay (account,
+                Account ("new" + std::to_string (i % 5)), XRP (300)),
+                    seq (s + 3), fee (10)));
+            if (i % 10 == 3)
+                add (env.jt (noop (account), seq (s + 10), fee (10)));
+            if (i % 13 == 5)
+                add (env.jt (noop (account), seq (1), fee (10)));
+            if (i % 11 == 7)
+                add (env.jt (pay (account, Account ("dust"), XRP (1)),
+                    seq (s + 4), fee (10)));
+        }
+        auto const parent =
+            env.app ().getLedgerMaster ().getClosedLedger ();
+        auto const serial = build (env, parent, txs, 1);
+        BEAST_EXPECT(! serial.failed.empty ());
+        BEAST_EXPECT(serial.retried != 0);
+        auto const applied = std::distance (serial.ledger->txs.begin (),
+            serial.ledger->txs.end ());
+        BEAST_EXPECT(applied > static_cast<std::ptrdiff_t> (
+            accounts.size () * 3));
+        for (std::size_t threads : {2, 3, 4, 8})
+            expectSame (serial, build (env, parent, txs, threads));
+    }
+    void
+    testDisjoint ()
+    {
+        using namespace jtx;
+        testcase ("disjoint");
+        Env env (*this, applyThreads (4));
+        Account const gw ("gateway");
+        auto const accounts = fund (env, gw, 64);
+        auto const half = accounts.size () / 2;
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (std::size_t i = 0; i < half; ++i)
+        {
+            auto const& account = accounts[i];
+            txs.push_back (env.jt (pay (account, accounts[i + half],
+                XRP (10)), seq (env.seq (account)), fee (10)).stx);
+        }
+        auto const parent =
+            env.app ().getLedgerMaster ().getClosedLedger ();
+        auto const serial = build (env, parent, txs, 1);
+        BEAST_EXPECT(serial.failed.empty ());
+        BEAST_EXPECT(serial.retried == 0);
+        expectSame (serial, build (env, parent, txs, 4));
+    }
+public:
+    void
+    run () override
+    {
+        testDeterminism ();
+        testDisjoint ();
+    }
+};
+class BuildLedgerTiming_test : public BuildLedger_test
+{
+    void
+    testThroughput (std::size_t traders, std::size_t rounds)
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+        testcase ("throughput: " + std::to_string (traders) + " traders, " +
+            std::to_string (rounds) + " rounds");
+        auto const maxThreads = std::max<std::size_t> (
+            std::thread::hardware_concurrency (), 1);
+        Env env (*this, applyThreads (maxThreads));
+        Account const gw ("gateway");
+        auto const USD = gw["USD"];
+        auto const accounts = fund (env, gw, traders);
+        auto const half = accounts.size () / 2;
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (std::size_t i = 0; i < accounts.size (); ++i)
+            {
+                auto const& account = accounts[i];
+                auto const s = seq (env.seq (account) + r);
+                if (r % 4 == 3)
+                    txs.push_back (env.jt (offer (account, USD (1),
+                        XRP (100 + i % 10)), s, fee (10)).stx);
+                else
+                    txs.push_back (env.jt (pay (account,
+                        accounts[(i + half) % accounts.size ()], XRP (1)),
+                            s, fee (10)).stx);
+            }
+        }
+        auto const parent =
+            env.app ().getLedgerMaster ().getClosedLedger ();
+        boost::optional<Built> serial;
+        for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            auto const start = steady_clock::now ();
+            auto built = build (env, parent, txs, threads);
+            auto const elapsed = duration_cast<duration<double>> (
+                steady_clock::now () - start);
+            log << threads << " threads: " <<
+                static_cast<std::uint64_t> (txs.size () / elapsed.count ()) <<
+                " tx/s" << std::endl;
+            if (serial)
+                expectSame (*serial, built);
+            else
+                serial.emplace (std::move (built));
+        }
+    }
+public:
+    void
+    run () override
+    {
+        testThroughput (200, 8);
+        testThroughput (1000, 8);
+    }
+};
+BEAST_DEFINE_TESTSUITE(BuildLedgerCheck,app,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(BuildLedgerTiming,app,ripple,10);
+}
+}
@@ -0,0 +1,127 @@
+#include <test/jtx.h>
+#include <ripple/app/ledger/LedgerToJson.h>
+#include <ripple/basics/Arena.h>
+#include <ripple/json/json_writer.h>
+#include <ripple/json/to_string.h>
+#include <boost/optional.hpp>
+#include <chrono>
+namespace ripple {
+namespace test {
+class LedgerToJsonTiming_test : public beast::unit_test::suite
+{
+    template <class F>
+    double
+    measure (std::size_t rounds, bool arena, F&& f)
+    {
+        using namespace std::chrono;
+        Arena a (megabytes (1), megabytes (256));
+        auto const start = steady_clock::now ();
+        for (std::size_t i = 0; i < rounds; ++i)
+        {
+            boost::optional<Json::Value::Scope> scope;
+            if (arena)
+                scope.emplace (a);
+            f ();
+        }
+        auto const elapsed = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+        BEAST_EXPECT(a.live () == 0);
+        BEAST_EXPECT(a.fallbacks () == 0);
+        return elapsed.count ();
+    }
+    void
+    testLedger (std::size_t traders, std::size_t offers)
+    {
+        using namespace jtx;
+        testcase ("ledger: " + std::to_string (traders) + " traders, " +
+            std::to_string (offers) + " offers each");
+        Env env (*this);
+        Account const gw ("gateway");
+        auto const USD = gw["USD"];
+        env.fund (XRP (100000000), gw);
+        std::vector<Account> accounts;
+        for (std::size_t i = 0; i < traders; ++i)
+        {
+            accounts.emplace_back ("trader" + std::to_string (i));
+            env.fund (XRP (10000000), accounts.back ());
+        }
+        env.close ();
+        for (auto const& account : accounts)
+        {
+            env (trust (account, USD (100000000)));
+            env (pay (gw, account, USD (10000000)));
+        }
+        env.close ();
+        for (std::size_t i = 0; i < offers; ++i)
+        {
+            for (std::size_t j = 0; j < accounts.size (); ++j)
+            {
+                auto const price = 90 + (i * 7 + j) % 20;
+                if (j % 2)
+                    env (offer (accounts[j], USD (1), XRP (price)));
+                else
+                    env (offer (accounts[j], XRP (price), USD (1)));
+            }
+        }
+        env.close ();
+        auto const closed = env.closed ();
+        auto const options = LedgerFill::full | LedgerFill::expand |
+            LedgerFill::dumpTxrp | LedgerFill::dumpState;
+        auto const expected = to_string (getJson (
+            LedgerFill (*closed, options)));
+        std::size_t const rounds = 20;
+        for (auto const arena : {false, true})
+        {
+            auto const elapsed = measure (rounds, arena,
+                [&]
+                {
+                    auto const json = getJson (LedgerFill (*closed, options));
+                    BEAST_EXPECT(to_string (json).size () == expected.size ());
+                });
+            log << (arena ? "arena: " : "heap: ") <<
+                static_cast<std::uint64_t> (rounds / elapsed) <<
+                " ledgers/s, " << expected.size () << " bytes" << std::endl;
+        }
+        std::size_t txs = 0;
+        for (auto const arena : {false, true})
+        {
+            txs = 0;
+            auto const elapsed = measure (rounds, arena,
+                [&]
+                {
+                    for (auto const& item : closed->txs)
+                    {
+                        Json::Value jvObj (Json::objectValue);
+                        jvObj[jss::type] = "transaction";
+                        jvObj[jss::transaction] =
+                            item.first->getJson (JsonOptions::none);
+                        jvObj[jss::meta] =
+                            item.second->getJson (JsonOptions::none);
+                        jvObj[jss::validated] = true;
+                        jvObj[jss::ledger_index] = closed->info ().seq;
+                        std::size_t bytes = 0;
+                        Json::stream (jvObj,
+                            [&](void const*, std::size_t n)
+                            {
+                                bytes += n;
+                            });
+                        BEAST_EXPECT(bytes != 0);
+                        ++txs;
+                    }
+                });
+            log << (arena ? "arena: " : "heap: ") <<
+                static_cast<std::uint64_t> (txs / elapsed) <<
+                " published tx/s" << std::endl;
+        }
+    }
+public:
+    void
+    run () override
+    {
+        testLedger (50, 10);
+        testLedger (200, 20);
+    }
+};
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(LedgerToJsonTiming,app,ripple,10);
+}
+}
@@ -1,4 +1,5 @@
 
+#include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/SHAMapStore.h>
 #include <ripple/core/ConfigSections.h>
@@ -443,11 +444,68 @@ public:
         BEAST_EXPECT(store.getLastRotated() == ledgerSeq - 1);
         lastRotated = ledgerSeq - 1;
     }
+    void testParallelCopy()
+    {
+        testcase("parallel rotation copy");
+        using namespace jtx;
+        std::map<std::uint32_t,
+            std::pair<std::string, std::uint32_t>> results;
+        for (std::uint32_t const threads : {1, 4})
+        {
+            Env env(*this, envconfig(
+                [threads](std::unique_ptr<Config> cfg)
+                {
+                    cfg = onlineDelete(std::move(cfg));
+                    cfg->section(ConfigSection::nodeDatabase())
+                        .set("copy_threads", std::to_string(threads));
+                    return cfg;
+                }));
+            auto& store = env.app().getSHAMapStore();
+            for (auto i = 0; i < 64; ++i)
+                env.fund(XRP(10000), noripple("test" + to_string(i)));
+            auto ledgerSeq = waitForReady(env);
+            auto lastRotated = ledgerSeq - 1;
+            auto info = env.rpc("server_info")[jss::result][jss::info];
+            BEAST_EXPECT(info[jss::online_delete][jss::state] == "idle");
+            BEAST_EXPECT(info[jss::online_delete][jss::last_rotated] ==
+                lastRotated);
+            for (; ledgerSeq <= lastRotated + deleteInterval; ++ledgerSeq)
+            {
+                env.close();
+                auto ledger = env.rpc("ledger", "validated");
+                BEAST_EXPECT(goodLedger(env, ledger, to_string(ledgerSeq)));
+            }
+            store.rendezvous();
+            BEAST_EXPECT(store.getLastRotated() == ledgerSeq - 1);
+            lastRotated = store.getLastRotated();
+            auto const ledger =
+                env.app().getLedgerMaster().getLedgerBySeq(lastRotated);
+            if (! BEAST_EXPECT(ledger))
+                continue;
+            std::uint32_t nodes = 0;
+            ledger->stateMap().visitNodes(
+                [&nodes](SHAMapAbstractNode&)
+                {
+                    ++nodes;
+                    return true;
+                });
+            info = env.rpc("server_info")[jss::result][jss::info];
+            auto const& rotation = info[jss::online_delete];
+            BEAST_EXPECT(rotation[jss::state] == "idle");
+            BEAST_EXPECT(rotation[jss::last_rotated] == lastRotated);
+            BEAST_EXPECT(rotation[jss::nodes_copied] == nodes);
+            results.emplace(threads, std::make_pair(
+                to_string(ledger->info().accountHash), nodes));
+        }
+        BEAST_EXPECT(results.size() == 2);
+        BEAST_EXPECT(results[1] == results[4]);
+    }
     void run() override
     {
         testClear();
         testAutomatic();
         testCanDelete();
+        testParallelCopy();
     }
 };
 BEAST_DEFINE_TESTSUITE(SHAMapStore,app,ripple);
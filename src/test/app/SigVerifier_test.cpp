@@ -0,0 +1,261 @@
+#include <ripple/app/misc/SigVerifier.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/Sign.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+namespace ripple {
+namespace test {
+class SigVerifier_test : public beast::unit_test::suite
+{
+protected:
+    static
+    std::shared_ptr<STTx const>
+    makeTx (std::pair<PublicKey, SecretKey> const& signer,
+        std::pair<PublicKey, SecretKey> const& account,
+            std::uint32_t seq)
+    {
+        STTx tx (ttACCOUNT_SET,
+            [&](auto& obj)
+            {
+                obj.setAccountID (sfAccount, calcAccountID (account.first));
+                obj.setFieldU32 (sfSequence, seq);
+                obj.setFieldAmount (sfFee, STAmount (10));
+                obj.setFieldVL (sfSigningPubKey, account.first.slice ());
+            });
+        tx.sign (account.first, signer.second);
+        return std::make_shared<STTx const> (std::move (tx));
+    }
+    static
+    std::vector<std::shared_ptr<STTx const>>
+    makeTxs (KeyType type, std::size_t count, bool good)
+    {
+        auto const account = randomKeyPair (type);
+        auto const signer = good ? account : randomKeyPair (type);
+        std::vector<std::shared_ptr<STTx const>> txs;
+        txs.reserve (count);
+        for (std::size_t i = 0; i < count; ++i)
+            txs.push_back (makeTx (signer, account, i + 1));
+        return txs;
+    }
+    class Waiter
+    {
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::size_t count_ = 0;
+    public:
+        void
+        notify ()
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            ++count_;
+            cond_.notify_all ();
+        }
+        bool
+        wait (std::size_t count)
+        {
+            using namespace std::chrono_literals;
+            std::unique_lock<std::mutex> lock (mutex_);
+            return cond_.wait_for (lock, 60s,
+                [&] { return count_ >= count; });
+        }
+    };
+    static
+    Rules
+    rules ()
+    {
+        return Rules (std::unordered_set<uint256, beast::uhash<>> {});
+    }
+};
+class SigVerifierCheck_test : public SigVerifier_test
+{
+    void
+    testVerify (KeyType type, std::size_t threads)
+    {
+        testcase (std::string ("verify ") + to_string (type) + " " +
+            std::to_string (threads) + " threads");
+        SuiteJournal journal ("SigVerifier_test", *this);
+        RootStoppable parent ("TestRootStoppable");
+        Config config;
+        HashRouter router (stopwatch (), HashRouter::getDefaultHoldTime (),
+            HashRouter::getDefaultRecoverLimit ());
+        SigVerifier verifier (parent, router, config, threads, journal);
+        BEAST_EXPECT(verifier.getThreadCount () == threads);
+        auto const good = makeTxs (type, 200, true);
+        auto const bad = makeTxs (type, 50, false);
+        std::mutex mutex;
+        std::map<uint256, Validity> results;
+        Waiter waiter;
+        auto submit = [&](std::shared_ptr<STTx const> const& stx)
+        {
+            auto const id = stx->getTransactionID ();
+            BEAST_EXPECT(verifier.verify (stx, rules (),
+                [&, id] (Validity validity)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock (mutex);
+                        results.emplace (id, validity);
+                    }
+                    waiter.notify ();
+                }));
+        };
+        for (std::size_t i = 0; i < good.size (); ++i)
+        {
+            submit (good[i]);
+            if (i < bad.size ())
+                submit (bad[i]);
+        }
+        BEAST_EXPECT(waiter.wait (good.size () + bad.size ()));
+        BEAST_EXPECT(verifier.getVerifiedCount () ==
+            good.size () + bad.size ());
+        BEAST_EXPECT(verifier.getBatchCount () > 0);
+        BEAST_EXPECT(verifier.getBatchCount () <= verifier.getVerifiedCount ());
+        BEAST_EXPECT(verifier.size () == 0);
+        std::lock_guard<std::mutex> lock (mutex);
+        BEAST_EXPECT(results.size () == good.size () + bad.size ());
+        for (auto const& stx : good)
+        {
+            auto const id = stx->getTransactionID ();
+            BEAST_EXPECT(results[id] == Validity::Valid);
+            BEAST_EXPECT(router.getFlags (id) != 0);
+            BEAST_EXPECT(checkValidity (router, *stx, rules (),
+                config).first == Validity::Valid);
+        }
+        for (auto const& stx : bad)
+        {
+            auto const id = stx->getTransactionID ();
+            BEAST_EXPECT(results[id] == Validity::SigBad);
+            BEAST_EXPECT(router.getFlags (id) != 0);
+            BEAST_EXPECT(checkValidity (router, *stx, rules (),
+                config).first == Validity::SigBad);
+        }
+    }
+    void
+    testValidations ()
+    {
+        testcase ("validations");
+        SuiteJournal journal ("SigVerifier_test", *this);
+        RootStoppable parent ("TestRootStoppable");
+        Config config;
+        HashRouter router (stopwatch (), HashRouter::getDefaultHoldTime (),
+            HashRouter::getDefaultRecoverLimit ());
+        SigVerifier verifier (parent, router, config, 3, journal);
+        auto const keys = randomKeyPair (KeyType::secp256k1);
+        auto const other = randomKeyPair (KeyType::secp256k1);
+        std::vector<std::shared_ptr<STValidation>> vals;
+        for (std::uint32_t i = 0; i < 150; ++i)
+        {
+            vals.push_back (std::make_shared<STValidation> (
+                uint256 (i), i + 1, uint256 (i + 1),
+                NetClock::time_point {}, keys.first,
+                i % 7 == 3 ? other.second : keys.second,
+                calcNodeID (keys.first), true,
+                STValidation::FeeSettings {}, std::vector<uint256> {}));
+        }
+        std::mutex mutex;
+        std::vector<int> results (vals.size (), -1);
+        Waiter waiter;
+        for (std::size_t i = 0; i < vals.size (); ++i)
+        {
+            BEAST_EXPECT(verifier.verify (vals[i],
+                [&, i] (bool valid)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock (mutex);
+                        results[i] = valid;
+                    }
+                    waiter.notify ();
+                }));
+        }
+        BEAST_EXPECT(waiter.wait (vals.size ()));
+        std::lock_guard<std::mutex> lock (mutex);
+        for (std::size_t i = 0; i < vals.size (); ++i)
+        {
+            BEAST_EXPECT(results[i] == (i % 7 != 3));
+            BEAST_EXPECT(results[i] == vals[i]->isValid ());
+        }
+    }
+    void
+    testStop ()
+    {
+        testcase ("stop");
+        SuiteJournal journal ("SigVerifier_test", *this);
+        RootStoppable parent ("TestRootStoppable");
+        Config config;
+        HashRouter router (stopwatch (), HashRouter::getDefaultHoldTime (),
+            HashRouter::getDefaultRecoverLimit ());
+        SigVerifier verifier (parent, router, config, 2, journal);
+        auto const txs = makeTxs (KeyType::secp256k1, 10, true);
+        Waiter waiter;
+        for (auto const& stx : txs)
+            verifier.verify (stx, rules (), [&](Validity) { waiter.notify (); });
+        BEAST_EXPECT(waiter.wait (txs.size ()));
+        parent.start ();
+        parent.stop (journal);
+        BEAST_EXPECT(! verifier.verify (txs.front (), rules (),
+            [&](Validity) { fail ("handler invoked after stop"); }));
+        BEAST_EXPECT(verifier.getVerifiedCount () == txs.size ());
+    }
+public:
+    void
+    run () override
+    {
+        testVerify (KeyType::secp256k1, 1);
+        testVerify (KeyType::secp256k1, 4);
+        testVerify (KeyType::ed25519, 1);
+        testVerify (KeyType::ed25519, 4);
+        testValidations ();
+        testStop ();
+    }
+};
+class SigVerifierTiming_test : public SigVerifier_test
+{
+    void
+    testThroughput (KeyType type,
+        std::vector<std::shared_ptr<STTx const>> const& txs,
+            std::size_t threads)
+    {
+        using namespace std::chrono;
+        SuiteJournal journal ("SigVerifier_test", *this);
+        RootStoppable parent ("TestRootStoppable");
+        Config config;
+        HashRouter router (stopwatch (), HashRouter::getDefaultHoldTime (),
+            HashRouter::getDefaultRecoverLimit ());
+        SigVerifier verifier (parent, router, config, threads, journal);
+        Waiter waiter;
+        auto const start = steady_clock::now ();
+        for (auto const& stx : txs)
+            verifier.verify (stx, rules (), [&](Validity) { waiter.notify (); });
+        BEAST_EXPECT(waiter.wait (txs.size ()));
+        auto const elapsed = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+        log << to_string (type) << " " << threads << " threads: " <<
+            static_cast<std::uint64_t> (txs.size () / elapsed.count ()) <<
+            " tx/s, " << verifier.getBatchCount () << " batches" <<
+            std::endl;
+    }
+public:
+    void
+    run () override
+    {
+        std::size_t const count = 20000;
+        auto const maxThreads = std::max (
+            std::thread::hardware_concurrency (), 1u);
+        for (auto const type : {KeyType::secp256k1, KeyType::ed25519})
+        {
+            testcase (std::string ("throughput ") + to_string (type));
+            auto const txs = makeTxs (type, count, true);
+            for (std::size_t threads = 1; threads < maxThreads; threads *= 2)
+                testThroughput (type, txs, threads);
+            testThroughput (type, txs, maxThreads);
+        }
+        pass ();
+    }
+};
+BEAST_DEFINE_TESTSUITE(SigVerifierCheck,app,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SigVerifierTiming,app,ripple,10);
+}
+}
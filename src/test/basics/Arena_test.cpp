@@ -0,0 +1,142 @@
+#include <ripple/basics/Arena.h>
+#include <ripple/beast/unit_test.h>
+#include <boost/container/flat_map.hpp>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+namespace ripple {
+class Arena_test : public beast::unit_test::suite
+{
+    void
+    testAllocate()
+    {
+        testcase("allocate");
+        Arena arena (1024, 4096);
+        BEAST_EXPECT(arena.reserved() == 0);
+        std::vector<void*> ptrs;
+        for (std::size_t i = 1; i <= 20; ++i)
+        {
+            auto const p = arena.allocate(i * 3, 8);
+            BEAST_EXPECT(p != nullptr);
+            BEAST_EXPECT(reinterpret_cast<std::uintptr_t>(p) %
+                alignof(std::max_align_t) == 0);
+            std::memset(p, 0xCD, i * 3);
+            ptrs.push_back(p);
+        }
+        BEAST_EXPECT(arena.live() == ptrs.size());
+        BEAST_EXPECT(arena.allocations() == ptrs.size());
+        BEAST_EXPECT(arena.reserved() == 1024);
+        auto const big = arena.allocate(2048, 8);
+        BEAST_EXPECT(big != nullptr);
+        BEAST_EXPECT(arena.reserved() == 1024 + 2048);
+        BEAST_EXPECT(arena.allocate(2048, 8) == nullptr);
+        BEAST_EXPECT(arena.fallbacks() == 1);
+        int local = 0;
+        BEAST_EXPECT(! arena.deallocate(&local));
+        for (auto const p : ptrs)
+            BEAST_EXPECT(arena.deallocate(p));
+        BEAST_EXPECT(arena.deallocate(big));
+        BEAST_EXPECT(arena.live() == 0);
+        arena.reset();
+        BEAST_EXPECT(arena.resets() == 1);
+        BEAST_EXPECT(arena.reserved() == 2048);
+        BEAST_EXPECT(arena.highWater() >= 2048);
+        auto const reused = arena.allocate(16, 8);
+        BEAST_EXPECT(reused == big);
+        BEAST_EXPECT(arena.deallocate(reused));
+        arena.reset();
+    }
+    void
+    testScope()
+    {
+        testcase("scope");
+        BEAST_EXPECT(Arena::current() == nullptr);
+        Arena outer;
+        Arena inner;
+        {
+            Arena::Scope s1 (outer);
+            BEAST_EXPECT(Arena::current() == &outer);
+            {
+                Arena::Scope s2 (inner);
+                BEAST_EXPECT(Arena::current() == &inner);
+                {
+                    Arena::Scope s3 (inner);
+                    BEAST_EXPECT(Arena::current() == &inner);
+                }
+                BEAST_EXPECT(inner.resets() == 0);
+                BEAST_EXPECT(Arena::current() == &inner);
+            }
+            BEAST_EXPECT(inner.resets() == 1);
+            BEAST_EXPECT(outer.resets() == 0);
+            BEAST_EXPECT(Arena::current() == &outer);
+        }
+        BEAST_EXPECT(outer.resets() == 1);
+        BEAST_EXPECT(Arena::current() == nullptr);
+    }
+    void
+    testContainers()
+    {
+        testcase("containers");
+        using Map = std::map<int, std::shared_ptr<int>, std::less<int>,
+            ArenaAllocator<std::pair<int const, std::shared_ptr<int>>>>;
+        using Flat = boost::container::flat_map<int, int, std::less<int>,
+            ArenaAllocator<std::pair<int, int>>>;
+        Arena arena;
+        Map heap;
+        for (int i = 0; i < 100; ++i)
+            heap.emplace(i, std::make_shared<int>(i));
+        {
+            Arena::Scope scope (arena);
+            Map m;
+            Flat f;
+            for (int i = 0; i < 1000; ++i)
+            {
+                m.emplace(i, std::make_shared<int>(i));
+                f.emplace(1000 - i, i);
+            }
+            BEAST_EXPECT(arena.live() > 0);
+            BEAST_EXPECT(m.size() == 1000);
+            BEAST_EXPECT(f.begin()->first == 1);
+            for (int i = 0; i < 1000; i += 2)
+                m.erase(i);
+            Map copy (heap);
+            BEAST_EXPECT(copy == heap);
+            Map moved (std::move(m));
+            BEAST_EXPECT(moved.size() == 500);
+            heap.emplace(1000, std::make_shared<int>(1000));
+        }
+        BEAST_EXPECT(arena.live() == 0);
+        BEAST_EXPECT(arena.resets() == 1);
+        BEAST_EXPECT(arena.allocations() > 1000);
+        BEAST_EXPECT(heap.size() == 101);
+        heap.clear();
+        BEAST_EXPECT(arena.live() == 0);
+    }
+    void
+    testTotals()
+    {
+        testcase("totals");
+        auto& totals = Arena::totals();
+        auto const allocations = totals.allocations.load();
+        auto const resets = totals.resets.load();
+        Arena arena;
+        {
+            Arena::Scope scope (arena);
+            std::vector<int, ArenaAllocator<int>> v (100);
+        }
+        BEAST_EXPECT(totals.allocations.load() == allocations + 1);
+        BEAST_EXPECT(totals.resets.load() == resets + 1);
+    }
+public:
+    void
+    run() override
+    {
+        testAllocate();
+        testScope();
+        testContainers();
+        testTotals();
+    }
+};
+BEAST_DEFINE_TESTSUITE(Arena,ripple_basics,ripple);
+}
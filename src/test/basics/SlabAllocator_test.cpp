@@ -0,0 +1,89 @@
+#include <ripple/basics/SlabAllocator.h>
+#include <ripple/beast/unit_test.h>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+namespace ripple {
+class SlabAllocator_test : public beast::unit_test::suite
+{
+    void
+    testReuse ()
+    {
+        testcase ("reuse");
+        SlabAllocator pool (40, 100);
+        BEAST_EXPECT(pool.size () == 48);
+        BEAST_EXPECT(pool.reserved () == 0);
+        std::vector<void*> items;
+        std::set<void*> distinct;
+        for (int i = 0; i < 1000; ++i)
+        {
+            items.push_back (pool.allocate ());
+            std::memset (items.back (), i & 0xff, pool.size ());
+            distinct.insert (items.back ());
+        }
+        BEAST_EXPECT(distinct.size () == items.size ());
+        BEAST_EXPECT(pool.allocated () == 1000);
+        BEAST_EXPECT(pool.reserved () >= 1000);
+        auto const reserved = pool.reserved ();
+        for (std::size_t i = 0; i < items.size (); i += 2)
+            pool.deallocate (items[i]);
+        BEAST_EXPECT(pool.allocated () == 500);
+        BEAST_EXPECT(pool.reserved () == reserved);
+        for (std::size_t i = 0; i < items.size (); i += 2)
+            items[i] = pool.allocate ();
+        BEAST_EXPECT(pool.reserved () == reserved);
+        for (auto p : items)
+            pool.deallocate (p);
+        BEAST_EXPECT(pool.allocated () == 0);
+        BEAST_EXPECT(pool.reserved () < reserved);
+        BEAST_EXPECT(pool.reserved () <= reserved / 4);
+    }
+    void
+    testThreads ()
+    {
+        testcase ("threads");
+        SlabAllocator pool (96, 64);
+        std::size_t const count = 20000;
+        std::vector<std::vector<void*>> items (4);
+        std::vector<std::thread> threads;
+        for (auto& v : items)
+        {
+            threads.emplace_back ([&pool, &v, count]
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    v.push_back (pool.allocate ());
+            });
+        }
+        for (auto& t : threads)
+            t.join ();
+        threads.clear ();
+        BEAST_EXPECT(pool.allocated () == items.size () * count);
+        std::set<void*> distinct;
+        for (auto const& v : items)
+            distinct.insert (v.begin (), v.end ());
+        BEAST_EXPECT(distinct.size () == items.size () * count);
+        for (std::size_t i = 0; i < items.size (); ++i)
+        {
+            auto& v = items[(i + 1) % items.size ()];
+            threads.emplace_back ([&pool, &v]
+            {
+                for (auto p : v)
+                    pool.deallocate (p);
+            });
+        }
+        for (auto& t : threads)
+            t.join ();
+        BEAST_EXPECT(pool.allocated () == 0);
+        BEAST_EXPECT(pool.reserved () < items.size () * count / 4);
+    }
+public:
+    void
+    run () override
+    {
+        testReuse ();
+        testThreads ();
+    }
+};
+BEAST_DEFINE_TESTSUITE(SlabAllocator,basics,ripple);
+}
@@ -1,15 +1,22 @@
 
+#include <ripple/basics/base_uint.h>
 #include <ripple/basics/chrono.h>
+#include <ripple/basics/random.h>
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/clock/manual_clock.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/beast/xor_shift_engine.h>
 #include <test/unit_test/SuiteJournal.h>
+#include <iomanip>
+#include <thread>
+#include <vector>
 namespace ripple {
 
 class TaggedCache_test : public beast::unit_test::suite
 {
 public:
-    void run () override
+    void testCache (std::size_t partitions)
     {
         using namespace std::chrono_literals;
         using namespace beast::severities;
@@ -19,7 +26,9 @@ public:
         using Key = int;
         using Value = std::string;
         using Cache = TaggedCache <Key, Value>;
-        Cache c ("test", 1, 1s, clock, journal);
+        Cache c ("test", 1, 1s, clock, journal,
+            beast::insight::NullCollector::New (), partitions);
+        BEAST_EXPECT(c.partitions () == partitions);
         {
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
@@ -90,7 +99,112 @@ public:
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
+        {
+            for (int i = 0; i < 100; ++i)
+                c.insert (i, std::to_string (i));
+            BEAST_EXPECT(c.getCacheSize() == 100);
+            BEAST_EXPECT(c.getTrackSize() == 100);
+            BEAST_EXPECT(c.getKeys().size() == 100);
+            for (int i = 0; i < 100; i += 2)
+                BEAST_EXPECT(c.del (i, false));
+            BEAST_EXPECT(c.getCacheSize() == 50);
+            std::string s;
+            BEAST_EXPECT(! c.retrieve (10, s));
+            BEAST_EXPECT(c.retrieve (11, s) && s == "11");
+            BEAST_EXPECT(c.refreshIfPresent (13));
+            ++clock;
+            c.sweep ();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+    }
+    void run () override
+    {
+        testcase ("single partition");
+        testCache (1);
+        testcase ("partitioned");
+        testCache (16);
+    }
+};
+class TaggedCacheContention_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using Cache = TaggedCache <uint256, std::string>;
+#ifndef NDEBUG
+    std::size_t const default_ops = 200000;
+#else
+    std::size_t const default_ops = 2000000;
+#endif
+    std::size_t const default_keys = 65536;
+    double
+    measure (Cache& cache, std::vector<uint256> const& keys,
+        std::size_t threads)
+    {
+        std::vector<std::thread> workers;
+        auto const perThread = default_ops / threads;
+        auto const start = clock_type::now ();
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back ([&cache, &keys, perThread, t]
+                {
+                    beast::xor_shift_engine eng (t + 1);
+                    for (std::size_t i = 0; i < perThread; ++i)
+                    {
+                        auto const& key = keys[rand_int (eng,
+                            keys.size () - 1)];
+                        if (i % 4 == 0)
+                        {
+                            auto value = std::make_shared<std::string> (
+                                "value");
+                            cache.canonicalize (key, value);
+                        }
+                        else
+                        {
+                            cache.fetch (key);
+                        }
+                    }
+                });
+        }
+        for (auto& w : workers)
+            w.join ();
+        std::chrono::duration<double> const elapsed =
+            clock_type::now () - start;
+        return perThread * threads / elapsed.count ();
+    }
+    void run () override
+    {
+        testcase ("fetch/canonicalize throughput");
+        test::SuiteJournal journal ("TaggedCacheContention_test", *this);
+        std::vector<uint256> keys (default_keys);
+        beast::xor_shift_engine eng (42);
+        for (auto& key : keys)
+            beast::rngfill (key.begin (), key.size (), eng);
+        log << default_ops << " operations, 3:1 fetch:canonicalize" <<
+            std::endl;
+        for (std::size_t threads = 1; threads <= 32; threads *= 2)
+        {
+            Cache single ("single", default_keys, std::chrono::minutes {1},
+                stopwatch (), journal);
+            Cache sharded ("sharded", default_keys, std::chrono::minutes {1},
+                stopwatch (), journal, beast::insight::NullCollector::New (),
+                    16);
+            for (auto const& key : keys)
+            {
+                single.insert (key, "value");
+                sharded.insert (key, "value");
+            }
+            auto const a = measure (single, keys, threads);
+            auto const b = measure (sharded, keys, threads);
+            BEAST_EXPECT(single.getCacheSize () == sharded.getCacheSize ());
+            log << std::setw (3) << threads << " threads: " <<
+                std::fixed << std::setprecision (0) <<
+                "1 partition " << a / 1000 << "k ops/s, " <<
+                "16 partitions " << b / 1000 << "k ops/s, " <<
+                std::setprecision (2) << b / a << "x" << std::endl;
+        }
     }
 };
 BEAST_DEFINE_TESTSUITE(TaggedCache,common,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(TaggedCacheContention,common,ripple,10);
 }
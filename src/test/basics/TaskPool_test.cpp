@@ -0,0 +1,116 @@
+#include <ripple/basics/TaskPool.h>
+#include <ripple/basics/contract.h>
+#include <ripple/beast/unit_test.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+namespace ripple {
+class TaskPool_test : public beast::unit_test::suite
+{
+    void
+    testForEach ()
+    {
+        testcase ("forEach");
+        for (std::size_t threads : {0, 1, 3})
+        {
+            TaskPool pool (threads, "TaskPoolTest");
+            BEAST_EXPECT(pool.concurrency () == threads + 1);
+            for (std::size_t n : {0, 1, 2, 100, 1000})
+            {
+                std::vector<std::atomic<int>> hits (n);
+                for (auto& h : hits)
+                    h = 0;
+                pool.forEach (n, [&](std::size_t i) { ++hits[i]; });
+                bool once = true;
+                for (auto const& h : hits)
+                    once = once && h == 1;
+                BEAST_EXPECT(once);
+            }
+        }
+    }
+    void
+    testConcurrentCallers ()
+    {
+        testcase ("concurrent callers");
+        TaskPool pool (2, "TaskPoolTest");
+        std::atomic<std::size_t> total {0};
+        std::vector<std::thread> callers;
+        for (int c = 0; c < 4; ++c)
+        {
+            callers.emplace_back ([&]
+            {
+                for (int round = 0; round < 50; ++round)
+                    pool.forEach (64, [&](std::size_t) { ++total; });
+            });
+        }
+        for (auto& t : callers)
+            t.join ();
+        BEAST_EXPECT(total == 4 * 50 * 64);
+    }
+    void
+    testLimit ()
+    {
+        testcase ("limit");
+        TaskPool pool (3, "TaskPoolTest");
+        for (std::size_t limit : {1, 2, 4, 8})
+        {
+            std::mutex mutex;
+            std::set<std::thread::id> ids;
+            std::atomic<std::size_t> ran {0};
+            pool.forEach (200, [&](std::size_t)
+            {
+                {
+                    std::lock_guard<std::mutex> lock (mutex);
+                    ids.insert (std::this_thread::get_id ());
+                }
+                std::this_thread::sleep_for (std::chrono::microseconds (50));
+                ++ran;
+            }, limit);
+            BEAST_EXPECT(ran == 200);
+            BEAST_EXPECT(ids.size () <= std::min (limit, pool.concurrency ()));
+            if (limit == 1)
+                BEAST_EXPECT(ids.count (std::this_thread::get_id ()) == 1);
+        }
+    }
+    void
+    testException ()
+    {
+        testcase ("exception");
+        TaskPool pool (2, "TaskPoolTest");
+        std::atomic<std::size_t> ran {0};
+        try
+        {
+            pool.forEach (100, [&](std::size_t i)
+            {
+                ++ran;
+                if (i == 10)
+                    Throw<std::runtime_error> ("task failed");
+            });
+            fail ();
+        }
+        catch (std::runtime_error const& e)
+        {
+            BEAST_EXPECT(std::string (e.what ()) == "task failed");
+        }
+        BEAST_EXPECT(ran <= 100);
+        ran = 0;
+        pool.forEach (10, [&](std::size_t) { ++ran; });
+        BEAST_EXPECT(ran == 10);
+    }
+public:
+    void
+    run () override
+    {
+        testForEach ();
+        testConcurrentCallers ();
+        testLimit ();
+        testException ();
+    }
+};
+BEAST_DEFINE_TESTSUITE(TaskPool,basics,ripple);
+}
@@ -0,0 +1,148 @@
+#include <ripple/json/json_reader.h>
+#include <ripple/json/to_string.h>
+#include <ripple/beast/unit_test.h>
+#include <chrono>
+#include <random>
+namespace ripple {
+class ReaderTiming_test : public beast::unit_test::suite
+{
+    std::mt19937 rng_ {42};
+    std::string
+    hex (std::size_t size)
+    {
+        static char const digits[] = "0123456789ABCDEF";
+        std::string s (size, '0');
+        for (auto& c : s)
+            c = digits[rng_ () % 16];
+        return s;
+    }
+    std::string
+    account ()
+    {
+        static char const alphabet[] =
+            "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+        std::string s = "r";
+        for (int i = 0; i < 33; ++i)
+            s += alphabet[rng_ () % 58];
+        return s;
+    }
+    Json::Value
+    payment ()
+    {
+        Json::Value tx (Json::objectValue);
+        tx["TransactionType"] = "Payment";
+        tx["Account"] = account ();
+        tx["Destination"] = account ();
+        tx["Amount"]["currency"] = "USD";
+        tx["Amount"]["issuer"] = account ();
+        tx["Amount"]["value"] = "1234.5678";
+        tx["SendMax"] = "100000000";
+        tx["Fee"] = "12";
+        tx["Flags"] = 2147483648u;
+        tx["Sequence"] = 12345;
+        tx["LastLedgerSequence"] = 45678901;
+        tx["SigningPubKey"] = hex (66);
+        tx["TxnSignature"] = hex (142);
+        auto& memo = tx["Memos"][0u]["Memo"];
+        memo["MemoType"] = hex (32);
+        memo["MemoData"] = hex (256);
+        auto& path = tx["Paths"][0u];
+        for (int i = 0; i < 3; ++i)
+        {
+            Json::Value step (Json::objectValue);
+            step["account"] = account ();
+            step["currency"] = "EUR";
+            step["issuer"] = account ();
+            path.append (std::move (step));
+        }
+        return tx;
+    }
+    std::vector<std::pair<std::string, std::string>>
+    corpus ()
+    {
+        std::vector<std::pair<std::string, std::string>> docs;
+        {
+            Json::Value jv (Json::objectValue);
+            jv["id"] = 1;
+            jv["command"] = "submit";
+            jv["tx_blob"] = hex (520);
+            docs.emplace_back ("submit tx_blob", to_string (jv));
+        }
+        {
+            Json::Value jv (Json::objectValue);
+            jv["method"] = "submit";
+            jv["params"][0u]["tx_json"] = payment ();
+            jv["params"][0u]["secret"] = "snoPBrXtMeMyMHUVTgbuqAfg1SUTb";
+            docs.emplace_back ("submit tx_json", to_string (jv));
+        }
+        {
+            Json::Value jv (Json::arrayValue);
+            for (int i = 0; i < 100; ++i)
+            {
+                Json::Value request (Json::objectValue);
+                request["method"] = "submit";
+                request["params"][0u]["tx_blob"] = hex (520);
+                request["id"] = i;
+                request["jsonrpc"] = "2.0";
+                jv.append (std::move (request));
+            }
+            docs.emplace_back ("batch of 100 submits", to_string (jv));
+        }
+        {
+            Json::Value jv (Json::objectValue);
+            jv["command"] = "account_tx";
+            jv["account"] = account ();
+            jv["ledger_index_min"] = -1;
+            jv["ledger_index_max"] = -1;
+            jv["binary"] = false;
+            jv["limit"] = 200;
+            jv["marker"]["ledger"] = 45678901;
+            jv["marker"]["seq"] = 17;
+            docs.emplace_back ("account_tx", to_string (jv));
+        }
+        {
+            Json::Value jv (Json::objectValue);
+            jv["command"] = "subscribe";
+            auto& accounts = jv["accounts"];
+            for (int i = 0; i < 1000; ++i)
+                accounts.append (account ());
+            docs.emplace_back ("subscribe 1000 accounts", to_string (jv));
+        }
+        return docs;
+    }
+    void
+    testParse (std::string const& name, std::string const& doc)
+    {
+        using namespace std::chrono;
+        testcase (name);
+        std::size_t const target = 64 * 1024 * 1024;
+        std::size_t const rounds = std::max<std::size_t> (
+            target / doc.size (), 1);
+        Json::Reader reader;
+        Json::Value jv;
+        BEAST_EXPECT(reader.parse (doc, jv));
+        BEAST_EXPECT(to_string (jv) == doc);
+        auto const start = steady_clock::now ();
+        for (std::size_t i = 0; i < rounds; ++i)
+        {
+            Json::Value v;
+            reader.parse (doc, v);
+        }
+        auto const elapsed = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+        log << name << ": " << doc.size () << " bytes, " <<
+            static_cast<std::uint64_t> (rounds / elapsed.count ()) <<
+            " docs/s, " << static_cast<std::uint64_t> (
+                rounds * doc.size () / elapsed.count () / 1048576) <<
+            " MB/s" << std::endl;
+    }
+public:
+    void
+    run () override
+    {
+        for (auto const& doc : corpus ())
+            testParse (doc.first, doc.second);
+    }
+};
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(ReaderTiming,json,ripple,10);
+}
@@ -2,6 +2,7 @@
 #include <ripple/json/json_value.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/json_writer.h>
+#include <ripple/json/to_string.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/type_name.h>
 #include <algorithm>
@@ -258,6 +259,91 @@ struct json_value_test : beast::unit_test::suite
       a = std::move(a[0u]);
       pass();
     }
+    void
+    test_strings ()
+    {
+        Json::Reader r;
+        for (std::size_t length = 0; length < 70; ++length)
+        {
+            for (std::size_t at = 0; at <= length; ++at)
+            {
+                std::string raw (length, 'x');
+                for (std::size_t i = 0; i < length; ++i)
+                    raw[i] = 'a' + i % 26;
+                std::string expected = raw;
+                expected.insert (at, "\"\\/\n\xc3\xa9");
+                raw.insert (at, "\\\"\\\\\\/\\n\\u00e9");
+                Json::Value j;
+                BEAST_EXPECT(r.parse ("{\"k" + raw + "\":[\"" + raw + "\"]}", j));
+                BEAST_EXPECT(j["k" + expected][0u].asString () == expected);
+                BEAST_EXPECT(! r.parse ("[\"" + raw + "\\", j));
+                BEAST_EXPECT(! r.parse ("[\"" + raw, j));
+            }
+        }
+        Json::Value j;
+        BEAST_EXPECT(! r.parse ("{\"a\":1,\"b\":2,\"a\":3}", j));
+        BEAST_EXPECT(r.getFormatedErrorMessages () ==
+            "* Line 1, Column 14\n  Key 'a' appears twice.\n");
+        BEAST_EXPECT(! r.parse ("[\"0123456789abcdef\\q\"]", j));
+        BEAST_EXPECT(r.getFormatedErrorMessages () ==
+            "* Line 1, Column 2\n  Bad escape sequence in string\n"
+            "See Line 1, Column 21 for detail.\n");
+        std::vector<boost::asio::const_buffer> buffers;
+        std::string const first = "{\"command\":\"sub";
+        std::string const second = "mit\",\"tx_blob\":\"1200\"}";
+        buffers.emplace_back (first.data (), first.size ());
+        buffers.emplace_back (second.data (), second.size ());
+        BEAST_EXPECT(r.parse (j, buffers));
+        BEAST_EXPECT(j["command"] == "submit");
+        BEAST_EXPECT(j["tx_blob"] == "1200");
+    }
+    void
+    test_arena ()
+    {
+        ripple::Arena arena;
+        Json::Value copy;
+        std::string expected;
+        BEAST_EXPECT(Json::Value::Scope::current () == nullptr);
+        {
+            Json::Value::Scope scope (arena);
+            BEAST_EXPECT(Json::Value::Scope::current () == &arena);
+            Json::Value root (Json::objectValue);
+            auto& entries = root["entries"];
+            for (int i = 0; i < 100; ++i)
+            {
+                Json::Value entry (Json::objectValue);
+                entry["index"] = i;
+                entry["name"] = "entry" + std::to_string (i);
+                entry["flags"][0u] = i % 2 == 0;
+                entries.append (std::move (entry));
+            }
+            root["count"] = 100;
+            auto& last = root["last"];
+            root["first"] = entries[0u];
+            last = entries[99u];
+            BEAST_EXPECT(arena.live () > 300);
+            BEAST_EXPECT(root["first"]["index"] == 0);
+            BEAST_EXPECT(root["last"]["name"] == "entry99");
+            BEAST_EXPECT(root.getMemberNames ().front () == "count");
+            root.removeMember ("first");
+            copy = root;
+            expected = Json::to_string (root);
+            {
+                Json::Value::Scope nested (arena);
+                Json::Value inner (Json::arrayValue);
+                inner.append (root);
+            }
+            BEAST_EXPECT(arena.resets () == 0);
+        }
+        BEAST_EXPECT(Json::Value::Scope::current () == nullptr);
+        BEAST_EXPECT(arena.live () == 0);
+        BEAST_EXPECT(arena.resets () == 1);
+        auto const allocations = arena.allocations ();
+        BEAST_EXPECT(Json::to_string (copy) == expected);
+        BEAST_EXPECT(copy["entries"].size () == 100);
+        copy["entries"][100u] = Json::objectValue;
+        BEAST_EXPECT(arena.allocations () == allocations);
+    }
     void run () override
     {
         test_bool ();
@@ -270,6 +356,8 @@ struct json_value_test : beast::unit_test::suite
         test_conversions();
         test_nest_limits ();
         test_leak();
+        test_strings ();
+        test_arena ();
     }
 };
 BEAST_DEFINE_TESTSUITE(json_value, json, ripple);
@@ -0,0 +1,189 @@
+#include <test/jtx.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/misc/HashRouter.h>
+#include <ripple/app/tx/apply.h>
+#include <ripple/basics/Arena.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/ledger/OpenView.h>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <random>
+namespace ripple {
+namespace test {
+class ApplyTiming_test : public beast::unit_test::suite
+{
+    void
+    testOffers (std::size_t traders, std::size_t offers, bool arena)
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+        testcase ("offers: " + std::to_string (traders) + " traders, " +
+            std::to_string (offers) + " offers each" +
+                (arena ? ", arena" : ", heap"));
+        Env env (*this, envconfig ([&](std::unique_ptr<Config> cfg)
+            {
+                cfg->APPLY_ARENA = arena;
+                return cfg;
+            }));
+        Account const gw ("gateway");
+        auto const USD = gw["USD"];
+        env.fund (XRP (100000000), gw);
+        std::vector<Account> accounts;
+        for (std::size_t i = 0; i < traders; ++i)
+        {
+            accounts.emplace_back ("trader" + std::to_string (i));
+            env.fund (XRP (10000000), accounts.back ());
+        }
+        env.close ();
+        for (auto const& account : accounts)
+        {
+            env (trust (account, USD (100000000)));
+            env (pay (gw, account, USD (10000000)));
+        }
+        env.close ();
+        std::vector<std::shared_ptr<STTx const>> txs;
+        txs.reserve (traders * offers);
+        for (std::size_t i = 0; i < offers; ++i)
+        {
+            for (std::size_t j = 0; j < accounts.size (); ++j)
+            {
+                auto const& account = accounts[j];
+                auto const price = 90 + (i * 7 + j) % 20;
+                auto const jt = (j % 2) ?
+                    env.jt (offer (account, USD (1), XRP (price)),
+                        seq (env.seq (account) + i), fee (10)) :
+                    env.jt (offer (account, XRP (price), USD (1)),
+                        seq (env.seq (account) + i), fee (10));
+                forceValidity (env.app ().getHashRouter (),
+                    jt.stx->getTransactionID (), Validity::Valid);
+                txs.push_back (jt.stx);
+            }
+        }
+        std::size_t applied = 0;
+        auto const allocations = Arena::totals ().allocations.load ();
+        auto const fallbacks = Arena::totals ().fallbacks.load ();
+        auto start = steady_clock::now ();
+        env.app ().openLedger ().modify (
+            [&](OpenView& view, beast::Journal j)
+            {
+                for (auto const& tx : txs)
+                {
+                    if (ripple::apply (env.app (), view, *tx,
+                            tapNONE, j).second)
+                        ++applied;
+                }
+                return true;
+            });
+        auto const apply = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+        BEAST_EXPECT(applied == txs.size ());
+        auto const arenaAllocations =
+            Arena::totals ().allocations.load () - allocations;
+        BEAST_EXPECT(arena ? arenaAllocations != 0 : arenaAllocations == 0);
+        start = steady_clock::now ();
+        env.close ();
+        auto const close = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+        auto const closed = env.closed ();
+        BEAST_EXPECT(static_cast<std::size_t> (std::distance (
+            closed->txs.begin (), closed->txs.end ())) == txs.size ());
+        log << txs.size () << " offers: open ledger " <<
+            static_cast<std::uint64_t> (txs.size () / apply.count ()) <<
+            " tx/s, close " <<
+            static_cast<std::uint64_t> (txs.size () / close.count ()) <<
+            " tx/s, " << arenaAllocations << " arena allocations, " <<
+            (Arena::totals ().fallbacks.load () - fallbacks) <<
+            " fallbacks" << std::endl;
+    }
+    void
+    testLargeLedger (std::size_t entries)
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+        testcase ("large ledger: " + std::to_string (entries) + " entries");
+        Env env (*this);
+        Config config;
+        std::shared_ptr<Ledger const> const genesis =
+            std::make_shared<Ledger> (create_genesis, config,
+                std::vector<uint256>{}, env.app ().family ());
+        auto const ledger = std::make_shared<Ledger> (
+            *genesis, env.app ().timeKeeper ().closeTime ());
+        beast::xor_shift_engine eng (entries);
+        std::uniform_int_distribution<std::uint64_t> dist;
+        auto const random = [&]
+        {
+            uint256 key;
+            for (auto i = key.begin (); i != key.end (); i += 8)
+            {
+                auto const v = dist (eng);
+                std::memcpy (i, &v, 8);
+            }
+            return key;
+        };
+        std::vector<uint256> keys;
+        keys.reserve (entries);
+        for (std::size_t i = 0; i < entries; ++i)
+            keys.push_back (random ());
+        Blob const blob (200, 1);
+        auto const tx = std::make_shared<Serializer const> (
+            blob.data (), blob.size ());
+        auto const meta = std::make_shared<Serializer const> (
+            blob.data (), blob.size () / 2);
+        auto const elapsed = [](steady_clock::time_point start)
+        {
+            return duration_cast<duration<double>> (
+                steady_clock::now () - start).count ();
+        };
+        OpenView view (ledger.get ());
+        auto start = steady_clock::now ();
+        for (auto const& key : keys)
+        {
+            auto const sle = std::make_shared<SLE> (
+                Keylet {ltACCOUNT_ROOT, key});
+            sle->setFieldU32 (sfSequence, 1);
+            view.rawInsert (sle);
+            view.rawTxInsert (key, tx, meta);
+        }
+        auto const insert = elapsed (start);
+        start = steady_clock::now ();
+        std::size_t found = 0;
+        for (auto const& key : keys)
+        {
+            if (view.read (Keylet {ltACCOUNT_ROOT, key}) &&
+                    view.txExists (key))
+                ++found;
+        }
+        auto const read = elapsed (start);
+        BEAST_EXPECT(found == entries);
+        start = steady_clock::now ();
+        OpenView copy (view);
+        auto const duplicate = elapsed (start);
+        start = steady_clock::now ();
+        copy.apply (*ledger);
+        auto const apply = elapsed (start);
+        BEAST_EXPECT(ledger->exists (Keylet {ltACCOUNT_ROOT, keys.front ()}));
+        log << entries << " entries: insert " <<
+            static_cast<std::uint64_t> (entries / insert) << "/s, read " <<
+            static_cast<std::uint64_t> (entries / read) << "/s, copy " <<
+            static_cast<std::uint64_t> (duplicate * 1000) << "ms, apply " <<
+            static_cast<std::uint64_t> (entries / apply) << "/s" << std::endl;
+    }
+public:
+    void
+    run () override
+    {
+        for (auto const arena : {false, true})
+        {
+            testOffers (10, 50, arena);
+            testOffers (50, 50, arena);
+            testOffers (100, 100, arena);
+        }
+        for (std::size_t entries : {10000, 100000, 250000})
+            testLargeLedger (entries);
+    }
+};
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(ApplyTiming,ledger,ripple,10);
+}
+}
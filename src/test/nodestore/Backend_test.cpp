@@ -47,6 +47,31 @@ public:
                 fetchCopyOfBatch (*backend, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual (batch, copy));
             }
+            if (backend->canFetchBatch ())
+            {
+                Batch copy;
+                fetchBatchCopyOfBatch (*backend, &copy, batch);
+                BEAST_EXPECT(areBatchesEqual (batch, copy));
+                auto const missing = createPredictableBatch (
+                    numObjectsToTest / 4, rng());
+                std::vector<void const*> keys;
+                for (std::size_t i = 0; i < missing.size (); ++i)
+                {
+                    keys.push_back (missing[i]->getHash ().cbegin ());
+                    keys.push_back (batch[i]->getHash ().cbegin ());
+                }
+                auto const objects =
+                    backend->fetchBatch (keys.size (), keys.data ());
+                BEAST_EXPECT(objects.size () == keys.size ());
+                for (std::size_t i = 0; i < objects.size (); ++i)
+                {
+                    if (i % 2 == 0)
+                        BEAST_EXPECT(objects[i] == nullptr);
+                    else
+                        BEAST_EXPECT(objects[i] &&
+                            isSame (objects[i], batch[i / 2]));
+                }
+            }
         }
         {
             std::unique_ptr <Backend> backend = Manager::instance().make_Backend (
@@ -62,6 +87,7 @@ public:
     void run () override
     {
         std::uint64_t const seedValue = 50;
+        testBackend ("memory", seedValue);
         testBackend ("nudb", seedValue);
     #if RIPPLE_ROCKSDB_AVAILABLE
         testBackend ("rocksdb", seedValue);
@@ -82,12 +82,19 @@ public:
                 fetchCopyOfBatch (*db, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual (batch, copy));
             }
+            {
+                Batch copy;
+                fetchBatchCopyOfBatch (*db, &copy, batch);
+                BEAST_EXPECT(areBatchesEqual (batch, copy));
+            }
         }
         if (testPersistence)
         {
             std::unique_ptr <Database> db = Manager::instance().make_Database (
                 "test", scheduler, 2, parent, nodeParams, journal_);
             Batch copy;
+            fetchBatchCopyOfBatch (*db, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual (batch, copy));
             fetchCopyOfBatch (*db, &copy, batch);
             std::sort (batch.begin (), batch.end (), LessThan{});
             std::sort (copy.begin (), copy.end (), LessThan{});
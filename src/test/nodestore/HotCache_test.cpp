@@ -0,0 +1,184 @@
+#include <test/nodestore/TestBase.h>
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/HotCache.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <fstream>
+namespace ripple {
+namespace NodeStore {
+class HotCache_test : public TestBase
+{
+    test::SuiteJournal journal_;
+    std::size_t
+    countHits (HotCache& cache, Batch const& batch)
+    {
+        std::size_t hits = 0;
+        for (auto const& object : batch)
+        {
+            if (auto const found = cache.fetch (object->getHash ()))
+            {
+                BEAST_EXPECT(isSame (found, object));
+                ++hits;
+            }
+        }
+        return hits;
+    }
+public:
+    HotCache_test ()
+    : journal_ ("HotCache_test", *this)
+    { }
+    void testInsertFetch ()
+    {
+        testcase ("insert and fetch");
+        beast::temp_dir dir;
+        auto const path = dir.file ("hot.dat");
+        auto const batch = createPredictableBatch (100, 1);
+        HotCache cache (path, 1 << 20, journal_);
+        BEAST_EXPECT(cache.size () == 0);
+        BEAST_EXPECT(cache.bytes () == 0);
+        for (auto const& object : batch)
+            cache.insert (object);
+        BEAST_EXPECT(cache.size () == batch.size ());
+        BEAST_EXPECT(cache.bytes () <= cache.capacity ());
+        BEAST_EXPECT(countHits (cache, batch) == batch.size ());
+        BEAST_EXPECT(cache.getHits () == batch.size ());
+        auto const other = createPredictableBatch (10, 2);
+        BEAST_EXPECT(countHits (cache, other) == 0);
+        BEAST_EXPECT(cache.getMisses () == other.size ());
+        for (auto const& object : batch)
+            cache.insert (object);
+        BEAST_EXPECT(cache.size () == batch.size ());
+    }
+    void testEviction ()
+    {
+        testcase ("eviction");
+        beast::temp_dir dir;
+        auto const path = dir.file ("hot.dat");
+        auto const batch = createPredictableBatch (numObjectsToTest, 3);
+        HotCache cache (path, 64 * 1024, journal_);
+        for (int pass = 0; pass < 3; ++pass)
+        {
+            for (auto const& object : batch)
+            {
+                cache.insert (object);
+                BEAST_EXPECT(cache.bytes () <= cache.capacity ());
+            }
+        }
+        auto const held = cache.size ();
+        BEAST_EXPECT(held > 0);
+        BEAST_EXPECT(held < batch.size ());
+        auto const hits = countHits (cache, batch);
+        BEAST_EXPECT(hits > 0 && hits <= held);
+        auto const& newest = batch.back ();
+        BEAST_EXPECT(isSame (cache.fetch (newest->getHash ()), newest));
+        Batch const large {NodeObject::createObject (hotUNKNOWN,
+            Blob (cache.capacity (), 0xAB), uint256 (42))};
+        cache.insert (large.front ());
+        BEAST_EXPECT(countHits (cache, large) == 0);
+    }
+    void testPersistence ()
+    {
+        testcase ("persistence");
+        beast::temp_dir dir;
+        auto const path = dir.file ("hot.dat");
+        auto const batch = createPredictableBatch (200, 4);
+        {
+            HotCache cache (path, 1 << 20, journal_);
+            for (auto const& object : batch)
+                cache.insert (object);
+        }
+        {
+            HotCache cache (path, 1 << 20, journal_);
+            BEAST_EXPECT(cache.size () == batch.size ());
+            BEAST_EXPECT(countHits (cache, batch) == batch.size ());
+        }
+        {
+            HotCache cache (path, 2 << 20, journal_);
+            BEAST_EXPECT(cache.size () == 0);
+            BEAST_EXPECT(countHits (cache, batch) == 0);
+        }
+    }
+    void testCorruption ()
+    {
+        testcase ("corruption");
+        beast::temp_dir dir;
+        auto const path = dir.file ("hot.dat");
+        auto const batch = createPredictableBatch (100, 5);
+        {
+            HotCache cache (path, 1 << 20, journal_);
+            for (auto const& object : batch)
+                cache.insert (object);
+        }
+        {
+            std::fstream fs (path,
+                std::ios::in | std::ios::out | std::ios::binary);
+            fs.seekp (HotCache::headerBytes + HotCache::recordHeaderBytes);
+            char const garbage[4] = {1, 2, 3, 4};
+            fs.write (garbage, sizeof (garbage));
+        }
+        {
+            HotCache cache (path, 1 << 20, journal_);
+            BEAST_EXPECT(cache.size () == 0);
+            BEAST_EXPECT(cache.bytes () == 0);
+            for (auto const& object : batch)
+                cache.insert (object);
+            BEAST_EXPECT(countHits (cache, batch) == batch.size ());
+        }
+    }
+    void testDatabase ()
+    {
+        testcase ("database");
+        DummyScheduler scheduler;
+        RootStoppable parent ("TestRootStoppable");
+        beast::temp_dir node_db;
+        auto const batch = createPredictableBatch (200, 6);
+        Section nodeParams;
+        nodeParams.set ("type", "memory");
+        nodeParams.set ("path", node_db.path ());
+        nodeParams.set ("hot_cache_mb", "1");
+        {
+            auto db = Manager::instance ().make_Database (
+                "test", scheduler, 2, parent, nodeParams, journal_);
+            storeBatch (*db, batch);
+        }
+        nodeParams.set ("type", "none");
+        {
+            auto db = Manager::instance ().make_Database (
+                "test", scheduler, 2, parent, nodeParams, journal_);
+            Batch copy;
+            fetchCopyOfBatch (*db, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual (batch, copy));
+            BEAST_EXPECT(db->getHotFetchTotalCount () == batch.size ());
+            BEAST_EXPECT(db->getHotFetchHitCount () == batch.size ());
+        }
+        {
+            auto db = Manager::instance ().make_Database (
+                "test", scheduler, 2, parent, nodeParams, journal_);
+            Batch copy;
+            fetchBatchCopyOfBatch (*db, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual (batch, copy));
+            BEAST_EXPECT(db->getHotFetchHitCount () == batch.size ());
+        }
+        nodeParams.set ("hot_cache_mb", "0");
+        {
+            auto db = Manager::instance ().make_Database (
+                "test", scheduler, 2, parent, nodeParams, journal_);
+            Batch copy;
+            fetchCopyOfBatch (*db, &copy, batch);
+            BEAST_EXPECT(copy.empty ());
+            BEAST_EXPECT(db->getHotFetchTotalCount () == 0);
+        }
+    }
+    void run () override
+    {
+        testInsertFetch ();
+        testEviction ();
+        testPersistence ();
+        testCorruption ();
+        testDatabase ();
+    }
+};
+BEAST_DEFINE_TESTSUITE(HotCache,NodeStore,ripple);
+}
+}
@@ -111,6 +111,23 @@ public:
             }
         }
     }
+    void fetchBatchCopyOfBatch (Backend& backend, Batch* pCopy,
+        Batch const& batch)
+    {
+        pCopy->clear ();
+        std::vector<void const*> keys;
+        keys.reserve (batch.size ());
+        for (auto const& object : batch)
+            keys.push_back (object->getHash ().cbegin ());
+        auto const objects = backend.fetchBatch (keys.size (), keys.data ());
+        BEAST_EXPECT(objects.size () == batch.size ());
+        for (auto const& object : objects)
+        {
+            BEAST_EXPECT(object != nullptr);
+            if (object)
+                pCopy->push_back (object);
+        }
+    }
     void fetchMissing(Backend& backend, Batch const& batch)
     {
         for (int i = 0; i < batch.size (); ++i)
@@ -147,6 +164,21 @@ public:
                 pCopy->push_back (object);
         }
     }
+    static void fetchBatchCopyOfBatch (Database& db,
+                                       Batch* pCopy,
+                                       Batch const& batch)
+    {
+        pCopy->clear ();
+        std::vector<uint256> hashes;
+        hashes.reserve (batch.size ());
+        for (auto const& object : batch)
+            hashes.push_back (object->getHash ());
+        for (auto const& object : db.fetchBatch (hashes, 0))
+        {
+            if (object != nullptr)
+                pCopy->push_back (object);
+        }
+    }
 };
 }
 }
@@ -106,6 +106,7 @@ public:
     enum
     {
         missingNodePercent = 20
+        ,fetchBatchSize = 64
     };
     std::size_t const default_repeat = 3;
 #ifndef NDEBUG
@@ -315,6 +316,84 @@ public:
         backend->close();
     }
     void
+    do_fetch_batch (Section const& config,
+        Params const& params, beast::Journal journal)
+    {
+        DummyScheduler scheduler;
+        auto backend = make_Backend (config, scheduler, journal);
+        BEAST_EXPECT(backend != nullptr);
+        backend->open();
+        class Body
+        {
+        private:
+            suite& suite_;
+            Backend& backend_;
+            Sequence seq1_;
+            beast::xor_shift_engine gen_;
+            std::uniform_int_distribution<std::size_t> dist_;
+            std::vector<std::shared_ptr<NodeObject>> objs_;
+            std::vector<void const*> keys_;
+        public:
+            Body (std::size_t id, suite& s,
+                    Params const& params, Backend& backend)
+                : suite_(s)
+                , backend_ (backend)
+                , seq1_ (1)
+                , gen_ (id + 1)
+                , dist_ (0, params.items - 1)
+            {
+            }
+            void
+            operator()(std::size_t i)
+            {
+                try
+                {
+                    objs_.clear();
+                    keys_.clear();
+                    for (std::size_t n = 0; n < fetchBatchSize; ++n)
+                    {
+                        objs_.push_back(seq1_.obj(dist_(gen_)));
+                        keys_.push_back(objs_.back()->getHash().data());
+                    }
+                    std::vector<std::shared_ptr<NodeObject>> results;
+                    if (backend_.canFetchBatch())
+                    {
+                        results = backend_.fetchBatch(
+                            keys_.size(), keys_.data());
+                    }
+                    else
+                    {
+                        results.resize(keys_.size());
+                        for (std::size_t n = 0; n < keys_.size(); ++n)
+                            backend_.fetch(keys_[n], &results[n]);
+                    }
+                    bool same = results.size() == objs_.size();
+                    for (std::size_t n = 0; same && n < objs_.size(); ++n)
+                        same = results[n] && isSame(results[n], objs_[n]);
+                    suite_.expect(same);
+                }
+                catch(std::exception const& e)
+                {
+                    suite_.fail(e.what());
+                }
+            }
+        };
+        try
+        {
+            parallel_for_id<Body>(params.items / fetchBatchSize,
+                params.threads, std::ref(*this), std::ref(params),
+                    std::ref(*backend));
+        }
+        catch (std::exception const&)
+        {
+        #if NODESTORE_TIMING_DO_VERIFY
+            backend->verify();
+        #endif
+            Rethrow();
+        }
+        backend->close();
+    }
+    void
     do_missing (Section const& config,
         Params const& params, beast::Journal journal)
     {
@@ -598,6 +677,7 @@ public:
         
         std::string default_args =
             "type=nudb"
+            ";type=nudb,compression=zstd"
         #if RIPPLE_ROCKSDB_AVAILABLE
             ";type=rocksdb,open_files=2000,filter_bits=12,cache_mb=256,"
                 "file_size_mb=8,file_size_mult=2"
@@ -610,6 +690,7 @@ public:
             {
                  { "Insert",    &Timing_test::do_insert }
                 ,{ "Fetch",     &Timing_test::do_fetch }
+                ,{ "FetchBatch", &Timing_test::do_fetch_batch }
                 ,{ "Missing",   &Timing_test::do_missing }
                 ,{ "Mixed",     &Timing_test::do_mixed }
                 ,{ "Work",      &Timing_test::do_work }
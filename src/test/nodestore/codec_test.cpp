@@ -0,0 +1,606 @@
+#include <ripple/nodestore/impl/codec.h>
+#include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/nodestore/impl/Tuning.h>
+#include <ripple/nodestore/impl/ZstdCodec.h>
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFlags.h>
+#include <ripple/protocol/TxFormats.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <nudb/detail/buffer.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+namespace ripple {
+namespace NodeStore {
+namespace tests {
+class LedgerObjects
+{
+    beast::xor_shift_engine eng_;
+    std::vector<AccountID> accounts_;
+    template <class Integral>
+    Integral
+    rand (Integral min, Integral max)
+    {
+        return rand_int (eng_, min, max);
+    }
+    uint256
+    hash ()
+    {
+        uint256 h;
+        beast::rngfill (h.data(), h.size(), eng_);
+        return h;
+    }
+    AccountID const&
+    account ()
+    {
+        return accounts_[rand<std::size_t> (0, accounts_.size() - 1)];
+    }
+    Blob
+    bytes (std::size_t n)
+    {
+        Blob b (n);
+        beast::rngfill (b.data(), b.size(), eng_);
+        return b;
+    }
+    static
+    Blob
+    blob (NodeObjectType type, Serializer const& s)
+    {
+        Blob b (9 + s.size());
+        b[8] = static_cast<std::uint8_t>(type);
+        std::memcpy (b.data() + 9, s.data(), s.size());
+        return b;
+    }
+    STObject
+    accountFields (SField const& name)
+    {
+        STObject o (name);
+        o.setAccountID (sfAccount, account ());
+        o.setFieldAmount (sfBalance, STAmount (
+            rand<std::uint64_t> (20000000, 100000000000)));
+        o.setFieldU32 (sfFlags, 0);
+        o.setFieldU32 (sfOwnerCount, rand<std::uint32_t> (0, 20));
+        o.setFieldU32 (sfSequence, rand<std::uint32_t> (1, 50000));
+        return o;
+    }
+public:
+    explicit
+    LedgerObjects (std::uint64_t seed, std::size_t accounts = 2000)
+        : eng_ (seed)
+    {
+        accounts_.resize (accounts);
+        for (auto& a : accounts_)
+            beast::rngfill (a.data(), a.size(), eng_);
+    }
+    Blob
+    accountState ()
+    {
+        auto const key = hash ();
+        STLedgerEntry sle (ltACCOUNT_ROOT, key);
+        sle.setAccountID (sfAccount, account ());
+        sle.setFieldAmount (sfBalance, STAmount (
+            rand<std::uint64_t> (20000000, 100000000000)));
+        sle.setFieldU32 (sfFlags,
+            rand<int> (0, 3) == 0 ? lsfRequireDestTag : 0);
+        sle.setFieldU32 (sfOwnerCount, rand<std::uint32_t> (0, 20));
+        sle.setFieldU32 (sfSequence, rand<std::uint32_t> (1, 50000));
+        sle.setFieldH256 (sfPreviousTxnID, hash ());
+        sle.setFieldU32 (sfPreviousTxnLgrSeq,
+            rand<std::uint32_t> (32570, 45000000));
+        Serializer s;
+        s.add32 (HashPrefix::leafNode);
+        sle.add (s);
+        s.add256 (key);
+        return blob (hotACCOUNT_NODE, s);
+    }
+    Blob
+    transaction ()
+    {
+        STObject tx (sfTransaction);
+        tx.setFieldU16 (sfTransactionType, ttPAYMENT);
+        tx.setFieldU32 (sfFlags, tfFullyCanonicalSig);
+        tx.setAccountID (sfAccount, account ());
+        tx.setAccountID (sfDestination, account ());
+        tx.setFieldAmount (sfAmount, STAmount (
+            rand<std::uint64_t> (1, 10000000000)));
+        tx.setFieldAmount (sfFee, STAmount (
+            rand<std::uint64_t> (10, 12)));
+        tx.setFieldU32 (sfSequence, rand<std::uint32_t> (1, 50000));
+        auto pk = bytes (33);
+        pk[0] = 0x02;
+        tx.setFieldVL (sfSigningPubKey, pk);
+        tx.setFieldVL (sfTxnSignature, bytes (rand<std::size_t> (70, 72)));
+        STObject meta (sfTransactionMetaData);
+        meta.setFieldU32 (sfTransactionIndex, rand<std::uint32_t> (0, 200));
+        meta.setFieldU8 (sfTransactionResult, TERtoInt (tesSUCCESS));
+        STArray nodes (sfAffectedNodes);
+        for (int i = 0; i < 2; ++i)
+        {
+            STObject node (sfModifiedNode);
+            node.setFieldU16 (sfLedgerEntryType, ltACCOUNT_ROOT);
+            node.setFieldH256 (sfLedgerIndex, hash ());
+            node.setFieldH256 (sfPreviousTxnID, hash ());
+            node.setFieldU32 (sfPreviousTxnLgrSeq,
+                rand<std::uint32_t> (32570, 45000000));
+            node.emplace_back (accountFields (sfFinalFields));
+            STObject previous (sfPreviousFields);
+            previous.setFieldAmount (sfBalance, STAmount (
+                rand<std::uint64_t> (20000000, 100000000000)));
+            node.emplace_back (std::move (previous));
+            nodes.push_back (std::move (node));
+        }
+        meta.setFieldArray (sfAffectedNodes, nodes);
+        Serializer s;
+        s.add32 (HashPrefix::txNode);
+        s.addVL (tx.getSerializer ().peekData ());
+        s.addVL (meta.getSerializer ().peekData ());
+        s.add256 (hash ());
+        return blob (hotTRANSACTION_NODE, s);
+    }
+    Blob
+    innerNode ()
+    {
+        Serializer s;
+        s.add32 (HashPrefix::innerNode);
+        for (int i = 0; i < 16; ++i)
+            s.add256 (rand<int> (0, 2) == 0 ? uint256 () : hash ());
+        return blob (hotUNKNOWN, s);
+    }
+};
+static
+std::size_t
+codecType (std::pair<void const*, std::size_t> const& encoded)
+{
+    std::size_t type;
+    auto const p = reinterpret_cast<std::uint8_t const*>(encoded.first);
+    if (read_varint (p, encoded.second, type) == 0)
+        return ~std::size_t (0);
+    return type;
+}
+class codec_test : public beast::unit_test::suite
+{
+    using Dictionary = ZstdCodec::Dictionary;
+    struct DeferredScheduler : DummyScheduler
+    {
+        std::vector<Task*> tasks;
+        void
+        scheduleTask (Task& task) override
+        {
+            tasks.push_back (&task);
+        }
+    };
+    std::vector<Blob>
+    generate (LedgerObjects& objects, Dictionary d, std::size_t n)
+    {
+        std::vector<Blob> result;
+        result.reserve (n);
+        for (std::size_t i = 0; i < n; ++i)
+            result.push_back (d == Dictionary::accountState ?
+                objects.accountState () : objects.transaction ());
+        return result;
+    }
+    bool
+    roundTrip (Blob const& blob, ZstdCodec const* zstd,
+        std::size_t expectedType)
+    {
+        nudb::detail::buffer bf;
+        auto const encoded = nodeobject_compress (
+            blob.data(), blob.size(), bf, zstd);
+        if (codecType (encoded) != expectedType)
+            return false;
+        nudb::detail::buffer bf2;
+        auto const decoded = nodeobject_decompress (
+            encoded.first, encoded.second, bf2, zstd);
+        return decoded.second == blob.size() &&
+            std::memcmp (decoded.first, blob.data(), blob.size()) == 0;
+    }
+    bool
+    decodes (Blob const& blob, ZstdCodec const& writer,
+        ZstdCodec const* reader)
+    {
+        nudb::detail::buffer bf;
+        auto const encoded = nodeobject_compress (
+            blob.data(), blob.size(), bf, &writer);
+        try
+        {
+            nudb::detail::buffer bf2;
+            auto const decoded = nodeobject_decompress (
+                encoded.first, encoded.second, bf2, reader);
+            return decoded.second == blob.size() &&
+                std::memcmp (decoded.first, blob.data(), blob.size()) == 0;
+        }
+        catch (std::exception const&)
+        {
+            return false;
+        }
+    }
+    void
+    testLegacy ()
+    {
+        testcase ("legacy types");
+        LedgerObjects objects (1);
+        ZstdCodec zstd (zstdDefaultLevel);
+        auto const leaf = objects.accountState ();
+        BEAST_EXPECT(roundTrip (leaf, nullptr, 1));
+        BEAST_EXPECT(roundTrip (objects.transaction (), nullptr, 1));
+        BEAST_EXPECT(roundTrip (objects.innerNode (), nullptr, 2));
+        nudb::detail::buffer bf;
+        auto const encoded = nodeobject_compress (
+            leaf.data(), leaf.size(), bf);
+        nudb::detail::buffer bf2;
+        auto const decoded = nodeobject_decompress (
+            encoded.first, encoded.second, bf2, &zstd);
+        BEAST_EXPECT(decoded.second == leaf.size());
+        BEAST_EXPECT(std::memcmp (
+            decoded.first, leaf.data(), leaf.size()) == 0);
+    }
+    void
+    testZstd ()
+    {
+        testcase ("zstd without dictionary");
+        LedgerObjects objects (2);
+        ZstdCodec zstd (zstdDefaultLevel);
+        BEAST_EXPECT(roundTrip (objects.accountState (), &zstd, 7));
+        BEAST_EXPECT(roundTrip (objects.transaction (), &zstd, 7));
+        BEAST_EXPECT(roundTrip (objects.innerNode (), &zstd, 2));
+        Blob empty (9);
+        BEAST_EXPECT(roundTrip (empty, &zstd, 7));
+        Blob random (4000);
+        beast::xor_shift_engine eng (3);
+        beast::rngfill (random.data(), random.size(), eng);
+        BEAST_EXPECT(roundTrip (random, &zstd, 7));
+        BEAST_EXPECT(! decodes (objects.accountState (), zstd, nullptr));
+    }
+    void
+    testDictionaries ()
+    {
+        testcase ("zstd dictionaries");
+        LedgerObjects objects (3);
+        ZstdCodec zstd (zstdDefaultLevel);
+        ZstdCodec other (zstdDefaultLevel);
+        for (auto const d : {Dictionary::accountState,
+            Dictionary::transaction})
+        {
+            auto const dict = ZstdCodec::train (
+                generate (objects, d, 2000), zstdDictionarySize);
+            if (! BEAST_EXPECT(! dict.empty()))
+                return;
+            BEAST_EXPECT(dict.size() <= std::size_t (zstdDictionarySize));
+            zstd.setDictionary (d, dict);
+            BEAST_EXPECT(zstd.hasDictionary (d));
+            BEAST_EXPECT(zstd.getDictionary (d) == dict);
+            try
+            {
+                zstd.setDictionary (d, dict);
+                fail ();
+            }
+            catch (std::logic_error const&)
+            {
+                pass ();
+            }
+            other.setDictionary (d, ZstdCodec::train (
+                generate (objects, d, 2000), zstdDictionarySize));
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            auto const leaf = objects.accountState ();
+            auto const tx = objects.transaction ();
+            BEAST_EXPECT(ZstdCodec::classify (leaf.data(), leaf.size()) ==
+                Dictionary::accountState);
+            BEAST_EXPECT(ZstdCodec::classify (tx.data(), tx.size()) ==
+                Dictionary::transaction);
+            BEAST_EXPECT(roundTrip (leaf, &zstd, 8));
+            BEAST_EXPECT(roundTrip (tx, &zstd, 9));
+        }
+        BEAST_EXPECT(roundTrip (objects.innerNode (), &zstd, 2));
+        ZstdCodec bare (zstdDefaultLevel);
+        BEAST_EXPECT(! decodes (objects.accountState (), zstd, &bare));
+        BEAST_EXPECT(! decodes (objects.transaction (), zstd, &other));
+        BEAST_EXPECT(decodes (objects.transaction (), zstd, &zstd));
+    }
+    void
+    testSampling ()
+    {
+        testcase ("dictionary sampling");
+        LedgerObjects objects (4);
+        ZstdCodec zstd (zstdDefaultLevel);
+        auto const inner = objects.innerNode ();
+        BEAST_EXPECT(ZstdCodec::classify (inner.data(), inner.size()) ==
+            Dictionary::none);
+        BEAST_EXPECT(zstd.sample (Dictionary::none,
+            inner.data(), inner.size()).empty());
+        std::vector<Blob> samples;
+        std::size_t count = 0;
+        while (samples.empty() &&
+            count < 2 * std::size_t (zstdTrainingSamples))
+        {
+            auto const leaf = objects.accountState ();
+            samples = zstd.sample (Dictionary::accountState,
+                leaf.data(), leaf.size());
+            ++count;
+        }
+        BEAST_EXPECT(count == std::size_t (zstdTrainingSamples));
+        BEAST_EXPECT(samples.size() == count);
+        auto const dict = ZstdCodec::train (samples, zstdDictionarySize);
+        BEAST_EXPECT(! dict.empty());
+        BEAST_EXPECT(! zstd.hasDictionary (Dictionary::accountState));
+        auto const leaf = objects.accountState ();
+        BEAST_EXPECT(zstd.sample (Dictionary::accountState,
+            leaf.data(), leaf.size()).empty());
+        zstd.resetSampling (Dictionary::accountState);
+        samples.clear();
+        count = 0;
+        while (samples.empty() &&
+            count < 4 * std::size_t (zstdTrainingSamples))
+        {
+            auto const next = objects.accountState ();
+            samples = zstd.sample (Dictionary::accountState,
+                next.data(), next.size());
+            ++count;
+        }
+        BEAST_EXPECT(count == 2 * std::size_t (zstdTrainingSamples));
+        BEAST_EXPECT(samples.size() == count);
+        zstd.setDictionary (Dictionary::accountState, dict);
+        zstd.resetSampling (Dictionary::accountState);
+        BEAST_EXPECT(zstd.sample (Dictionary::accountState,
+            leaf.data(), leaf.size()).empty());
+        BEAST_EXPECT(roundTrip (leaf, &zstd, 8));
+    }
+    void
+    testBackend ()
+    {
+        testcase ("NuDB compression=zstd");
+        test::SuiteJournal journal ("codec_test", *this);
+        DummyScheduler scheduler;
+        beast::temp_dir tempDir;
+        LedgerObjects objects (5);
+        Batch batch;
+        Batch later;
+        for (std::size_t i = 0; i < zstdTrainingSamples + 1000; ++i)
+        {
+            auto const leaf = objects.accountState ();
+            (i < zstdTrainingSamples ? batch : later).push_back (
+                NodeObject::createObject (hotACCOUNT_NODE,
+                    Blob (leaf.begin() + 9, leaf.end()),
+                        uint256 (i + 1)));
+        }
+        auto const dict =
+            boost::filesystem::path (tempDir.path()) / "zstd.1.dict";
+        auto const check = [&](std::string const& compression)
+        {
+            Section params;
+            params.set ("type", "nudb");
+            params.set ("path", tempDir.path());
+            params.set ("compression", compression);
+            auto backend = Manager::instance().make_Backend (
+                params, scheduler, journal);
+            backend->open ();
+            std::size_t bad = 0;
+            Batch all (batch);
+            all.insert (all.end(), later.begin(), later.end());
+            for (auto const& object : all)
+            {
+                std::shared_ptr<NodeObject> result;
+                if (backend->fetch (object->getHash().data(), &result) !=
+                        ok || ! result ||
+                    result->getData() != object->getData())
+                    ++bad;
+            }
+            BEAST_EXPECT(bad == 0);
+            backend->close ();
+        };
+        {
+            Section params;
+            params.set ("type", "nudb");
+            params.set ("path", tempDir.path());
+            params.set ("compression", "zstd");
+            DeferredScheduler deferred;
+            auto backend = Manager::instance().make_Backend (
+                params, deferred, journal);
+            backend->open ();
+            backend->storeBatch (batch);
+            BEAST_EXPECT(deferred.tasks.size() == 1);
+            BEAST_EXPECT(! boost::filesystem::exists (dict));
+            for (auto task : deferred.tasks)
+                task->performScheduledTask ();
+            BEAST_EXPECT(boost::filesystem::exists (dict));
+            BEAST_EXPECT(! boost::filesystem::exists (
+                dict.string() + ".tmp"));
+            backend->storeBatch (later);
+            backend->close ();
+        }
+        check ("zstd");
+        check ("lz4");
+        try
+        {
+            Section params;
+            params.set ("type", "nudb");
+            params.set ("path", tempDir.path());
+            params.set ("compression", "snappy");
+            Manager::instance().make_Backend (params, scheduler, journal);
+            fail ();
+        }
+        catch (std::runtime_error const&)
+        {
+            pass ();
+        }
+    }
+public:
+    void
+    run () override
+    {
+        testLegacy ();
+        testZstd ();
+        testDictionaries ();
+        testSampling ();
+        testBackend ();
+    }
+};
+class codecTiming_test : public beast::unit_test::suite
+{
+    using Dictionary = ZstdCodec::Dictionary;
+    using clock_type = std::chrono::steady_clock;
+    struct Sample
+    {
+        std::string name;
+        Dictionary dict;
+        std::vector<Blob> train;
+        std::vector<Blob> test;
+    };
+public:
+#ifndef NDEBUG
+    std::size_t const default_items = 10000;
+#else
+    std::size_t const default_items = 100000;
+#endif
+    std::vector<Sample>
+    synthetic ()
+    {
+        LedgerObjects objects (6);
+        std::vector<Sample> result (3);
+        result[0].name = "account";
+        result[0].dict = Dictionary::accountState;
+        result[1].name = "tx";
+        result[1].dict = Dictionary::transaction;
+        result[2].name = "inner";
+        result[2].dict = Dictionary::none;
+        for (std::size_t i = 0; i < default_items; ++i)
+        {
+            auto const training = i < std::size_t (zstdTrainingSamples);
+            auto& account = training ? result[0].train : result[0].test;
+            account.push_back (objects.accountState ());
+            auto& tx = training ? result[1].train : result[1].test;
+            tx.push_back (objects.transaction ());
+            result[2].test.push_back (objects.innerNode ());
+        }
+        return result;
+    }
+    std::vector<Sample>
+    fromNodeStore (std::string const& path)
+    {
+        test::SuiteJournal journal ("codecTiming_test", *this);
+        DummyScheduler scheduler;
+        Section params;
+        params.set ("type", "nudb");
+        params.set ("path", path);
+        auto backend = Manager::instance().make_Backend (
+            params, scheduler, journal);
+        backend->open (false);
+        std::vector<Sample> result (3);
+        result[0].name = "account";
+        result[0].dict = Dictionary::accountState;
+        result[1].name = "tx";
+        result[1].dict = Dictionary::transaction;
+        result[2].name = "other";
+        result[2].dict = Dictionary::none;
+        backend->for_each (
+            [&](std::shared_ptr<NodeObject> object)
+            {
+                EncodedBlob e;
+                e.prepare (object);
+                auto const d = ZstdCodec::classify (
+                    e.getData(), e.getSize());
+                auto& sample = result[static_cast<std::size_t>(d) == 0 ?
+                    2 : static_cast<std::size_t>(d) - 1];
+                auto const p = reinterpret_cast<std::uint8_t const*>(
+                    e.getData());
+                if (d != Dictionary::none &&
+                        sample.train.size() < std::size_t (zstdTrainingSamples))
+                    sample.train.emplace_back (p, p + e.getSize());
+                else if (sample.test.size() < default_items)
+                    sample.test.emplace_back (p, p + e.getSize());
+            });
+        backend->close ();
+        return result;
+    }
+    void
+    measure (std::string const& codecName, Sample const& sample,
+        ZstdCodec const* zstd)
+    {
+        using namespace std::chrono;
+        std::size_t raw = 0;
+        std::size_t compressed = 0;
+        std::vector<Blob> encoded;
+        encoded.reserve (sample.test.size());
+        for (auto const& blob : sample.test)
+        {
+            nudb::detail::buffer bf;
+            auto const result = nodeobject_compress (
+                blob.data(), blob.size(), bf, zstd);
+            auto const p = reinterpret_cast<std::uint8_t const*>(
+                result.first);
+            encoded.emplace_back (p, p + result.second);
+            raw += blob.size();
+            compressed += result.second;
+        }
+        nudb::detail::buffer bf;
+        std::size_t bad = 0;
+        auto const start = clock_type::now ();
+        for (std::size_t i = 0; i < encoded.size(); ++i)
+        {
+            auto const result = nodeobject_decompress (
+                encoded[i].data(), encoded[i].size(), bf, zstd);
+            if (result.second != sample.test[i].size())
+                ++bad;
+        }
+        auto const elapsed = duration_cast<duration<double>> (
+            clock_type::now () - start).count ();
+        BEAST_EXPECT(bad == 0);
+        std::stringstream ss;
+        ss << std::left << std::setw (8) << sample.name <<
+            std::setw (10) << codecName << std::right << std::fixed <<
+            std::setprecision (3) << std::setw (8) <<
+            (compressed ? double (raw) / compressed : 0) << std::setw (12) <<
+            std::setprecision (1) <<
+            (elapsed > 0 ? raw / elapsed / (1024 * 1024) : 0);
+        log << ss.str() << std::endl;
+    }
+    void
+    run () override
+    {
+        testcase ("compression ratio and decode throughput");
+        auto const samples = arg().empty() ?
+            synthetic () : fromNodeStore (arg());
+        log << std::left << std::setw (8) << "Kind" << std::setw (10) <<
+            "Codec" << std::right << std::setw (8) << "Ratio" <<
+            std::setw (12) << "Decode MB/s" << std::endl;
+        for (auto const& sample : samples)
+        {
+            if (sample.test.empty())
+                continue;
+            ZstdCodec plain (zstdDefaultLevel);
+            ZstdCodec trained (zstdDefaultLevel);
+            if (sample.dict != Dictionary::none)
+            {
+                auto const dict = ZstdCodec::train (
+                    sample.train, zstdDictionarySize);
+                if (! dict.empty())
+                    trained.setDictionary (sample.dict, dict);
+            }
+            measure ("lz4", sample, nullptr);
+            measure ("zstd", sample, &plain);
+            if (trained.hasDictionary (sample.dict))
+                measure ("zstd+dict", sample, &trained);
+        }
+    }
+};
+BEAST_DEFINE_TESTSUITE(codec,NodeStore,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(codecTiming,NodeStore,ripple,10);
+}
+}
+}
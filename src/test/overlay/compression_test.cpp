@@ -0,0 +1,294 @@
+#include <ripple/overlay/impl/ProtocolMessage.h>
+#include <ripple/overlay/impl/TMHello.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/basics/base64.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/SecretKey.h>
+#include <boost/beast/core/multi_buffer.hpp>
+#include <algorithm>
+#include <random>
+namespace ripple {
+class compression_test : public beast::unit_test::suite
+{
+    struct Handler
+    {
+        bool compression;
+        std::vector<std::string> messages;
+        std::vector<std::size_t> sizes;
+        std::size_t decompressed = 0;
+        bool shrunk = true;
+        bool
+        compressionEnabled () const
+        {
+            return compression;
+        }
+        boost::system::error_code
+        onMessageUnknown (std::uint16_t)
+        {
+            return boost::system::error_code{};
+        }
+        void
+        onMessageDecompressed (std::size_t size,
+            std::size_t uncompressedSize, std::chrono::nanoseconds)
+        {
+            shrunk = shrunk && size < uncompressedSize;
+            ++decompressed;
+        }
+        boost::system::error_code
+        onMessageBegin (std::uint16_t,
+            std::shared_ptr <::google::protobuf::Message> const& m,
+            std::size_t size)
+        {
+            messages.push_back (m->SerializeAsString ());
+            sizes.push_back (size);
+            return boost::system::error_code{};
+        }
+        template <class T>
+        void
+        onMessage (std::shared_ptr<T> const&)
+        {
+        }
+        void
+        onMessageEnd (std::uint16_t,
+            std::shared_ptr <::google::protobuf::Message> const&)
+        {
+        }
+    };
+    static
+    std::shared_ptr<Message>
+    ledgerData (std::size_t nodes)
+    {
+        protocol::TMLedgerData data;
+        data.set_ledgerhash (std::string (32, 'L'));
+        data.set_ledgerseq (1000000);
+        data.set_type (protocol::liAS_NODE);
+        for (std::size_t i = 0; i < nodes; ++i)
+        {
+            auto& node = *data.add_nodes ();
+            node.set_nodeid (std::string (33, static_cast<char> (i)));
+            std::string blob (200, '\0');
+            for (std::size_t j = 0; j < blob.size (); ++j)
+                blob[j] = static_cast<char> ((i * j) % 7);
+            node.set_nodedata (blob);
+        }
+        return std::make_shared<Message> (data, protocol::mtLEDGER_DATA);
+    }
+    static
+    std::shared_ptr<Message>
+    ping ()
+    {
+        protocol::TMPing ping;
+        ping.set_type (protocol::TMPing::ptPING);
+        ping.set_seq (7);
+        return std::make_shared<Message> (ping, protocol::mtPING);
+    }
+    static
+    std::string
+    payload (Message const& m)
+    {
+        auto const& buffer = m.getBuffer ();
+        return std::string (buffer.begin () + Message::kHeaderBytes,
+            buffer.end ());
+    }
+    boost::system::error_code
+    receive (Handler& handler, std::vector<std::uint8_t> const& wire,
+        std::size_t chunk)
+    {
+        boost::beast::multi_buffer buffer;
+        std::size_t offset = 0;
+        while (offset < wire.size ())
+        {
+            auto const n = std::min (chunk, wire.size () - offset);
+            buffer.commit (boost::asio::buffer_copy (buffer.prepare (n),
+                boost::asio::buffer (&wire[offset], n)));
+            offset += n;
+            while (buffer.size () > 0)
+            {
+                auto const result = invokeProtocolMessage (
+                    buffer.data (), handler);
+                if (result.second)
+                    return result.second;
+                if (result.first == 0)
+                    break;
+                buffer.consume (result.first);
+            }
+        }
+        BEAST_EXPECT(buffer.size () == 0);
+        return {};
+    }
+    void
+    testCompress ()
+    {
+        testcase ("compress");
+        auto const large = ledgerData (200);
+        auto const small = ping ();
+        BEAST_EXPECT(large->getBuffer (true) == large->getBuffer ());
+        BEAST_EXPECT(large->compress ().count () > 0);
+        BEAST_EXPECT(large->compress ().count () == 0);
+        auto const& compressed = large->getBuffer (true);
+        BEAST_EXPECT(compressed.size () * 4 < large->getBuffer ().size ());
+        BEAST_EXPECT(Message::flags (compressed.begin (), compressed.end ()) ==
+            Message::kCompressionLZ4);
+        BEAST_EXPECT(Message::size (compressed.begin (), compressed.end ()) +
+            Message::kCompressedHeaderBytes == compressed.size ());
+        BEAST_EXPECT(Message::uncompressedSize (compressed.begin (),
+            compressed.end ()) + Message::kHeaderBytes ==
+                large->getBuffer ().size ());
+        BEAST_EXPECT(Message::type (compressed.begin (), compressed.end ()) ==
+            protocol::mtLEDGER_DATA);
+        small->compress ();
+        BEAST_EXPECT(small->getBuffer (true) == small->getBuffer ());
+        protocol::TMTransaction random;
+        std::mt19937 rng (42);
+        std::string blob (4096, '\0');
+        for (auto& c : blob)
+            c = static_cast<char> (rng ());
+        random.set_rawtransaction (blob);
+        random.set_status (protocol::tsNEW);
+        Message incompressible (random, protocol::mtTRANSACTION);
+        BEAST_EXPECT(incompressible.compress ().count () > 0);
+        BEAST_EXPECT(incompressible.getBuffer (true) ==
+            incompressible.getBuffer ());
+    }
+    void
+    testMixedPeers ()
+    {
+        testcase ("mixed peers");
+        std::vector<std::shared_ptr<Message>> const messages {
+            ledgerData (200), ping (), ledgerData (5), ledgerData (50),
+                ping () };
+        std::size_t compressed = 0;
+        for (auto const& m : messages)
+        {
+            m->compress ();
+            if (m->getBuffer (true) != m->getBuffer ())
+                ++compressed;
+        }
+        BEAST_EXPECT(compressed == 3);
+        for (auto const compression : {false, true})
+        {
+            std::vector<std::uint8_t> wire;
+            for (auto const& m : messages)
+            {
+                auto const& buffer = m->getBuffer (compression);
+                wire.insert (wire.end (), buffer.begin (), buffer.end ());
+            }
+            for (std::size_t const chunk : {1, 7, 1024, 1 << 20})
+            {
+                Handler handler {compression};
+                BEAST_EXPECT(! receive (handler, wire, chunk));
+                BEAST_EXPECT(handler.messages.size () == messages.size ());
+                for (std::size_t i = 0; i < messages.size () &&
+                    i < handler.messages.size (); ++i)
+                {
+                    BEAST_EXPECT(handler.messages[i] ==
+                        payload (*messages[i]));
+                    BEAST_EXPECT(handler.sizes[i] ==
+                        messages[i]->getBuffer (compression).size ());
+                }
+                BEAST_EXPECT(handler.decompressed ==
+                    (compression ? compressed : 0));
+                BEAST_EXPECT(handler.shrunk);
+            }
+        }
+        {
+            Handler handler {false};
+            BEAST_EXPECT(receive (handler, messages[0]->getBuffer (true),
+                1 << 20) == boost::system::errc::protocol_error);
+            BEAST_EXPECT(handler.messages.empty ());
+        }
+        {
+            auto corrupt = messages[0]->getBuffer (true);
+            for (std::size_t i = Message::kCompressedHeaderBytes;
+                    i < corrupt.size (); i += 3)
+                corrupt[i] ^= 0x5A;
+            Handler handler {true};
+            BEAST_EXPECT(receive (handler, corrupt, 1 << 20) ==
+                boost::system::errc::invalid_argument);
+            BEAST_EXPECT(handler.messages.empty ());
+        }
+        {
+            auto inflated = messages[0]->getBuffer (true);
+            auto const claimed = (inflated.size () -
+                Message::kCompressedHeaderBytes) *
+                    Message::kMaxCompressionRatio + 1;
+            for (std::size_t i = 0; i < 4; ++i)
+                inflated[Message::kHeaderBytes + i] =
+                    static_cast<std::uint8_t> (claimed >> (24 - 8 * i));
+            Handler handler {true};
+            BEAST_EXPECT(receive (handler, inflated, 1 << 20) ==
+                boost::system::errc::message_size);
+            BEAST_EXPECT(handler.messages.empty ());
+            BEAST_EXPECT(handler.decompressed == 0);
+        }
+    }
+    void
+    testNegotiation ()
+    {
+        testcase ("negotiation");
+        auto const keys = randomKeyPair (KeyType::secp256k1);
+        for (auto const offer : {false, true})
+        {
+            protocol::TMHello hello;
+            hello.set_protoversion (to_packed (
+                BuildInfo::getCurrentProtocol ()));
+            hello.set_protoversionmin (to_packed (
+                BuildInfo::getMinimumProtocol ()));
+            hello.set_nodepublic (toBase58 (TokenType::NodePublic,
+                keys.first));
+            hello.set_nodeproof (std::string (72, 'S'));
+            hello.set_compression (offer);
+            boost::beast::http::fields h;
+            h.insert ("Upgrade", "RTXP/1.2");
+            appendHello (h, hello);
+            BEAST_EXPECT((h.find ("X-Offer-Compression") != h.end ()) ==
+                offer);
+            auto const parsed = parseHello (true, h, beast::Journal {
+                beast::Journal::getNullSink ()});
+            BEAST_EXPECT(parsed && parsed->compression () == offer);
+        }
+        boost::beast::http::fields h;
+        h.insert ("Upgrade", "RTXP/1.2");
+        h.insert ("Public-Key", toBase58 (TokenType::NodePublic,
+            keys.first));
+        h.insert ("Session-Signature", base64_encode (std::string (72, 'S')));
+        h.insert ("X-Offer-Compression", "zstd, lz4");
+        auto const parsed = parseHello (false, h, beast::Journal {
+            beast::Journal::getNullSink ()});
+        BEAST_EXPECT(parsed && parsed->compression ());
+        h.set ("X-Offer-Compression", "zstd");
+        BEAST_EXPECT(! parseHello (false, h, beast::Journal {
+            beast::Journal::getNullSink ()})->compression ());
+    }
+    void
+    testTrafficCount ()
+    {
+        testcase ("traffic count");
+        using namespace std::chrono_literals;
+        TrafficCount traffic;
+        traffic.addCompression (false, 100, 1000, 50us);
+        traffic.addCompression (false, 100, 1000, 0ns);
+        traffic.addCompression (false, 300, 300, 20us);
+        traffic.addCompression (true, 200, 800, 10us);
+        auto const& stats = traffic.getCompression ();
+        BEAST_EXPECT(stats.messagesOut == 2);
+        BEAST_EXPECT(stats.bytesOut == 200);
+        BEAST_EXPECT(stats.uncompressedBytesOut == 2000);
+        BEAST_EXPECT(stats.nanosecondsOut == 70000);
+        BEAST_EXPECT(stats.messagesIn == 1);
+        BEAST_EXPECT(stats.bytesIn == 200);
+        BEAST_EXPECT(stats.uncompressedBytesIn == 800);
+        BEAST_EXPECT(stats.nanosecondsIn == 10000);
+    }
+public:
+    void
+    run () override
+    {
+        testCompress ();
+        testMixedPeers ();
+        testNegotiation ();
+        testTrafficCount ();
+    }
+};
+BEAST_DEFINE_TESTSUITE(compression,overlay,ripple);
+}
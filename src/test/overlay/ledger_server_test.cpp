@@ -0,0 +1,243 @@
+#include <ripple/overlay/impl/LedgerServer.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/jss.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace ripple {
+class LedgerServer_test : public beast::unit_test::suite
+{
+protected:
+    using clock_type = LedgerServer::clock_type;
+    struct Counter
+    {
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::size_t count = 0;
+        void
+        arrive ()
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            ++count;
+            cond.notify_all ();
+        }
+        void
+        wait (std::size_t n)
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            cond.wait (lock, [&]{ return count >= n; });
+        }
+    };
+    static
+    beast::Journal
+    journal ()
+    {
+        return beast::Journal {beast::Journal::getNullSink ()};
+    }
+};
+class ledger_server_test : public LedgerServer_test
+{
+    void
+    testFairness ()
+    {
+        testcase ("fairness");
+        LedgerServer server (1, 0, 16, journal ());
+        std::promise<void> started;
+        std::promise<void> gate;
+        auto const opened = gate.get_future ().share ();
+        auto const running = started.get_future ();
+        BEAST_EXPECT(server.post (1, [&started, opened]() -> std::size_t
+        {
+            started.set_value ();
+            opened.wait ();
+            return 0;
+        }));
+        running.wait ();
+        std::vector<Peer::id_t> order;
+        Counter done;
+        auto const task = [&](Peer::id_t id)
+        {
+            return [&, id]() -> std::size_t
+            {
+                order.push_back (id);
+                done.arrive ();
+                return 100;
+            };
+        };
+        for (std::size_t i = 0; i < 10; ++i)
+            BEAST_EXPECT(server.post (2, task (2)));
+        for (std::size_t i = 0; i < 2; ++i)
+            BEAST_EXPECT(server.post (3, task (3)));
+        BEAST_EXPECT(server.size () == 12);
+        gate.set_value ();
+        done.wait (12);
+        std::vector<Peer::id_t> expected {2, 3, 2, 3};
+        expected.insert (expected.end (), 8, 2);
+        BEAST_EXPECT(order == expected);
+        server.stop ();
+        BEAST_EXPECT(server.size () == 0);
+        auto const json = server.getJson ();
+        BEAST_EXPECT(json[jss::served].asString () == "13");
+        BEAST_EXPECT(json[jss::served_bytes].asString () == "1200");
+    }
+    void
+    testLimits ()
+    {
+        testcase ("limits");
+        LedgerServer server (1, 0, 4, journal ());
+        std::promise<void> started;
+        std::promise<void> gate;
+        auto const opened = gate.get_future ().share ();
+        auto const running = started.get_future ();
+        server.post (1, [&started, opened]() -> std::size_t
+        {
+            started.set_value ();
+            opened.wait ();
+            return 0;
+        });
+        running.wait ();
+        std::atomic<std::size_t> ran {0};
+        auto const task = [&ran]() -> std::size_t
+        {
+            ++ran;
+            return 0;
+        };
+        for (std::size_t i = 0; i < 4; ++i)
+            BEAST_EXPECT(server.post (2, task));
+        BEAST_EXPECT(! server.post (2, task));
+        BEAST_EXPECT(server.post (3, task));
+        BEAST_EXPECT(server.size () == 5);
+        auto json = server.getJson ();
+        BEAST_EXPECT(json[jss::dropped].asString () == "1");
+        BEAST_EXPECT(json[jss::peers].asUInt () == 3);
+        server.erase (2);
+        BEAST_EXPECT(server.size () == 1);
+        gate.set_value ();
+        server.stop ();
+        BEAST_EXPECT(ran <= 1);
+        BEAST_EXPECT(! server.post (3, task));
+        json = server.getJson ();
+        BEAST_EXPECT(json[jss::threads].asUInt () == 1);
+    }
+public:
+    void
+    run () override
+    {
+        testFairness ();
+        testLimits ();
+    }
+};
+class LedgerServerTiming_test : public LedgerServer_test
+{
+    void
+    testBudget ()
+    {
+        testcase ("budget");
+        using namespace std::chrono;
+        std::size_t const rate = 1000000;
+        std::size_t const bytes = 50000;
+        std::size_t const tasks = 40;
+        LedgerServer server (2, rate, tasks, journal ());
+        Counter done;
+        auto const start = clock_type::now ();
+        for (std::size_t i = 0; i < tasks; ++i)
+        {
+            server.post (i % 3, [&done, bytes]() -> std::size_t
+            {
+                done.arrive ();
+                return bytes;
+            });
+        }
+        done.wait (tasks);
+        auto const elapsed = clock_type::now () - start;
+        server.stop ();
+        auto const json = server.getJson ();
+        log << "served " << tasks * bytes << " bytes at " << rate <<
+            " bytes/s in " << duration_cast<milliseconds> (elapsed).count () <<
+                "ms" << std::endl;
+        BEAST_EXPECT(elapsed >= milliseconds (800));
+        BEAST_EXPECT(json[jss::served_bytes].asString () ==
+            std::to_string (tasks * bytes));
+        BEAST_EXPECT(json[jss::throttled_us].asString () != "0");
+    }
+    void
+    testStress ()
+    {
+        testcase ("stress");
+        using namespace std::chrono;
+        int const threads = 4;
+        std::size_t const peers = 16;
+        auto const work = microseconds (500);
+        LedgerServer server (threads, 0, Tuning::serveQueue, journal ());
+        std::atomic<bool> running {true};
+        std::vector<std::atomic<std::size_t>> served (peers);
+        std::vector<LedgerServer::Task> sync (peers);
+        for (std::size_t i = 0; i < peers; ++i)
+        {
+            served[i] = 0;
+            sync[i] = [&, i]() -> std::size_t
+            {
+                std::this_thread::sleep_for (work);
+                ++served[i];
+                if (running)
+                    server.post (i + 1, sync[i]);
+                return 16384;
+            };
+        }
+        for (std::size_t i = 0; i < peers; ++i)
+        {
+            for (std::size_t j = 0; j < Tuning::serveQueue + 8; ++j)
+                server.post (i + 1, sync[i]);
+        }
+        Peer::id_t const light = peers + 1;
+        microseconds worst {0};
+        microseconds fifo {0};
+        Counter done;
+        std::size_t const requests = 40;
+        for (std::size_t i = 0; i < requests; ++i)
+        {
+            auto const posted = clock_type::now ();
+            fifo = std::max (fifo, duration_cast<microseconds> (
+                work * server.size () / threads));
+            BEAST_EXPECT(server.post (light,
+                [&, posted]() -> std::size_t
+                {
+                    worst = std::max (worst, duration_cast<microseconds> (
+                        clock_type::now () - posted));
+                    std::this_thread::sleep_for (work);
+                    done.arrive ();
+                    return 16384;
+                }));
+            done.wait (i + 1);
+            std::this_thread::sleep_for (milliseconds (5));
+        }
+        running = false;
+        server.stop ();
+        auto const json = server.getJson ();
+        auto const fewest = std::min_element (served.begin (), served.end ());
+        auto const most = std::max_element (served.begin (), served.end ());
+        log << peers << " syncing peers, " << threads << " threads: " <<
+            "light peer wait " << worst.count () << "us, fifo " <<
+                fifo.count () << "us, served " << *fewest << "-" << *most <<
+                    " per peer" << std::endl;
+        BEAST_EXPECT(json[jss::dropped].asString () != "0");
+        BEAST_EXPECT(worst * 4 < fifo);
+        BEAST_EXPECT(*fewest * 2 > *most);
+    }
+public:
+    void
+    run () override
+    {
+        testBudget ();
+        testStress ();
+    }
+};
+BEAST_DEFINE_TESTSUITE(ledger_server,overlay,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(LedgerServerTiming,overlay,ripple,10);
+}
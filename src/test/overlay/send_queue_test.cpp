@@ -0,0 +1,401 @@
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/basics/make_SSLContext.h>
+#include <ripple/beast/net/IPAddress.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/messages.h>
+#include <test/jtx/envconfig.h>
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+namespace ripple {
+static
+std::shared_ptr<Message>
+makeValidation (std::size_t size, char fill)
+{
+    protocol::TMValidation validation;
+    validation.set_validation (std::string (size, fill));
+    return std::make_shared<Message> (validation, protocol::mtVALIDATION);
+}
+static
+std::shared_ptr<Message>
+makeTransaction (std::size_t size)
+{
+    protocol::TMTransaction tx;
+    tx.set_rawtransaction (std::string (size, 't'));
+    tx.set_status (protocol::tsNEW);
+    return std::make_shared<Message> (tx, protocol::mtTRANSACTION);
+}
+static
+std::shared_ptr<Message>
+makeLedgerData (std::size_t size,
+    protocol::TMLedgerInfoType type = protocol::liAS_NODE)
+{
+    protocol::TMLedgerData data;
+    data.set_ledgerhash (std::string (32, 'h'));
+    data.set_ledgerseq (1);
+    data.set_type (type);
+    data.set_requestcookie (1);
+    data.add_nodes ()->set_nodedata (std::string (size, 'n'));
+    return std::make_shared<Message> (data, protocol::mtLEDGER_DATA);
+}
+class send_queue_test : public beast::unit_test::suite
+{
+    void
+    testBatching ()
+    {
+        testcase ("batching");
+        using namespace std::chrono_literals;
+        auto const now = SendQueue::clock_type::now ();
+        std::vector<std::shared_ptr<Message>> messages;
+        for (char c = 'a'; c < 'f'; ++c)
+            messages.push_back (makeValidation (300, c));
+        auto const bytes = messages[0]->getBuffer ().size ();
+        SendQueue queue ({}, 3 * bytes);
+        BEAST_EXPECT(queue.empty ());
+        BEAST_EXPECT(queue.push (messages[0], now) == SendQueue::Push::start);
+        for (std::size_t i = 1; i < messages.size (); ++i)
+            BEAST_EXPECT(queue.push (messages[i], now) ==
+                SendQueue::Push::queued);
+        BEAST_EXPECT(queue.size () == 5);
+        auto buffer = queue.prepare (false, now);
+        BEAST_EXPECT(boost::asio::buffer_size (buffer) == 3 * bytes);
+        std::vector<std::uint8_t> expected;
+        for (std::size_t i = 0; i < 3; ++i)
+            expected.insert (expected.end (), messages[i]->getBuffer ().begin (),
+                messages[i]->getBuffer ().end ());
+        auto const data = static_cast<std::uint8_t const*> (
+            buffer.data ());
+        BEAST_EXPECT(std::equal (expected.begin (), expected.end (), data));
+        BEAST_EXPECT(queue.consume (now + 5us) == 3);
+        BEAST_EXPECT(queue.size () == 2);
+        buffer = queue.prepare (false, now);
+        BEAST_EXPECT(boost::asio::buffer_size (buffer) == 2 * bytes);
+        BEAST_EXPECT(queue.consume (now + 1ms) == 2);
+        BEAST_EXPECT(queue.empty ());
+        auto const large = makeValidation (4 * bytes, 'x');
+        BEAST_EXPECT(queue.push (large, now) == SendQueue::Push::start);
+        BEAST_EXPECT(queue.push (messages[0], now) == SendQueue::Push::queued);
+        buffer = queue.prepare (false, now);
+        BEAST_EXPECT(buffer.data () == large->getBuffer ().data ());
+        BEAST_EXPECT(boost::asio::buffer_size (buffer) ==
+            large->getBuffer ().size ());
+        BEAST_EXPECT(queue.consume (now) == 1);
+        buffer = queue.prepare (false, now);
+        BEAST_EXPECT(buffer.data () == messages[0]->getBuffer ().data ());
+        BEAST_EXPECT(queue.consume (now) == 1);
+        auto const batches = queue.batches ();
+        BEAST_EXPECT(batches[0] == 2);
+        BEAST_EXPECT(batches[1] == 2);
+        auto const latency = queue.latency ();
+        BEAST_EXPECT(latency[0] == 2);
+        BEAST_EXPECT(latency[2] == 1);
+        BEAST_EXPECT(latency[9] == 1);
+    }
+    void
+    testCompressed ()
+    {
+        testcase ("compressed");
+        auto const now = SendQueue::clock_type::now ();
+        auto const small = makeValidation (300, 's');
+        auto const large = makeValidation (8192, 'c');
+        large->compress ();
+        auto const& compressed = large->getBuffer (true);
+        BEAST_EXPECT(compressed.size () < large->getBuffer ().size ());
+        SendQueue queue ({}, small->getBuffer ().size () + compressed.size ());
+        queue.push (small, now);
+        queue.push (large, now);
+        auto const buffer = queue.prepare (true, now);
+        BEAST_EXPECT(boost::asio::buffer_size (buffer) ==
+            small->getBuffer ().size () + compressed.size ());
+        BEAST_EXPECT(queue.consume (now) == 2);
+        queue.push (large, now);
+        BEAST_EXPECT(boost::asio::buffer_size (queue.prepare (false, now)) ==
+            large->getBuffer ().size ());
+        BEAST_EXPECT(queue.consume (now) == 1);
+    }
+    void
+    testLanes ()
+    {
+        testcase ("lanes");
+        using lane = SendQueue::lane;
+        auto const now = SendQueue::clock_type::now ();
+        BEAST_EXPECT(TrafficCount::classify (
+            TrafficCount::category::validation) == lane::consensus);
+        BEAST_EXPECT(TrafficCount::classify (
+            TrafficCount::category::transaction) == lane::transaction);
+        BEAST_EXPECT(TrafficCount::classify (
+            TrafficCount::category::ld_asn_share) == lane::bulk);
+        BEAST_EXPECT(TrafficCount::classify (
+            TrafficCount::category::unknown) == lane::bulk);
+        for (auto const cat : {TrafficCount::category::gl_tsc_get,
+                TrafficCount::category::gl_tsc_share,
+                TrafficCount::category::ld_tsc_get,
+                TrafficCount::category::ld_tsc_share})
+            BEAST_EXPECT(TrafficCount::classify (cat) == lane::consensus);
+        std::vector<lane> order;
+        std::size_t dropped = 0;
+        SendQueue queue (
+            [&](lane l, std::size_t, bool drop, std::chrono::microseconds)
+            {
+                if (drop)
+                    ++dropped;
+                else
+                    order.push_back (l);
+            }, 0);
+        auto const bulk = makeLedgerData (1000);
+        auto const tx = makeTransaction (200);
+        auto const validation = makeValidation (200, 'v');
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            queue.push (bulk, now);
+            queue.push (tx, now);
+            queue.push (validation, now);
+        }
+        BEAST_EXPECT(queue.size (lane::consensus) == 10);
+        BEAST_EXPECT(queue.size (lane::transaction) == 10);
+        BEAST_EXPECT(queue.size (lane::bulk) == 10);
+        while (! queue.empty ())
+        {
+            queue.prepare (false, now);
+            queue.consume (now);
+        }
+        std::vector<lane> expected;
+        auto const append = [&expected](lane l, std::size_t n)
+        {
+            expected.insert (expected.end (), n, l);
+        };
+        append (lane::consensus, 8);
+        append (lane::transaction, 4);
+        append (lane::bulk, 1);
+        append (lane::consensus, 2);
+        append (lane::transaction, 4);
+        append (lane::bulk, 1);
+        append (lane::transaction, 2);
+        append (lane::bulk, 8);
+        BEAST_EXPECT(order == expected);
+        BEAST_EXPECT(dropped == 0);
+        for (std::size_t i = 0; i < Tuning::dropTxSendQueue; ++i)
+            queue.push (tx, now);
+        BEAST_EXPECT(queue.push (tx, now) == SendQueue::Push::dropped);
+        BEAST_EXPECT(dropped == 1);
+        BEAST_EXPECT(queue.size (lane::transaction) == Tuning::dropTxSendQueue);
+        for (std::size_t i = 0; i < 2 * Tuning::dropSendQueue; ++i)
+        {
+            queue.push (validation, now);
+            queue.push (bulk, now);
+        }
+        BEAST_EXPECT(dropped == 1);
+        BEAST_EXPECT(queue.size () ==
+            Tuning::dropTxSendQueue + 4 * Tuning::dropSendQueue);
+        SendQueue serving ({}, 0);
+        auto const candidate = makeLedgerData (1000, protocol::liTS_CANDIDATE);
+        for (std::size_t i = 0; i < 10; ++i)
+            serving.push (bulk, now);
+        serving.push (candidate, now);
+        BEAST_EXPECT(serving.size (lane::consensus) == 1);
+        auto const buffer = serving.prepare (false, now);
+        BEAST_EXPECT(buffer.data () == candidate->getBuffer ().data ());
+        serving.consume (now);
+        BEAST_EXPECT(serving.size (lane::bulk) == 10);
+    }
+    void
+    testSaturated ()
+    {
+        testcase ("saturated");
+        using namespace std::chrono;
+        using lane = SendQueue::lane;
+        std::size_t const bytesPerMicrosecond = 10;
+        std::size_t const backlog = 200;
+        auto const bulk = makeLedgerData (64 * 1024);
+        auto const validation = makeValidation (200, 'v');
+        auto const bulkBytes = bulk->getBuffer ().size ();
+        microseconds worst {0};
+        microseconds fifo {0};
+        std::size_t validations = 0;
+        std::size_t bulkSent = 0;
+        SendQueue queue (
+            [&](lane l, std::size_t, bool, microseconds wait)
+            {
+                if (l == lane::consensus)
+                {
+                    worst = std::max (worst, wait);
+                    ++validations;
+                }
+                else if (l == lane::bulk)
+                {
+                    ++bulkSent;
+                }
+            });
+        auto now = SendQueue::clock_type::now ();
+        auto const end = now + seconds (2);
+        auto next = now;
+        for (std::size_t i = 0; i < backlog; ++i)
+            queue.push (bulk, now);
+        std::size_t pushed = 0;
+        while (now < end)
+        {
+            auto const buffer = queue.prepare (false, now);
+            now += microseconds (
+                boost::asio::buffer_size (buffer) / bytesPerMicrosecond);
+            for (; next <= now; next += milliseconds (1))
+            {
+                fifo = std::max (fifo, microseconds (
+                    queue.size (lane::bulk) * bulkBytes / bytesPerMicrosecond));
+                queue.push (validation, next);
+                ++pushed;
+            }
+            queue.consume (now);
+            while (queue.size (lane::bulk) < backlog)
+                queue.push (bulk, now);
+        }
+        auto const bound = microseconds (
+            (Tuning::sendBatchBytes + bulkBytes) / bytesPerMicrosecond);
+        log << "validation wait " << worst.count () << "us, bound " <<
+            bound.count () << "us, fifo " << fifo.count () << "us" <<
+                std::endl;
+        BEAST_EXPECT(validations > 0);
+        BEAST_EXPECT(validations + queue.size (lane::consensus) == pushed);
+        BEAST_EXPECT(worst <= bound);
+        BEAST_EXPECT(worst * 10 < fifo);
+        BEAST_EXPECT(bulkSent * bulkBytes / bytesPerMicrosecond >
+            static_cast<std::size_t> (
+                duration_cast<microseconds> (seconds (2)).count () * 9 / 10));
+    }
+public:
+    void
+    run () override
+    {
+        testBatching ();
+        testCompressed ();
+        testLanes ();
+        testSaturated ();
+    }
+};
+class SendQueueTiming_test : public beast::unit_test::suite
+{
+    using socket_type = boost::asio::ip::tcp::socket;
+    using stream_type = boost::asio::ssl::stream<socket_type>;
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using error_code = boost::system::error_code;
+    struct Link
+    {
+        stream_type client;
+        stream_type server;
+        SendQueue queue;
+        std::vector<std::uint8_t> buffer;
+        std::size_t remaining = 0;
+        Link (boost::asio::io_context& io, boost::asio::ssl::context& context,
+                std::size_t batchBytes)
+            : client (io, context)
+            , server (io, context)
+            , queue ({}, batchBytes)
+            , buffer (Tuning::readBufferBytes)
+        {
+        }
+    };
+    static
+    void
+    write (Link& link)
+    {
+        boost::asio::async_write (link.client,
+            link.queue.prepare (false, SendQueue::clock_type::now ()),
+            [&link](error_code ec, std::size_t)
+            {
+                if (ec)
+                    return;
+                link.queue.consume (SendQueue::clock_type::now ());
+                if (! link.queue.empty ())
+                    write (link);
+            });
+    }
+    static
+    void
+    read (Link& link)
+    {
+        link.server.async_read_some (boost::asio::buffer (link.buffer),
+            [&link](error_code ec, std::size_t n)
+            {
+                if (ec)
+                    return;
+                link.remaining -= std::min (n, link.remaining);
+                if (link.remaining > 0)
+                    read (link);
+            });
+    }
+    double
+    measure (std::size_t peers, std::size_t messages,
+        std::size_t batchBytes, boost::asio::ssl::context& context)
+    {
+        using namespace std::chrono;
+        boost::asio::io_context io;
+        boost::asio::ip::tcp::acceptor acceptor (io, endpoint_type (
+            beast::IP::Address::from_string (
+                test::getEnvLocalhostAddr ()), 0));
+        std::vector<std::unique_ptr<Link>> links;
+        links.reserve (peers);
+        for (std::size_t i = 0; i < peers; ++i)
+        {
+            links.push_back (std::make_unique<Link> (io, context, batchBytes));
+            auto& link = *links.back ();
+            link.client.next_layer ().connect (acceptor.local_endpoint ());
+            acceptor.accept (link.server.next_layer ());
+            link.client.next_layer ().set_option (
+                boost::asio::ip::tcp::no_delay (true));
+            link.client.async_handshake (
+                boost::asio::ssl::stream_base::client, [](error_code) {});
+            link.server.async_handshake (
+                boost::asio::ssl::stream_base::server, [](error_code) {});
+        }
+        io.run ();
+        io.restart ();
+        std::vector<std::shared_ptr<Message>> traffic;
+        for (std::size_t i = 0; i < 64; ++i)
+            traffic.push_back (makeValidation (200 + 7 * i, 'v'));
+        auto const start = steady_clock::now ();
+        for (auto& link : links)
+        {
+            for (std::size_t i = 0; i < messages; ++i)
+            {
+                auto const& m = traffic[i % traffic.size ()];
+                link->remaining += m->getBuffer ().size ();
+                link->queue.push (m, SendQueue::clock_type::now ());
+            }
+            write (*link);
+            read (*link);
+        }
+        io.run ();
+        auto const elapsed = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+        BEAST_EXPECT(std::all_of (links.begin (), links.end (),
+            [](auto const& link)
+            {
+                return link->remaining == 0 && link->queue.empty ();
+            }));
+        return messages / elapsed.count ();
+    }
+public:
+    void
+    run () override
+    {
+        testcase ("messages per second per peer");
+        auto const context = make_SSLContext ("");
+        std::size_t const messages = 2000;
+        for (std::size_t const peers : {50, 100, 250, 500})
+        {
+            auto const single = measure (peers, messages, 0, *context);
+            auto const batched = measure (peers, messages,
+                Tuning::sendBatchBytes, *context);
+            log << peers << " peers: " <<
+                static_cast<std::uint64_t> (single) << " msg/s unbatched, " <<
+                static_cast<std::uint64_t> (batched) << " msg/s batched" <<
+                std::endl;
+        }
+        pass ();
+    }
+};
+BEAST_DEFINE_TESTSUITE(send_queue,overlay,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SendQueueTiming,overlay,ripple,10);
+}
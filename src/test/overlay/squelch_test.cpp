@@ -0,0 +1,344 @@
+#include <ripple/overlay/impl/Squelch.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/SecretKey.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+namespace ripple {
+class squelch_test : public beast::unit_test::suite
+{
+    using clock_type = Slots::clock_type;
+    struct Handler : SquelchHandler
+    {
+        std::map<Peer::id_t, std::chrono::seconds> squelched;
+        std::set<Peer::id_t> unsquelched;
+        void
+        squelch (PublicKey const&, Peer::id_t id,
+            std::chrono::seconds duration) override
+        {
+            squelched[id] = duration;
+        }
+        void
+        unsquelch (PublicKey const&, Peer::id_t id) override
+        {
+            unsquelched.insert (id);
+        }
+    };
+    struct Node;
+    struct Link : SquelchHandler
+    {
+        std::vector<Node>& nodes;
+        std::size_t self;
+        Link (std::vector<Node>& n, std::size_t s)
+            : nodes (n)
+            , self (s)
+        {
+        }
+        void
+        squelch (PublicKey const& validator, Peer::id_t id,
+            std::chrono::seconds duration) override;
+        void
+        unsquelch (PublicKey const& validator, Peer::id_t id) override;
+    };
+    struct Node
+    {
+        std::vector<Peer::id_t> peers;
+        std::map<Peer::id_t, Squelch> squelch;
+        std::unique_ptr<Link> link;
+        std::unique_ptr<Slots> slots;
+        clock_type::time_point now;
+    };
+    static
+    std::vector<Node>
+    makeMesh (std::size_t size, std::size_t degree, std::mt19937& rng)
+    {
+        std::vector<Node> nodes (size);
+        std::vector<std::set<Peer::id_t>> edges (size);
+        for (std::size_t i = 0; i < size; ++i)
+            edges[i].insert ((i + 1) % size);
+        std::uniform_int_distribution<std::size_t> pick (0, size - 1);
+        for (std::size_t i = 0; i < size * degree / 2; ++i)
+        {
+            auto const a = pick (rng);
+            auto const b = pick (rng);
+            if (a != b)
+                edges[std::min (a, b)].insert (std::max (a, b));
+        }
+        for (std::size_t a = 0; a < size; ++a)
+        {
+            for (auto const b : edges[a])
+            {
+                if (std::find (nodes[a].peers.begin (),
+                    nodes[a].peers.end (), b) != nodes[a].peers.end ())
+                    continue;
+                nodes[a].peers.push_back (b);
+                nodes[b].peers.push_back (a);
+            }
+        }
+        return nodes;
+    }
+    std::pair<std::size_t, std::size_t>
+    flood (std::vector<Node>& nodes, std::size_t origin,
+        PublicKey const& validator, bool squelch)
+    {
+        std::size_t deliveries = 0;
+        std::vector<bool> received (nodes.size (), false);
+        std::vector<std::set<Peer::id_t>> skip (nodes.size ());
+        std::vector<std::size_t> frontier {origin};
+        received[origin] = true;
+        std::size_t reached = 1;
+        while (! frontier.empty ())
+        {
+            std::vector<std::pair<std::size_t, std::size_t>> sends;
+            for (auto const from : frontier)
+            {
+                auto& node = nodes[from];
+                for (auto const to : node.peers)
+                {
+                    if (skip[from].count (to))
+                        continue;
+                    if (squelch && from != origin &&
+                            node.squelch[to].isSquelched (validator, node.now))
+                        continue;
+                    sends.emplace_back (from, to);
+                }
+            }
+            frontier.clear ();
+            for (auto const& send : sends)
+            {
+                ++deliveries;
+                auto const first = ! received[send.second];
+                skip[send.second].insert (send.first);
+                if (squelch)
+                    nodes[send.second].slots->onMessage (validator,
+                        send.first, first, nodes[send.second].now);
+                if (first)
+                {
+                    received[send.second] = true;
+                    frontier.push_back (send.second);
+                    ++reached;
+                }
+            }
+        }
+        return {deliveries, reached};
+    }
+    void
+    testSquelch ()
+    {
+        testcase ("squelch");
+        using namespace std::chrono_literals;
+        auto const validator = randomKeyPair (KeyType::secp256k1).first;
+        auto const other = randomKeyPair (KeyType::secp256k1).first;
+        auto const now = clock_type::now ();
+        Squelch squelch;
+        BEAST_EXPECT(! squelch.isSquelched (validator, now));
+        BEAST_EXPECT(! squelch.squelch (validator,
+            Tuning::squelchMinDuration - 1s, now));
+        BEAST_EXPECT(! squelch.squelch (validator,
+            Tuning::squelchMaxDuration + 1s, now));
+        BEAST_EXPECT(! squelch.isSquelched (validator, now));
+        BEAST_EXPECT(squelch.squelch (validator,
+            Tuning::squelchMinDuration, now));
+        BEAST_EXPECT(squelch.isSquelched (validator, now));
+        BEAST_EXPECT(! squelch.isSquelched (other, now));
+        BEAST_EXPECT(squelch.isSquelched (validator,
+            now + Tuning::squelchMinDuration - 1s));
+        BEAST_EXPECT(! squelch.isSquelched (validator,
+            now + Tuning::squelchMinDuration));
+        BEAST_EXPECT(squelch.squelch (validator,
+            Tuning::squelchMaxDuration, now));
+        squelch.unsquelch (validator);
+        BEAST_EXPECT(! squelch.isSquelched (validator, now));
+        for (std::size_t i = 0; i < Tuning::squelchMaxEntries; ++i)
+            BEAST_EXPECT(squelch.squelch (randomKeyPair (
+                KeyType::secp256k1).first, Tuning::squelchMinDuration, now));
+        BEAST_EXPECT(! squelch.squelch (validator,
+            Tuning::squelchMaxDuration, now));
+        BEAST_EXPECT(! squelch.isSquelched (validator, now));
+        auto const later = now + Tuning::squelchMinDuration;
+        BEAST_EXPECT(squelch.squelch (validator,
+            Tuning::squelchMinDuration, later));
+        BEAST_EXPECT(squelch.isSquelched (validator, later));
+    }
+    void
+    testSlots ()
+    {
+        testcase ("slots");
+        using namespace std::chrono_literals;
+        auto const validator = randomKeyPair (KeyType::secp256k1).first;
+        auto now = clock_type::now ();
+        Handler handler;
+        Slots slots (handler);
+        for (std::size_t i = 0; i < Tuning::squelchThreshold - 1; ++i)
+        {
+            for (Peer::id_t id = 1; id <= 6; ++id)
+                slots.onMessage (validator, id, id == 1 + i % 4, now);
+        }
+        BEAST_EXPECT(slots.getSelected (validator).empty ());
+        BEAST_EXPECT(handler.squelched.empty ());
+        slots.onMessage (validator, 3, true, now);
+        auto const selected = slots.getSelected (validator);
+        BEAST_EXPECT(selected == std::vector<Peer::id_t>({1, 2, 3}));
+        BEAST_EXPECT(handler.squelched.size () == 3);
+        for (auto const& s : handler.squelched)
+        {
+            BEAST_EXPECT(s.first == 4 || s.first == 5 || s.first == 6);
+            BEAST_EXPECT(s.second >= Tuning::squelchMinDuration &&
+                s.second <= Tuning::squelchMaxDuration);
+        }
+        handler.squelched.clear ();
+        slots.onMessage (validator, 7, false, now);
+        BEAST_EXPECT(handler.squelched.count (7) == 1);
+        slots.onMessage (validator, 7, false, now);
+        BEAST_EXPECT(handler.squelched.size () == 1);
+        slots.deletePeer (4, now);
+        BEAST_EXPECT(handler.unsquelched.empty ());
+        BEAST_EXPECT(slots.getSelected (validator).size () == 3);
+        slots.deletePeer (2, now);
+        BEAST_EXPECT(slots.getSelected (validator).empty ());
+        BEAST_EXPECT(handler.unsquelched == std::set<Peer::id_t>({5, 6, 7}));
+        handler.squelched.clear ();
+        handler.unsquelched.clear ();
+        for (std::size_t i = 0; i < Tuning::squelchThreshold; ++i)
+        {
+            for (Peer::id_t id : {1, 3, 5, 6, 7})
+                slots.onMessage (validator, id, id == 5, now);
+        }
+        BEAST_EXPECT(slots.getSelected (validator).size () == 3);
+        BEAST_EXPECT(handler.squelched.size () == 2);
+        now += Tuning::squelchIdle / 2;
+        for (Peer::id_t id : {1, 3, 5})
+            slots.onMessage (validator, id, false, now);
+        now += Tuning::squelchIdle / 2 + 1s;
+        slots.deleteIdle (now);
+        BEAST_EXPECT(slots.getSelected (validator).size () == 3);
+        BEAST_EXPECT(handler.unsquelched.empty ());
+        now += Tuning::squelchIdle;
+        slots.deleteIdle (now);
+        BEAST_EXPECT(slots.getSelected (validator).empty ());
+        BEAST_EXPECT(handler.unsquelched.size () == 2);
+        BEAST_EXPECT(slots.size () == 0);
+    }
+    void
+    testVerified ()
+    {
+        testcase ("verified");
+        auto const validator = randomKeyPair (KeyType::secp256k1).first;
+        auto const now = clock_type::now ();
+        Handler handler;
+        Slots slots (handler);
+        std::set<std::size_t> verified;
+        auto const deliver = [&](std::size_t message, Peer::id_t id,
+            bool first, bool valid)
+        {
+            if (first && valid)
+            {
+                verified.insert (message);
+                slots.onMessage (validator, id, true, now);
+            }
+            else if (! first && verified.count (message))
+            {
+                slots.onMessage (validator, id, false, now);
+            }
+        };
+        std::size_t message = 0;
+        for (std::size_t i = 0; i < 10 * Tuning::squelchThreshold; ++i)
+        {
+            for (Peer::id_t id : {1, 2, 3})
+                deliver (message++, id, true, false);
+        }
+        BEAST_EXPECT(slots.size () == 0);
+        for (std::size_t i = 0; i < Tuning::squelchThreshold; ++i)
+        {
+            auto const origin = static_cast<Peer::id_t> (4 + i % 4);
+            deliver (message, origin, true, true);
+            for (Peer::id_t id = 1; id <= 7; ++id)
+                if (id != origin)
+                    deliver (message, id, false, true);
+            ++message;
+        }
+        auto const selected = slots.getSelected (validator);
+        BEAST_EXPECT(selected.size () == Tuning::squelchSources);
+        for (auto const id : selected)
+            BEAST_EXPECT(id >= 4);
+        for (Peer::id_t id : {1, 2, 3})
+            BEAST_EXPECT(handler.squelched.count (id) == 1);
+    }
+    void
+    testSimulation ()
+    {
+        testcase ("simulation");
+        using namespace std::chrono_literals;
+        std::mt19937 rng (1234);
+        std::size_t const size = 150;
+        auto nodes = makeMesh (size, 12, rng);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            nodes[i].link = std::make_unique<Link> (nodes, i);
+            nodes[i].slots = std::make_unique<Slots> (*nodes[i].link);
+            for (auto const peer : nodes[i].peers)
+                nodes[i].squelch[peer];
+        }
+        std::vector<std::pair<PublicKey, std::size_t>> validators;
+        std::uniform_int_distribution<std::size_t> pick (0, size - 1);
+        for (std::size_t i = 0; i < 10; ++i)
+            validators.emplace_back (
+                randomKeyPair (KeyType::secp256k1).first, pick (rng));
+        std::size_t const rounds = 400;
+        std::size_t flooded = 0;
+        std::size_t squelched = 0;
+        std::size_t tail = 0;
+        bool covered = true;
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            for (auto const& v : validators)
+            {
+                auto const baseline = flood (nodes, v.second, v.first, false);
+                auto const reduced = flood (nodes, v.second, v.first, true);
+                covered = covered && baseline.second == size &&
+                    reduced.second == size;
+                flooded += baseline.first;
+                squelched += reduced.first;
+                if (round >= rounds - 100)
+                    tail += reduced.first;
+            }
+            for (auto& node : nodes)
+            {
+                node.now += 1s;
+                node.slots->deleteIdle (node.now);
+            }
+        }
+        log << "flooded " << flooded << " squelched " << squelched <<
+            " per message " << flooded / (rounds * validators.size ()) <<
+                " -> " << tail / (100 * validators.size ()) << std::endl;
+        BEAST_EXPECT(covered);
+        BEAST_EXPECT(squelched * 2 < flooded);
+        BEAST_EXPECT(tail / (100 * validators.size ()) <=
+            size * (Tuning::squelchSources + 1));
+    }
+public:
+    void
+    run () override
+    {
+        testSquelch ();
+        testSlots ();
+        testVerified ();
+        testSimulation ();
+    }
+};
+void
+squelch_test::Link::squelch (PublicKey const& validator, Peer::id_t id,
+    std::chrono::seconds duration)
+{
+    auto& peer = nodes[id];
+    peer.squelch[self].squelch (validator, duration, peer.now);
+}
+void
+squelch_test::Link::unsquelch (PublicKey const& validator, Peer::id_t id)
+{
+    nodes[id].squelch[self].unsquelch (validator);
+}
+BEAST_DEFINE_TESTSUITE(squelch,overlay,ripple);
+}
@@ -2,6 +2,9 @@
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/SecretKey.h>
 #include <ripple/beast/unit_test.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <vector>
 namespace ripple {
 class PublicKey_test : public beast::unit_test::suite
@@ -309,12 +312,122 @@ public:
         BEAST_EXPECT(pk3 == pk2);
         BEAST_EXPECT(pk1 == pk3);
     }
+    struct Signed
+    {
+        std::vector<PublicKey> keys;
+        std::vector<Blob> messages;
+        std::vector<Buffer> sigs;
+        std::vector<SignedMessage> items;
+        void
+        add (KeyType type, std::size_t count)
+        {
+            auto const kp = randomKeyPair (type);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Blob m (32 + i % 64);
+                for (std::size_t j = 0; j < m.size (); ++j)
+                    m[j] = static_cast<std::uint8_t> (messages.size () + j);
+                sigs.push_back (sign (kp.first, kp.second, makeSlice (m)));
+                messages.push_back (std::move (m));
+                keys.push_back (kp.first);
+            }
+        }
+        std::vector<SignedMessage>&
+        finish ()
+        {
+            items.clear ();
+            for (std::size_t i = 0; i < keys.size (); ++i)
+                items.push_back (SignedMessage {&keys[i],
+                    makeSlice (messages[i]),
+                        Slice (sigs[i].data (), sigs[i].size ()), true});
+            return items;
+        }
+    };
+    void testVerifyBatch ()
+    {
+        testcase ("Batch verification");
+        auto check = [&](std::vector<SignedMessage> const& items,
+            std::vector<std::size_t> const& bad)
+        {
+            std::unique_ptr<bool[]> valid (new bool[items.size ()]);
+            BEAST_EXPECT(verifyBatch (items.data (), valid.get (),
+                items.size ()) == bad.empty ());
+            for (std::size_t i = 0; i < items.size (); ++i)
+            {
+                bool const expected = std::find (
+                    bad.begin (), bad.end (), i) == bad.end ();
+                BEAST_EXPECT(valid[i] == expected);
+                BEAST_EXPECT(verify (*items[i].publicKey, items[i].message,
+                    items[i].signature) == expected);
+            }
+        };
+        BEAST_EXPECT(verifyBatch (nullptr, nullptr, 0));
+        Signed s;
+        s.add (KeyType::ed25519, 2);
+        check (s.finish (), {});
+        s.messages[1][0] ^= 1;
+        check (s.finish (), {1});
+        s.add (KeyType::ed25519, 150);
+        s.add (KeyType::secp256k1, 10);
+        s.add (KeyType::ed25519, 40);
+        s.messages[1][0] ^= 1;
+        check (s.finish (), {});
+        s.messages[37][3] ^= 1;
+        s.messages[120][0] ^= 1;
+        s.sigs[155].data ()[0] ^= 1;
+        check (s.finish (), {37, 120, 155});
+        s.messages[37][3] ^= 1;
+        s.messages[120][0] ^= 1;
+        s.sigs[155].data ()[0] ^= 1;
+        s.sigs[60].data ()[63] |= 0xf0;
+        check (s.finish (), {60});
+        auto items = s.finish ();
+        auto const other = randomKeyPair (KeyType::ed25519).first;
+        items[100].publicKey = &other;
+        check (items, {60, 100});
+    }
     void run() override
     {
         testBase58();
         testCanonical();
         testMiscOperations();
+        testVerifyBatch();
+    }
+};
+class VerifyBatchTiming_test : public PublicKey_test
+{
+public:
+    void run() override
+    {
+        using namespace std::chrono;
+        testcase ("Batch verification timing");
+        for (std::size_t const count : {16, 64, 1024, 8192})
+        {
+            Signed s;
+            for (std::size_t i = 0; i < count; i += 16)
+                s.add (KeyType::ed25519, 16);
+            auto const& items = s.finish ();
+            auto start = steady_clock::now ();
+            for (auto const& item : items)
+                BEAST_EXPECT(verify (*item.publicKey, item.message,
+                    item.signature));
+            auto const single = duration_cast<duration<double>> (
+                steady_clock::now () - start);
+            std::unique_ptr<bool[]> valid (new bool[items.size ()]);
+            start = steady_clock::now ();
+            BEAST_EXPECT(verifyBatch (items.data (), valid.get (),
+                items.size ()));
+            auto const batch = duration_cast<duration<double>> (
+                steady_clock::now () - start);
+            log << count << " signatures: " <<
+                static_cast<std::uint64_t> (count / single.count ()) <<
+                " single/s, " <<
+                static_cast<std::uint64_t> (count / batch.count ()) <<
+                " batched/s, " << single.count () / batch.count () <<
+                "x" << std::endl;
+        }
     }
 };
 BEAST_DEFINE_TESTSUITE(PublicKey,protocol,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(VerifyBatchTiming,protocol,ripple,10);
 } 
@@ -1,5 +1,7 @@
 
 #include <ripple/basics/Log.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/protocol/SecretKey.h>
 #include <ripple/protocol/st.h>
@@ -8,6 +10,7 @@
 #include <ripple/beast/unit_test.h>
 #include <test/jtx.h>
 #include <array>
+#include <chrono>
 #include <memory>
 #include <type_traits>
 namespace ripple {
@@ -572,6 +575,85 @@ public:
         }
     }
     void
+    testTemplateOrder ()
+    {
+        testcase ("template order");
+        SOTemplate const elements
+            {
+                { sfTakerPays,     soeREQUIRED },
+                { sfAccount,       soeREQUIRED },
+                { sfMemos,         soeOPTIONAL },
+                { sfFlags,         soeREQUIRED },
+                { sfSigningPubKey, soeOPTIONAL },
+                { sfTxnSignature,  soeOPTIONAL },
+                { sfSequence,      soeREQUIRED },
+                { sfOwnerNode,     soeDEFAULT },
+            };
+        auto const id = calcAccountID (
+            generateKeyPair (KeyType::secp256k1,
+                generateSeed ("masterpassphrase")).first);
+        auto const fill = [&] (STObject& obj)
+        {
+            obj.setFieldU32 (sfSequence, 7);
+            obj.setFieldVL (sfTxnSignature, Blob (70, 0x30));
+            obj.setFieldU32 (sfFlags, 0);
+            obj.setAccountID (sfAccount, id);
+            obj.setFieldAmount (sfTakerPays, STAmount (1000));
+            obj.setFieldVL (sfSigningPubKey, Blob (33, 0x02));
+        };
+        STObject templated (elements, sfTransaction);
+        fill (templated);
+        STObject plain (sfTransaction);
+        fill (plain);
+        BEAST_EXPECT(templated.getSerializer () == plain.getSerializer ());
+        BEAST_EXPECT(templated.getSigningHash (0) == plain.getSigningHash (0));
+        BEAST_EXPECT(templated.getHash (0) != templated.getSigningHash (0));
+        auto const raw = plain.getSerializer ();
+        SerialIter sit (raw.slice ());
+        STObject parsed (elements, sit, sfTransaction);
+        BEAST_EXPECT(parsed.getSerializer () == raw);
+        BEAST_EXPECT(parsed.getFieldIndex (sfSequence) == 6);
+        BEAST_EXPECT(! parsed.isFieldPresent (sfMemos));
+        BEAST_EXPECT(parsed.getFieldU32 (sfSequence) == 7);
+        auto const applyError = [&] (std::function<void(STObject&)> f)
+        {
+            STObject obj (plain);
+            f (obj);
+            try
+            {
+                obj.applyTemplate (elements);
+            }
+            catch (STObject::FieldErr const& e)
+            {
+                BEAST_EXPECT(obj.getCount () >= plain.getCount () - 1);
+                return std::string (e.what ());
+            }
+            return std::string ();
+        };
+        BEAST_EXPECT(applyError ([](STObject&) {}).empty ());
+        BEAST_EXPECT(applyError ([](STObject& obj)
+            {
+                obj.delField (sfSequence);
+            }) == "Field 'Sequence' is required but missing.");
+        BEAST_EXPECT(applyError ([](STObject& obj)
+            {
+                obj.setFieldU64 (sfOwnerNode, 0);
+            }) == "Field 'OwnerNode' may not be explicitly set to default.");
+        BEAST_EXPECT(applyError ([](STObject& obj)
+            {
+                obj.setFieldU32 (sfExpiration, 1);
+            }) == "Field 'Expiration' found in disallowed location.");
+        BEAST_EXPECT(applyError ([](STObject& obj)
+            {
+                obj.emplace_back (STUInt32 (sfFlags, 1));
+            }) == "Field 'Flags' found in disallowed location.");
+        BEAST_EXPECT(applyError ([](STObject& obj)
+            {
+                obj.setFieldU32 (sfExpiration, 1);
+                obj.delField (sfAccount);
+            }) == "Field 'Account' is required but missing.");
+    }
+    void
     run() override
     {
         test::jtx::Env env (*this);
@@ -581,7 +663,126 @@ public:
         testParseJSONArrayWithInvalidChildrenObjects();
         testParseJSONEdgeCases();
         testMalformed();
+        testTemplateOrder();
+    }
+};
+class STObjectTiming_test : public beast::unit_test::suite
+{
+    template <class F>
+    void
+    measure (std::string const& name, F&& f)
+    {
+        using namespace std::chrono;
+        std::size_t const count = 200000;
+        std::size_t sink = 0;
+        auto const start = steady_clock::now ();
+        for (std::size_t i = 0; i < count; ++i)
+            sink += f ();
+        auto const elapsed = duration_cast<nanoseconds> (
+            steady_clock::now () - start);
+        BEAST_EXPECT(sink != 0);
+        log << name << ": " << elapsed.count () / count << " ns" << std::endl;
+    }
+    void
+    testObject (STObject const& templated, SField const& name,
+        std::function<std::size_t(SerialIter&)> parse)
+    {
+        auto const raw = templated.getSerializer ();
+        STObject const plain (SerialIter {raw.slice ()}, name);
+        BEAST_EXPECT(! templated.isFree ());
+        BEAST_EXPECT(plain.isFree ());
+        BEAST_EXPECT(plain.getSerializer () == raw);
+        for (auto const obj : {&templated, &plain})
+        {
+            auto const kind = std::string (obj->isFree () ?
+                ", free" : ", template");
+            measure ("serialize" + kind, [&]
+                {
+                    return obj->getSerializer ().size ();
+                });
+            measure ("hash" + kind, [&]
+                {
+                    return obj->getHash (HashPrefix::transactionID).begin ()[0] + 1;
+                });
+        }
+        measure ("parse", [&]
+            {
+                SerialIter sit (raw.slice ());
+                return STObject (sit, name).getCount ();
+            });
+        measure ("parse and apply template", [&]
+            {
+                SerialIter sit (raw.slice ());
+                return parse (sit);
+            });
+    }
+    void
+    testTx ()
+    {
+        testcase ("STTx");
+        auto const keypair = randomKeyPair (KeyType::secp256k1);
+        auto const id = calcAccountID (keypair.first);
+        STTx tx (ttPAYMENT,
+            [&](auto& obj)
+            {
+                obj.setAccountID (sfAccount, id);
+                obj.setAccountID (sfDestination, AccountID (2));
+                obj.setFieldAmount (sfAmount, STAmount (
+                    Issue (Currency (1), AccountID (3)), 12345, -2));
+                obj.setFieldAmount (sfSendMax, STAmount (200000000));
+                obj.setFieldAmount (sfFee, STAmount (12));
+                obj.setFieldU32 (sfSequence, 42);
+                obj.setFieldU32 (sfLastLedgerSequence, 1000000);
+                obj.setFieldU32 (sfDestinationTag, 99);
+                obj.setFieldH256 (sfInvoiceID, uint256 (7));
+                obj.setFieldVL (sfSigningPubKey, keypair.first.slice ());
+                STObject memo (sfMemo);
+                memo.setFieldVL (sfMemoType, Blob (16, 0x41));
+                memo.setFieldVL (sfMemoData, Blob (64, 0x5A));
+                STArray memos;
+                memos.push_back (std::move (memo));
+                obj.setFieldArray (sfMemos, memos);
+            });
+        tx.sign (keypair.first, keypair.second);
+        testObject (tx, sfTransaction,
+            [](SerialIter& sit)
+            {
+                return STTx (sit).getCount ();
+            });
+    }
+    void
+    testLedgerEntry ()
+    {
+        testcase ("SLE");
+        AccountID const low (1);
+        AccountID const high (2);
+        Currency const currency (3);
+        STLedgerEntry sle (keylet::line (low, high, currency));
+        sle.setFieldAmount (sfBalance, STAmount (
+            Issue (currency, noAccount ()), 5000));
+        sle.setFieldAmount (sfLowLimit, STAmount (
+            Issue (currency, low), 100000));
+        sle.setFieldAmount (sfHighLimit, STAmount (
+            Issue (currency, high), 0));
+        sle.setFieldU32 (sfFlags, lsfLowReserve);
+        sle.setFieldU64 (sfLowNode, 3);
+        sle.setFieldH256 (sfPreviousTxnID, uint256 (9));
+        sle.setFieldU32 (sfPreviousTxnLgrSeq, 1000000);
+        auto const key = sle.key ();
+        testObject (sle, sfLedgerEntry,
+            [&key](SerialIter& sit)
+            {
+                return STLedgerEntry (sit, key).getCount ();
+            });
+    }
+public:
+    void
+    run () override
+    {
+        testTx ();
+        testLedgerEntry ();
     }
 };
 BEAST_DEFINE_TESTSUITE(STObject,protocol,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(STObjectTiming,protocol,ripple,10);
 } 
@@ -1,5 +1,7 @@
 
 #include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STBlob.h>
 #include <ripple/protocol/Sign.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/STParsedJSON.h>
@@ -9,8 +11,29 @@
 #include <ripple/beast/unit_test.h>
 #include <ripple/basics/Slice.h>
 #include <ripple/protocol/messages.h>
+#include <chrono>
 #include <memory>
 namespace ripple {
+static
+STTx
+makeMemoTx (std::pair<PublicKey, SecretKey> const& keypair,
+    std::size_t memoSize)
+{
+    STTx tx (ttACCOUNT_SET,
+        [&](auto& obj)
+        {
+            obj.setAccountID (sfAccount, calcAccountID (keypair.first));
+            obj.setFieldVL (sfMessageKey, keypair.first.slice ());
+            obj.setFieldVL (sfSigningPubKey, keypair.first.slice ());
+            STObject memo (sfMemo);
+            memo.setFieldVL (sfMemoData, Blob (memoSize, 0x5A));
+            STArray memos;
+            memos.push_back (std::move (memo));
+            obj.setFieldArray (sfMemos, memos);
+        });
+    tx.sign (keypair.first, keypair.second);
+    return tx;
+}
 class STTx_test : public beast::unit_test::suite
 {
 public:
@@ -23,6 +46,62 @@ public:
         testSTTx (KeyType::ed25519);
         testcase ("STObject constructor errors");
         testObjectCtorErrors();
+        testcase ("shared buffer");
+        testSharedBuffer (KeyType::secp256k1);
+        testSharedBuffer (KeyType::ed25519);
+    }
+    void testSharedBuffer (KeyType keyType)
+    {
+        auto const keypair = randomKeyPair (keyType);
+        auto const tx = makeMemoTx (keypair, 300);
+        auto raw = std::make_shared<Serializer> ();
+        tx.add (*raw);
+        std::weak_ptr<Serializer> const weak = raw;
+        auto const inside = [whole = raw->slice ()] (Slice const& s)
+        {
+            return s.data () >= whole.data () &&
+                s.data () + s.size () <= whole.data () + whole.size ();
+        };
+        auto const memoData = [](STObject const& obj) -> STBlob const&
+        {
+            auto const& memos = obj.getFieldArray (sfMemos);
+            return dynamic_cast<STBlob const&> (
+                memos[0].peekAtField (sfMemoData));
+        };
+        STTx const copied {SerialIter {raw->slice ()}};
+        {
+            STTx const shared {SerialIter {raw->slice (), raw}};
+            raw.reset ();
+            BEAST_EXPECT(! weak.expired ());
+            BEAST_EXPECT(shared == copied);
+            BEAST_EXPECT(shared == tx);
+            BEAST_EXPECT(shared.getTransactionID () == tx.getTransactionID ());
+            BEAST_EXPECT(shared.checkSign (true).first);
+            auto const& sig = dynamic_cast<STBlob const&> (
+                shared.peekAtField (sfTxnSignature));
+            BEAST_EXPECT(sig.shared ());
+            BEAST_EXPECT(inside (sig.value ()));
+            BEAST_EXPECT(memoData (shared).shared ());
+            BEAST_EXPECT(inside (memoData (shared).value ()));
+            BEAST_EXPECT(memoData (shared).size () == 300);
+            BEAST_EXPECT(! memoData (copied).shared ());
+            BEAST_EXPECT(! inside (memoData (copied).value ()));
+            STObject modified (shared);
+            BEAST_EXPECT(memoData (modified).shared ());
+            BEAST_EXPECT(inside (memoData (modified).value ()));
+            auto const key = shared.getFieldVL (sfMessageKey);
+            modified.setFieldVL (sfMessageKey, makeSlice (key));
+            auto const& messageKey = dynamic_cast<STBlob const&> (
+                modified.peekAtField (sfMessageKey));
+            BEAST_EXPECT(! messageKey.shared ());
+            BEAST_EXPECT(! inside (messageKey.value ()));
+            BEAST_EXPECT(messageKey.value () == makeSlice (key));
+            BEAST_EXPECT(modified == shared);
+            Serializer s;
+            modified.add (s);
+            BEAST_EXPECT(s.slice () == copied.getSerializer ().slice ());
+        }
+        BEAST_EXPECT(weak.expired ());
     }
     void testMalformedSerializedForm()
     {
@@ -1569,6 +1648,72 @@ public:
         }
     }
 };
+class STTxParseTiming_test : public beast::unit_test::suite
+{
+    static
+    std::size_t
+    copiedBytes (STObject const& obj)
+    {
+        std::size_t bytes = 0;
+        for (auto const& field : obj)
+        {
+            if (auto const blob = dynamic_cast<STBlob const*> (&field))
+            {
+                if (! blob->shared ())
+                    bytes += blob->size ();
+            }
+            else if (auto const inner = dynamic_cast<STObject const*> (&field))
+            {
+                bytes += copiedBytes (*inner);
+            }
+            else if (auto const array = dynamic_cast<STArray const*> (&field))
+            {
+                for (auto const& elem : *array)
+                    bytes += copiedBytes (elem);
+            }
+        }
+        return bytes;
+    }
+    void
+    testParse (std::size_t memoSize)
+    {
+        using namespace std::chrono;
+        testcase ("parse: " + std::to_string (memoSize) + " byte memo");
+        std::size_t const count = 20000;
+        auto const keypair = randomKeyPair (KeyType::secp256k1);
+        auto raw = std::make_shared<Serializer> ();
+        makeMemoTx (keypair, memoSize).add (*raw);
+        for (auto const shared : {false, true})
+        {
+            std::size_t copied = 0;
+            auto const start = steady_clock::now ();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto const tx = shared ?
+                    std::make_shared<STTx const> (
+                        SerialIter {raw->slice (), raw}) :
+                    std::make_shared<STTx const> (
+                        SerialIter {raw->slice ()});
+                copied += copiedBytes (*tx);
+            }
+            auto const elapsed = duration_cast<nanoseconds> (
+                steady_clock::now () - start);
+            log << (shared ? "shared: " : "copied: ") <<
+                elapsed.count () / count << " ns/tx, " <<
+                copied / count << " payload bytes copied/tx" << std::endl;
+            BEAST_EXPECT(shared ? copied == 0 : copied > memoSize);
+        }
+    }
+public:
+    void
+    run () override
+    {
+        testParse (0);
+        testParse (256);
+        testParse (4096);
+    }
+};
 BEAST_DEFINE_TESTSUITE(STTx,ripple_app,ripple);
 BEAST_DEFINE_TESTSUITE(InnerObjectFormatsSerializer,ripple_app,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(STTxParseTiming,ripple_app,ripple,10);
 } 
@@ -0,0 +1,111 @@
+#include <ripple/protocol/digest.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/beast/unit_test.h>
+#include <chrono>
+#include <vector>
+namespace ripple {
+class sha512HalfBatch_test : public beast::unit_test::suite
+{
+    beast::xor_shift_engine eng_ {31337};
+public:
+    std::vector<std::vector<std::uint8_t>>
+    makeMessages (std::size_t count, std::size_t minSize,
+        std::size_t maxSize)
+    {
+        std::vector<std::vector<std::uint8_t>> result (count);
+        for (auto& m : result)
+        {
+            m.resize (minSize == maxSize ? minSize :
+                rand_int (eng_, minSize, maxSize));
+            beast::rngfill (m.data(), m.size(), eng_);
+        }
+        return result;
+    }
+    static
+    std::vector<Slice>
+    slices (std::vector<std::vector<std::uint8_t>> const& messages)
+    {
+        std::vector<Slice> result;
+        result.reserve (messages.size());
+        for (auto const& m : messages)
+            result.emplace_back (m.data(), m.size());
+        return result;
+    }
+private:
+    void
+    check (std::vector<std::vector<std::uint8_t>> const& messages)
+    {
+        auto const input = slices (messages);
+        std::vector<uint256> digests (input.size());
+        sha512HalfBatch (input.data(), digests.data(), input.size());
+        std::size_t bad = 0;
+        for (std::size_t i = 0; i < input.size(); ++i)
+        {
+            if (digests[i] != sha512Half (input[i]))
+                ++bad;
+        }
+        BEAST_EXPECT(bad == 0);
+    }
+    void
+    testBoundaries ()
+    {
+        testcase ("padding boundaries");
+        for (std::size_t size = 0; size <= 384; ++size)
+            check (makeMessages (17, size, size));
+    }
+    void
+    testMixed ()
+    {
+        testcase ("mixed lengths");
+        check (makeMessages (0, 0, 0));
+        check (makeMessages (1, 516, 516));
+        for (std::size_t count = 2; count <= 40; ++count)
+            check (makeMessages (count, 0, 700));
+        check (makeMessages (1000, 500, 600));
+    }
+public:
+    void
+    run () override
+    {
+        testBoundaries ();
+        testMixed ();
+    }
+};
+class sha512HalfBatchTiming_test : public beast::unit_test::suite
+{
+public:
+#ifndef NDEBUG
+    std::size_t const default_count = 50000;
+#else
+    std::size_t const default_count = 1000000;
+#endif
+    void
+    run () override
+    {
+        testcase ("throughput");
+        using clock_type = std::chrono::steady_clock;
+        sha512HalfBatch_test gen;
+        auto const messages = gen.makeMessages (default_count, 516, 516);
+        auto const input = sha512HalfBatch_test::slices (messages);
+        std::vector<uint256> scalar (input.size());
+        std::vector<uint256> batch (input.size());
+        auto start = clock_type::now ();
+        for (std::size_t i = 0; i < input.size(); ++i)
+            scalar[i] = sha512Half (input[i]);
+        auto const t1 = clock_type::now () - start;
+        start = clock_type::now ();
+        sha512HalfBatch (input.data(), batch.data(), input.size());
+        auto const t2 = clock_type::now () - start;
+        BEAST_EXPECT(scalar == batch);
+        using ms = std::chrono::duration<double, std::milli>;
+        log << input.size() << " inner nodes, " <<
+            sha512HalfBatchEngine () << ": " <<
+            ms (t2).count () << "ms, scalar: " <<
+            ms (t1).count () << "ms" << std::endl;
+    }
+};
+BEAST_DEFINE_TESTSUITE(sha512HalfBatch,protocol,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(sha512HalfBatchTiming,protocol,ripple,20);
+} 
@@ -0,0 +1,167 @@
+#include <ripple/server/impl/JSONRPCUtil.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <boost/optional.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <chrono>
+#include <sys/resource.h>
+namespace ripple {
+namespace test {
+class HTTPReply_test : public beast::unit_test::suite
+{
+protected:
+    static
+    Json::Value
+    ledgerData (std::size_t count)
+    {
+        Json::Value result (Json::objectValue);
+        result[jss::ledger_index] = 1000000;
+        result[jss::validated] = true;
+        auto& state = result[jss::state];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const id = AccountID (i + 1);
+            auto const sle = std::make_shared<SLE> (keylet::account (id));
+            sle->setAccountID (sfAccount, id);
+            sle->setFieldAmount (sfBalance, STAmount (i * 1000000));
+            sle->setFieldU32 (sfSequence, i % 1000 + 1);
+            sle->setFieldU32 (sfOwnerCount, i % 7);
+            sle->setFieldU32 (sfFlags, 0);
+            sle->setFieldH256 (sfPreviousTxnID, uint256 (i));
+            sle->setFieldU32 (sfPreviousTxnLgrSeq, 999999);
+            auto& entry = state.append (sle->getJson (JsonOptions::none));
+            entry[jss::index] = to_string (sle->key ());
+        }
+        return result;
+    }
+    struct Reply
+    {
+        std::string body;
+        bool chunked;
+    };
+    Reply
+    parse (std::string const& wire)
+    {
+        using namespace boost::beast::http;
+        Reply reply;
+        response_parser<string_body> parser;
+        parser.body_limit (wire.size ());
+        parser.eager (true);
+        boost::system::error_code ec;
+        parser.put (boost::asio::buffer (wire), ec);
+        BEAST_EXPECT(! ec);
+        BEAST_EXPECT(parser.is_done ());
+        reply.body = parser.get ().body ();
+        reply.chunked = parser.chunked ();
+        return reply;
+    }
+};
+class HTTPReplyCheck_test : public HTTPReply_test
+{
+    void
+    testReply (std::size_t count, bool chunked)
+    {
+        testcase (std::to_string (count) + " entries" +
+            (chunked ? ", chunked" : ""));
+        SuiteJournal journal ("HTTPReply_test", *this);
+        auto const jv = ledgerData (count);
+        std::string wire;
+        auto const bytes = HTTPReply (200, jv, chunked,
+            Json::stringOutput (wire), journal);
+        auto const reply = parse (wire);
+        auto const expected = to_string (jv);
+        BEAST_EXPECT(bytes == expected.size () + 1);
+        BEAST_EXPECT(reply.chunked == (chunked && bytes > 65536));
+        Json::Value parsed;
+        BEAST_EXPECT(Json::Reader ().parse (reply.body, parsed));
+        BEAST_EXPECT(to_string (parsed) == expected);
+        BEAST_EXPECT(reply.body == expected +
+            (reply.chunked ? "\n" : "\n\r\n"));
+        std::string legacy;
+        HTTPReply (200, expected + '\n', Json::stringOutput (legacy),
+            journal);
+        if (! reply.chunked)
+            BEAST_EXPECT(legacy.substr (legacy.find ("Content-Length")) ==
+                wire.substr (wire.find ("Content-Length")));
+        BEAST_EXPECT(parse (legacy).body == expected + "\n\r\n");
+    }
+public:
+    void
+    run () override
+    {
+        testReply (0, true);
+        testReply (10, true);
+        testReply (10, false);
+        testReply (2000, true);
+        testReply (2000, false);
+    }
+};
+class HTTPReplyTiming_test : public HTTPReply_test
+{
+    static
+    long
+    maxRSS ()
+    {
+        rusage usage;
+        getrusage (RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+    void
+    testLedgerData (std::size_t count, bool streamed)
+    {
+        using namespace std::chrono;
+        testcase (std::to_string (count) + " entries, " +
+            (streamed ? "streamed" : "buffered"));
+        beast::Journal const journal {beast::Journal::getNullSink ()};
+        auto const jv = ledgerData (count);
+        auto const rss = maxRSS ();
+        std::size_t bytes = 0;
+        std::size_t largest = 0;
+        boost::optional<steady_clock::time_point> first;
+        Json::Output const output =
+            [&](boost::beast::string_view const& b)
+            {
+                if (! first)
+                    first = steady_clock::now ();
+                bytes += b.size ();
+                largest = std::max (largest, b.size ());
+            };
+        auto const start = steady_clock::now ();
+        if (streamed)
+        {
+            HTTPReply (200, jv, true, output, journal);
+        }
+        else
+        {
+            auto response = to_string (jv);
+            response += '\n';
+            HTTPReply (200, response, output, journal);
+        }
+        auto const elapsed = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+        BEAST_EXPECT(first);
+        log << (streamed ? "streamed: " : "buffered: ") << bytes <<
+            " bytes in " << elapsed.count () * 1000 << " ms, first byte " <<
+            duration_cast<duration<double>> (*first - start).count () * 1000 <<
+            " ms, largest write " << largest << " bytes, max RSS +" <<
+            (maxRSS () - rss) << " KB" << std::endl;
+    }
+public:
+    void
+    run () override
+    {
+        testLedgerData (100000, true);
+        testLedgerData (100000, false);
+    }
+};
+BEAST_DEFINE_TESTSUITE(HTTPReplyCheck,server,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(HTTPReplyTiming,server,ripple,10);
+}
+}
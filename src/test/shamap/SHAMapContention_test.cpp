@@ -0,0 +1,121 @@
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <vector>
+namespace ripple {
+namespace tests {
+class SHAMapContention_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+#ifndef NDEBUG
+    std::size_t const default_items = 20000;
+#else
+    std::size_t const default_items = 250000;
+#endif
+    std::size_t const passes = 4;
+    beast::xor_shift_engine eng_;
+    std::shared_ptr<SHAMapItem>
+    makeRandomAS ()
+    {
+        Serializer s;
+        for (int d = 0; d < 8; ++d)
+            s.add32 (rand_int<std::uint32_t>(eng_));
+        return std::make_shared<SHAMapItem>(
+            s.getSHA512Half(), s.peekData ());
+    }
+    std::size_t
+    walk (SHAMap const& map)
+    {
+        std::size_t count = 0;
+        for (auto const& item : map)
+        {
+            (void)item;
+            ++count;
+        }
+        return count;
+    }
+    std::chrono::milliseconds
+    walkFromThreads (SHAMap const& map, std::size_t threads,
+        std::size_t items)
+    {
+        std::atomic<bool> go {false};
+        std::atomic<std::size_t> bad {0};
+        std::vector<std::thread> pool;
+        pool.reserve (threads);
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            pool.emplace_back ([&]
+                {
+                    while (!go.load ())
+                        std::this_thread::yield ();
+                    for (std::size_t i = 0; i < passes; ++i)
+                    {
+                        if (walk (map) != items)
+                            ++bad;
+                    }
+                });
+        }
+        auto const start = clock_type::now ();
+        go = true;
+        for (auto& t : pool)
+            t.join ();
+        auto const elapsed = clock_type::now () - start;
+        BEAST_EXPECT(bad == 0);
+        return std::chrono::duration_cast<
+            std::chrono::milliseconds>(elapsed);
+    }
+    void
+    run () override
+    {
+        testcase ("concurrent walk");
+        test::SuiteJournal journal ("SHAMapContention_test", *this);
+        TestFamily f (journal);
+        std::size_t const items = default_items;
+        SHAMapHash hash;
+        {
+            SHAMap source (SHAMapType::STATE, f, SHAMap::version{1});
+            for (std::size_t i = 0; i < items; ++i)
+                source.addItem (std::move(*makeRandomAS ()), false, false);
+            source.flushDirty (hotACCOUNT_NODE, 1);
+            hash = source.getHash ();
+        }
+        std::size_t const maxThreads = std::max (
+            4u, std::thread::hardware_concurrency ());
+        log << items << " items, " << passes <<
+            " passes per thread" << std::endl;
+        double base = 0;
+        for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            f.reset ();
+            SHAMap map (SHAMapType::STATE, hash.as_uint256(), f,
+                SHAMap::version{1});
+            if (! BEAST_EXPECT(map.fetchRoot (hash, nullptr)))
+                return;
+            map.setImmutable ();
+            auto const cold = walkFromThreads (map, threads, items);
+            auto const warm = walkFromThreads (map, threads, items);
+            double const rate = 1000.0 * threads * passes * items /
+                std::max<std::chrono::milliseconds::rep>(warm.count (), 1);
+            if (threads == 1)
+                base = rate;
+            log << std::setw (3) << threads << " threads: " <<
+                "cold " << cold.count () << "ms, " <<
+                "warm " << warm.count () << "ms, " <<
+                std::fixed << std::setprecision (0) << rate << " items/s, " <<
+                std::setprecision (2) << (rate / base) << "x" << std::endl;
+        }
+    }
+};
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SHAMapContention,shamap,ripple,10);
+} 
+} 
@@ -0,0 +1,172 @@
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <vector>
+namespace ripple {
+namespace tests {
+class SHAMapFlush_test : public beast::unit_test::suite
+{
+public:
+    static
+    std::vector<std::shared_ptr<SHAMapItem const>>
+    makeItems (std::size_t count, std::uint64_t seed)
+    {
+        beast::xor_shift_engine eng (seed);
+        std::vector<std::shared_ptr<SHAMapItem const>> items;
+        items.reserve (count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Serializer s;
+            for (int d = 0; d < 8; ++d)
+                s.add32 (rand_int<std::uint32_t>(eng));
+            items.push_back (std::make_shared<SHAMapItem const>(
+                s.getSHA512Half(), s.peekData ()));
+        }
+        return items;
+    }
+    static
+    std::shared_ptr<SHAMapItem const>
+    modify (SHAMapItem const& item)
+    {
+        Serializer s;
+        s.addRaw (item.peekData ());
+        s.add32 (0x12345678);
+        return std::make_shared<SHAMapItem const>(item.key(), s.peekData ());
+    }
+    void
+    testFlush (SHAMap::version v, beast::Journal const& journal)
+    {
+        TestFamily serial (journal);
+        TestFamily parallel (journal);
+        parallel.setFlushThreads (4);
+        auto const items = makeItems (5000, 42);
+        SHAMap a (SHAMapType::STATE, serial, v);
+        SHAMap b (SHAMapType::STATE, parallel, v);
+        for (auto const& item : items)
+        {
+            a.addGiveItem (item, false, false);
+            b.addGiveItem (item, false, false);
+        }
+        BEAST_EXPECT(a.flushDirty (hotACCOUNT_NODE, 1) ==
+            b.flushDirty (hotACCOUNT_NODE, 1));
+        BEAST_EXPECT(a.getHash () == b.getHash ());
+        b.invariants ();
+        auto sa = a.snapShot (true);
+        auto sb = b.snapShot (true);
+        for (std::size_t i = 0; i < items.size(); i += 7)
+        {
+            sa->updateGiveItem (modify (*items[i]), false, false);
+            sb->updateGiveItem (modify (*items[i]), false, false);
+        }
+        for (std::size_t i = 3; i < items.size(); i += 11)
+        {
+            sa->delItem (items[i]->key());
+            sb->delItem (items[i]->key());
+        }
+        for (auto const& item : makeItems (500, 7))
+        {
+            sa->addGiveItem (item, false, false);
+            sb->addGiveItem (item, false, false);
+        }
+        BEAST_EXPECT(sa->flushDirty (hotACCOUNT_NODE, 2) ==
+            sb->flushDirty (hotACCOUNT_NODE, 2));
+        BEAST_EXPECT(sa->getHash () == sb->getHash ());
+        BEAST_EXPECT(sa->getHash () != a.getHash ());
+        sb->invariants ();
+        BEAST_EXPECT(sa->deepCompare (*sb));
+        auto ua = sa->snapShot (true);
+        auto ub = sb->snapShot (true);
+        for (auto const& item : makeItems (100, 9))
+        {
+            ua->addGiveItem (item, false, false);
+            ub->addGiveItem (item, false, false);
+        }
+        BEAST_EXPECT(ua->unshare () == ub->unshare ());
+        BEAST_EXPECT(ua->getHash () == ub->getHash ());
+    }
+    void
+    run () override
+    {
+        test::SuiteJournal journal ("SHAMapFlush_test", *this);
+        testcase ("parallel flush, version 1");
+        testFlush (SHAMap::version{1}, journal);
+        testcase ("parallel flush, version 2");
+        testFlush (SHAMap::version{2}, journal);
+    }
+};
+class SHAMapFlushTiming_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+#ifndef NDEBUG
+    std::size_t const default_items = 50000;
+    std::size_t const default_dirty = 10000;
+#else
+    std::size_t const default_items = 500000;
+    std::size_t const default_dirty = 50000;
+#endif
+    std::chrono::microseconds
+    timeFlush (SHAMap const& base,
+        std::vector<std::shared_ptr<SHAMapItem const>> const& dirty,
+            SHAMapHash& hash)
+    {
+        auto map = base.snapShot (true);
+        for (auto const& item : dirty)
+            map->addGiveItem (item, false, false);
+        auto const start = clock_type::now ();
+        map->flushDirty (hotACCOUNT_NODE, 2);
+        hash = map->getHash ();
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_type::now () - start);
+    }
+    void
+    run () override
+    {
+        testcase ("flush latency");
+        test::SuiteJournal journal ("SHAMapFlushTiming_test", *this);
+        TestFamily f (journal);
+        SHAMap base (SHAMapType::STATE, f, SHAMap::version{1});
+        for (auto const& item :
+                SHAMapFlush_test::makeItems (default_items, 1))
+            base.addGiveItem (item, false, false);
+        base.flushDirty (hotACCOUNT_NODE, 1);
+        base.setImmutable ();
+        auto const dirty = SHAMapFlush_test::makeItems (default_dirty, 2);
+        log << default_items << " items, " << default_dirty <<
+            " modified per ledger" << std::endl;
+        SHAMapHash expected;
+        std::chrono::microseconds serial {0};
+        std::size_t const maxThreads = std::min (16u,
+            std::max (2u, std::thread::hardware_concurrency ()));
+        for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            f.setFlushThreads (threads);
+            SHAMapHash hash;
+            auto const elapsed = timeFlush (base, dirty, hash);
+            if (threads == 1)
+            {
+                expected = hash;
+                serial = elapsed;
+            }
+            BEAST_EXPECT(hash == expected);
+            log << std::setw (3) << threads << " threads: " <<
+                elapsed.count () / 1000.0 << "ms, " <<
+                std::fixed << std::setprecision (2) <<
+                (double (serial.count ()) /
+                    std::max<std::chrono::microseconds::rep>(
+                        elapsed.count (), 1)) << "x" << std::endl;
+        }
+    }
+};
+BEAST_DEFINE_TESTSUITE(SHAMapFlush,shamap,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SHAMapFlushTiming,shamap,ripple,10);
+} 
+} 
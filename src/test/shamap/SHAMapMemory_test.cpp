@@ -0,0 +1,74 @@
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <array>
+#include <iomanip>
+namespace ripple {
+namespace tests {
+class SHAMapMemory_test : public beast::unit_test::suite
+{
+public:
+#ifndef NDEBUG
+    std::size_t const default_items = 100000;
+#else
+    std::size_t const default_items = 1000000;
+#endif
+    void
+    run () override
+    {
+        testcase ("inner node memory");
+        test::SuiteJournal journal ("SHAMapMemory_test", *this);
+        TestFamily f (journal);
+        beast::xor_shift_engine eng (1);
+        auto const before = SHAMapInnerNode::childArrayBytes ();
+        SHAMap map (SHAMapType::STATE, f, SHAMap::version{1});
+        for (std::size_t i = 0; i < default_items; ++i)
+        {
+            Serializer s;
+            for (int d = 0; d < 8; ++d)
+                s.add32 (rand_int<std::uint32_t>(eng));
+            map.addItem (SHAMapItem{s.getSHA512Half(), s.peekData ()},
+                false, false);
+        }
+        map.flushDirty (hotACCOUNT_NODE, 1);
+        auto const arrays = SHAMapInnerNode::childArrayBytes () - before;
+        std::array<std::size_t, 17> branches {};
+        std::size_t inner = 0;
+        map.visitNodes ([&](SHAMapAbstractNode& node)
+            {
+                if (node.isInner ())
+                {
+                    ++inner;
+                    ++branches[static_cast<SHAMapInnerNode&>(
+                        node).getBranchCount ()];
+                }
+                return true;
+            });
+        auto const slot = sizeof(SHAMapHash) +
+            sizeof(std::shared_ptr<SHAMapAbstractNode>);
+        auto const dense = inner * (sizeof(SHAMapInnerNode) + 16 * slot);
+        auto const sparse = inner * sizeof(SHAMapInnerNode) + arrays;
+        auto const scale = 1000000.0 / default_items;
+        log << default_items << " items, " << inner << " inner nodes" <<
+            std::endl;
+        for (int i = 1; i <= 16; ++i)
+        {
+            if (branches[i] != 0)
+                log << std::setw (4) << i << " branches: " <<
+                    branches[i] << std::endl;
+        }
+        log << std::fixed << std::setprecision (1) <<
+            "dense layout:  " << (dense * scale / (1024 * 1024)) <<
+                " MB per million entries" << std::endl <<
+            "sparse layout: " << (sparse * scale / (1024 * 1024)) <<
+                " MB per million entries" << std::endl;
+        BEAST_EXPECT(sparse < dense);
+    }
+};
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SHAMapMemory,shamap,ripple,10);
+} 
+} 
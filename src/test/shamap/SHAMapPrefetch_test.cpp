@@ -0,0 +1,93 @@
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <vector>
+namespace ripple {
+namespace tests {
+class SHAMapPrefetch_test : public beast::unit_test::suite
+{
+    struct Walk
+    {
+        std::size_t nodes = 0;
+        std::size_t differences = 0;
+        std::size_t missing = 0;
+        std::vector<uint256> keys;
+    };
+    static
+    Walk
+    walk (SHAMap const& map)
+    {
+        Walk result;
+        map.visitNodes ([&](SHAMapAbstractNode&)
+            {
+                ++result.nodes;
+                return true;
+            });
+        map.visitDifferences (nullptr, [&](SHAMapAbstractNode&)
+            {
+                ++result.differences;
+                return true;
+            });
+        std::vector<SHAMapMissingNode> missing;
+        map.walkMap (missing, 32);
+        result.missing = missing.size ();
+        for (auto const& item : map)
+            result.keys.push_back (item.key ());
+        return result;
+    }
+    void
+    testWindow (SHAMap::version v, std::uint64_t seed,
+        beast::Journal const& journal)
+    {
+        TestFamily source (journal);
+        beast::xor_shift_engine eng (seed);
+        SHAMap map (SHAMapType::STATE, source, v);
+        for (int i = 0; i < 3000; ++i)
+        {
+            Serializer s;
+            for (int d = 0; d < 8; ++d)
+                s.add32 (rand_int<std::uint32_t>(eng));
+            map.addItem (SHAMapItem{s.getSHA512Half(), s.peekData ()},
+                false, false);
+        }
+        map.flushDirty (hotACCOUNT_NODE, 1);
+        map.setImmutable ();
+        auto const hash = map.getHash ();
+        auto const expected = walk (map);
+        BEAST_EXPECT(expected.keys.size () == 3000);
+        BEAST_EXPECT(expected.missing == 0);
+        for (std::size_t window : {0, 1, 3, 16, 32, 1024})
+        {
+            TestFamily f (journal);
+            f.setPrefetchWindow (window);
+            SHAMap copy (SHAMapType::STATE, hash.as_uint256(), f, v);
+            if (! BEAST_EXPECT(copy.fetchRoot (hash, nullptr)))
+                return;
+            copy.setImmutable ();
+            auto const cold = walk (copy);
+            BEAST_EXPECT(cold.nodes == expected.nodes);
+            BEAST_EXPECT(cold.differences == expected.differences);
+            BEAST_EXPECT(cold.missing == 0);
+            BEAST_EXPECT(cold.keys == expected.keys);
+            copy.invariants ();
+            BEAST_EXPECT(copy.deepCompare (map));
+        }
+    }
+public:
+    void
+    run () override
+    {
+        test::SuiteJournal journal ("SHAMapPrefetch_test", *this);
+        testcase ("traversal prefetch, version 1");
+        testWindow (SHAMap::version{1}, 7, journal);
+        testcase ("traversal prefetch, version 2");
+        testWindow (SHAMap::version{2}, 11, journal);
+    }
+};
+BEAST_DEFINE_TESTSUITE(SHAMapPrefetch,shamap,ripple);
+} 
+} 
@@ -17,6 +17,8 @@ private:
     RootStoppable parent_;
     std::unique_ptr<NodeStore::Database> db_;
     bool shardBacked_;
+    std::unique_ptr<TaskPool> flushPool_;
+    std::size_t prefetchWindow_ = 32;
     beast::Journal j_;
 public:
     TestFamily (beast::Journal j)
@@ -24,6 +26,7 @@ public:
                       clock_, j)
         , fullbelow_ ("full_below", clock_)
         , parent_ ("TestRootStoppable")
+        , flushPool_ (std::make_unique<TaskPool> (0, "SHAMapFlush"))
         , j_ (j)
     {
         Section testSection;
@@ -79,6 +82,26 @@ public:
     {
         return shardBacked_;
     }
+    TaskPool&
+    flushPool() override
+    {
+        return *flushPool_;
+    }
+    void
+    setFlushThreads (std::size_t threads)
+    {
+        flushPool_ = std::make_unique<TaskPool> (threads - 1, "SHAMapFlush");
+    }
+    std::size_t
+    prefetchWindow() const override
+    {
+        return prefetchWindow_;
+    }
+    void
+    setPrefetchWindow (std::size_t window)
+    {
+        prefetchWindow_ = window;
+    }
     void
     missing_node (std::uint32_t refNum) override
     {
@@ -1,4 +1,5 @@
 
+#include <test/basics/Arena_test.cpp>
 #include <test/basics/base64_test.cpp>
 #include <test/basics/base_uint_test.cpp>
 #include <test/basics/Buffer_test.cpp>
@@ -11,7 +12,9 @@
 #include <test/basics/PerfLog_test.cpp>
 #include <test/basics/qalloc_test.cpp>
 #include <test/basics/RangeSet_test.cpp>
+#include <test/basics/SlabAllocator_test.cpp>
 #include <test/basics/Slice_test.cpp>
 #include <test/basics/StringUtilities_test.cpp>
 #include <test/basics/TaggedCache_test.cpp>
+#include <test/basics/TaskPool_test.cpp>
 #include <test/basics/tagged_integer_test.cpp>
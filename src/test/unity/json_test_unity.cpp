@@ -2,4 +2,5 @@
 #include <test/json/json_value_test.cpp>
 #include <test/json/Object_test.cpp>
 #include <test/json/Output_test.cpp>
+#include <test/json/ReaderTiming_test.cpp>
 #include <test/json/Writer_test.cpp>
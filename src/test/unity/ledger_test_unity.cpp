@@ -1,4 +1,5 @@
 
+#include <test/ledger/ApplyTiming_test.cpp>
 #include <test/ledger/BookDirs_test.cpp>
 #include <test/ledger/CashDiff_test.cpp>
 #include <test/ledger/Directory_test.cpp>
@@ -1,7 +1,9 @@
 
 #include <test/nodestore/Backend_test.cpp>
 #include <test/nodestore/Basics_test.cpp>
+#include <test/nodestore/codec_test.cpp>
 #include <test/nodestore/Database_test.cpp>
+#include <test/nodestore/HotCache_test.cpp>
 #include <test/nodestore/import_test.cpp>
 #include <test/nodestore/Timing_test.cpp>
 #include <test/nodestore/varint_test.cpp>
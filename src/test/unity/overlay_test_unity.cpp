@@ -1,4 +1,8 @@
 
 #include <test/overlay/cluster_test.cpp>
+#include <test/overlay/compression_test.cpp>
+#include <test/overlay/ledger_server_test.cpp>
+#include <test/overlay/send_queue_test.cpp>
 #include <test/overlay/short_read_test.cpp>
+#include <test/overlay/squelch_test.cpp>
 #include <test/overlay/TMHello_test.cpp>
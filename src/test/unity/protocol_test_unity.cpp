@@ -1,6 +1,7 @@
 
 #include <test/protocol/BuildInfo_test.cpp>
 #include <test/protocol/digest_test.cpp>
+#include <test/protocol/sha512HalfBatch_test.cpp>
 #include <test/protocol/InnerObjectFormats_test.cpp>
 #include <test/protocol/IOUAmount_test.cpp>
 #include <test/protocol/Issue_test.cpp>
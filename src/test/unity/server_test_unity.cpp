@@ -1,2 +1,3 @@
 
+#include <test/server/HTTPReply_test.cpp>
 #include <test/server/Server_test.cpp>
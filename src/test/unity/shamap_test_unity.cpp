@@ -1,4 +1,8 @@
 
 #include <test/shamap/FetchPack_test.cpp>
+#include <test/shamap/SHAMapContention_test.cpp>
+#include <test/shamap/SHAMapFlush_test.cpp>
+#include <test/shamap/SHAMapMemory_test.cpp>
+#include <test/shamap/SHAMapPrefetch_test.cpp>
 #include <test/shamap/SHAMapSync_test.cpp>
 #include <test/shamap/SHAMap_test.cpp>